@@ -0,0 +1,242 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_AdmissionControl.h"
+#include "Hash/CityHash.h"
+#include "Misc/Guid.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    bool parse_hextets(const FString &Part, TArray<uint16> &OutHextets)
+    {
+        if (Part.IsEmpty())
+        {
+            return true;
+        }
+
+        TArray<FString> Groups;
+        Part.ParseIntoArray(Groups, TEXT(":"), false);
+        for (int32 Index = 0; Index < Groups.Num(); ++Index)
+        {
+            const FString &Group = Groups[Index];
+
+            // Trailing dotted IPv4 ("::ffff:1.2.3.4") stands for the last two hextets
+            if (Index == Groups.Num() - 1 && Group.Contains(TEXT(".")))
+            {
+                TArray<FString> Octets;
+                Group.ParseIntoArray(Octets, TEXT("."), false);
+                if (Octets.Num() != 4)
+                {
+                    return false;
+                }
+                uint8 Bytes[4];
+                for (int32 Octet = 0; Octet < 4; ++Octet)
+                {
+                    const int32 Value = FCString::Atoi(*Octets[Octet]);
+                    if (Octets[Octet].IsEmpty() || Octets[Octet].Len() > 3 || !Octets[Octet].IsNumeric() || Value > 255)
+                    {
+                        return false;
+                    }
+                    Bytes[Octet] = (uint8)Value;
+                }
+                OutHextets.Add((uint16)(Bytes[0] << 8 | Bytes[1]));
+                OutHextets.Add((uint16)(Bytes[2] << 8 | Bytes[3]));
+                continue;
+            }
+
+            if (Group.IsEmpty() || Group.Len() > 4)
+            {
+                return false;
+            }
+            uint32 Value = 0;
+            for (const TCHAR Char : Group)
+            {
+                if (!FChar::IsHexDigit(Char))
+                {
+                    return false;
+                }
+                Value = Value << 4 | (uint32)FParse::HexDigit(Char);
+            }
+            OutHextets.Add((uint16)Value);
+        }
+        return true;
+    }
+
+    // False when Host is not an IPv6 address, it is then used as it is
+    bool normalize_ipv6(const FString &Host, FString &OutHost)
+    {
+        FString Address = Host;
+        int32 Zone = INDEX_NONE;
+        if (Address.FindChar(TEXT('%'), Zone))
+        {
+            Address.LeftInline(Zone); // "fe80::1%eth0"
+        }
+
+        TArray<uint16> Head;
+        TArray<uint16> Tail;
+        const int32 Gap = Address.Find(TEXT("::"), ESearchCase::CaseSensitive);
+        if (Gap == INDEX_NONE)
+        {
+            if (!parse_hextets(Address, Head) || Head.Num() != 8)
+            {
+                return false;
+            }
+        }
+        else if (!parse_hextets(Address.Left(Gap), Head) || !parse_hextets(Address.Mid(Gap + 2), Tail) || Head.Num() + Tail.Num() > 7)
+        {
+            return false;
+        }
+
+        uint16 Hextets[8] = {};
+        for (int32 Index = 0; Index < Head.Num(); ++Index)
+        {
+            Hextets[Index] = Head[Index];
+        }
+        for (int32 Index = 0; Index < Tail.Num(); ++Index)
+        {
+            Hextets[8 - Tail.Num() + Index] = Tail[Index];
+        }
+
+        // ::ffff:a.b.c.d is an IPv4 client on a dual stack socket
+        if (Hextets[0] == 0 && Hextets[1] == 0 && Hextets[2] == 0 && Hextets[3] == 0 && Hextets[4] == 0 && Hextets[5] == 0xffff)
+        {
+            OutHost = FString::Printf(TEXT("%d.%d.%d.%d"), Hextets[6] >> 8, Hextets[6] & 0xff, Hextets[7] >> 8, Hextets[7] & 0xff);
+            return true;
+        }
+
+        // Punal Manalan, NOTE: One host usually gets a whole /64, per address buckets would let it pick a new address per login
+        OutHost = FString::Printf(TEXT("%x:%x:%x:%x::/64"), Hextets[0], Hextets[1], Hextets[2], Hextets[3]);
+        return true;
+    }
+} // anonymous namespace
+
+FProxyAdmissionController::FProxyAdmissionController(float InRatePerSecond, float InBurst, int32 InMaxInFlight, int32 TableSize)
+    : RatePerSecond(FMath::Max(0.0f, InRatePerSecond)), Burst(FMath::Max(1.0f, InBurst)), MaxInFlight(FMath::Max(1, InMaxInFlight))
+{
+    // Punal Manalan, NOTE: Seeded per process so nobody can pick addresses that all land in one set
+    const FGuid Seed = FGuid::NewGuid();
+    HashSeed = ((uint64)Seed.A << 32 | Seed.B) ^ ((uint64)Seed.C << 32 | Seed.D);
+
+    // Without a per address limit there are no buckets to keep
+    if (IsPerAddressLimited())
+    {
+        const uint32 NumSets = FMath::RoundUpToPowerOfTwo(FMath::Max(1, TableSize / Ways));
+        SetMask = NumSets - 1;
+        Buckets.SetNum(NumSets * Ways);
+    }
+}
+
+FString FProxyAdmissionController::NormalizeAddress(const FString &Address)
+{
+    FString Host = Address.TrimStartAndEnd().ToLower();
+
+    // "[v6]:port" -> "v6"
+    if (Host.StartsWith(TEXT("[")))
+    {
+        int32 Close = INDEX_NONE;
+        if (!Host.FindChar(TEXT(']'), Close))
+        {
+            return Host;
+        }
+        Host = Host.Mid(1, Close - 1);
+    }
+
+    // "v4:port" -> "v4", a bare v6 address has several colons
+    int32 FirstColon = INDEX_NONE;
+    int32 LastColon = INDEX_NONE;
+    if (Host.FindChar(TEXT(':'), FirstColon) && Host.FindLastChar(TEXT(':'), LastColon) && FirstColon == LastColon)
+    {
+        Host.LeftInline(FirstColon);
+        return Host;
+    }
+
+    FString Prefix;
+    return FirstColon != INDEX_NONE && normalize_ipv6(Host, Prefix) ? Prefix : Host;
+}
+
+uint64 FProxyAdmissionController::HashAddress(const FString &Address) const
+{
+    const FString Host = NormalizeAddress(Address);
+    const uint64 Hash = CityHash64WithSeed((const char *)*Host, Host.Len() * sizeof(TCHAR), HashSeed);
+    return Hash | 1; // 0 marks an unused bucket
+}
+
+EProxyAdmission FProxyAdmissionController::TryAdmit(const FString &Address, double NowSeconds, float &OutRetryAfterSeconds)
+{
+    OutRetryAfterSeconds = 0.0f;
+
+    if (IsPerAddressLimited())
+    {
+        const uint64 Tag = HashAddress(Address);
+        FScopeLock ScopeLock(&Lock);
+        FBucket *Set = &Buckets[((uint32)(Tag >> 32) & SetMask) * Ways];
+
+        FBucket *Bucket = nullptr;
+        FBucket *Victim = &Set[0];
+        for (int32 Way = 0; Way < Ways; ++Way)
+        {
+            if (Set[Way].Tag == Tag)
+            {
+                Bucket = &Set[Way];
+                break;
+            }
+            if (Set[Way].LastSeen < Victim->LastSeen)
+            {
+                Victim = &Set[Way];
+            }
+        }
+
+        if (Bucket)
+        {
+            Bucket->Tokens = FMath::Min(Burst, Bucket->Tokens + (float)(NowSeconds - Bucket->LastSeen) * RatePerSecond);
+        }
+        else
+        {
+            // Punal Manalan, NOTE: Not Burst, or cycling addresses through one set would refill a bucket by evicting it
+            Bucket = Victim;
+            Bucket->Tag = Tag;
+            Bucket->Tokens = FMath::Min(Burst, NewBucketTokens);
+        }
+        Bucket->LastSeen = NowSeconds;
+
+        if (Bucket->Tokens < 1.0f)
+        {
+            OutRetryAfterSeconds = (1.0f - Bucket->Tokens) / RatePerSecond;
+            NumShedPerAddress.fetch_add(1, std::memory_order_relaxed);
+            return EProxyAdmission::ShedPerAddress;
+        }
+        Bucket->Tokens -= 1.0f;
+    }
+
+    // The address paid its token either way, shedding on the global limit should not be a free retry
+    if (InFlight.fetch_add(1) >= MaxInFlight)
+    {
+        InFlight.fetch_sub(1);
+        OutRetryAfterSeconds = 1.0f;
+        NumShedGlobal.fetch_add(1, std::memory_order_relaxed);
+        return EProxyAdmission::ShedGlobal;
+    }
+
+    NumAdmitted.fetch_add(1, std::memory_order_relaxed);
+    return EProxyAdmission::Admitted;
+}
+
+void FProxyAdmissionController::Release()
+{
+    InFlight.fetch_sub(1);
+}
+
+FProxyAdmissionStats FProxyAdmissionController::GetStats() const
+{
+    FProxyAdmissionStats Stats;
+    Stats.Admitted = NumAdmitted.load(std::memory_order_relaxed);
+    Stats.ShedPerAddress = NumShedPerAddress.load(std::memory_order_relaxed);
+    Stats.ShedGlobal = NumShedGlobal.load(std::memory_order_relaxed);
+    Stats.InFlight = InFlight.load();
+    return Stats;
+}
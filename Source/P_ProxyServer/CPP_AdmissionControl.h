@@ -0,0 +1,79 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+enum class EProxyAdmission : uint8
+{
+    Admitted,
+    ShedPerAddress, // The address ran out of tokens
+    ShedGlobal      // Too many validations already in flight
+};
+
+struct FProxyAdmissionStats
+{
+    uint64 Admitted = 0;
+    uint64 ShedPerAddress = 0;
+    uint64 ShedGlobal = 0;
+    int32 InFlight = 0;
+};
+
+/**
+ * Admission control in front of login validation.
+ *  - Per address token bucket (Rate tokens per second, up to Burst), off when Rate <= 0. Buckets live in a fixed, set-associative
+ *    table keyed by a seeded hash of the address: memory does not grow with the number of addresses, and a
+ *    full set hands its least recently seen slot to the newcomer. A new bucket holds NewBucketTokens, not Burst,
+ *    so neither a fresh address nor one that got its slot evicted gets a full burst for free.
+ *  - IPv6 addresses share a bucket per /64, the smallest block a single host is usually given.
+ *  - Global limit on validations in flight, every Admitted TryAdmit must be paired with a Release.
+ * Rejections come with a retry-after hint. Thread-safe.
+ */
+class P_PROXYSERVER_API FProxyAdmissionController
+{
+public:
+    static constexpr int32 Ways = 4;
+    static constexpr float NewBucketTokens = 1.0f; // Enough for the login that created the bucket
+
+    FProxyAdmissionController(float InRatePerSecond, float InBurst, int32 InMaxInFlight, int32 TableSize);
+
+    EProxyAdmission TryAdmit(const FString &Address, double NowSeconds, float &OutRetryAfterSeconds);
+    void Release();
+
+    FProxyAdmissionStats GetStats() const;
+
+    bool IsPerAddressLimited() const { return RatePerSecond > 0.0f; }
+
+    // Port stripped, lowercased: "1.2.3.4:7777" and "1.2.3.4" share a bucket. IPv6 is cut to its /64,
+    // "[2001:db8::1]:7777" -> "2001:db8:0:0::/64", and IPv4-mapped IPv6 becomes the IPv4 address.
+    static FString NormalizeAddress(const FString &Address);
+
+private:
+    struct FBucket
+    {
+        uint64 Tag = 0; // 0 = unused
+        float Tokens = 0.0f;
+        double LastSeen = 0.0;
+    };
+
+    uint64 HashAddress(const FString &Address) const;
+
+    float RatePerSecond;
+    float Burst;
+    int32 MaxInFlight;
+    uint64 HashSeed;
+
+    FCriticalSection Lock;
+    TArray<FBucket> Buckets; // NumSets * Ways
+    uint32 SetMask = 0;
+
+    std::atomic<int32> InFlight{0};
+    std::atomic<uint64> NumAdmitted{0};
+    std::atomic<uint64> NumShedPerAddress{0};
+    std::atomic<uint64> NumShedGlobal{0};
+};
@@ -0,0 +1,144 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_AsyncRsaDecryptor.h"
+#include "Async/Async.h"
+#include "Misc/Base64.h"
+#include "Misc/QueuedThreadPool.h"
+
+class FProxyAsyncRsaDecryptor::FDecryptWork : public IQueuedWork
+{
+public:
+    FDecryptWork(FProxyAsyncRsaDecryptor *InOwner, const FRsaKeyPtr &InKey, const FString &InEncrypted, FOnDecrypted InOnComplete, FOnDecryptedBytes InOnCompleteBytes, TSharedPtr<TPromise<FString>> InPromise)
+        : Owner(InOwner), Key(InKey), EncryptedBase64(InEncrypted), OnComplete(MoveTemp(InOnComplete)), OnCompleteBytes(MoveTemp(InOnCompleteBytes)), Promise(MoveTemp(InPromise))
+    {
+    }
+
+    virtual void DoThreadedWork() override
+    {
+        TArray<uint8> Encrypted;
+        TArray<uint8> Decrypted;
+        const bool bSuccess = !EncryptedBase64.IsEmpty() && FBase64::Decode(EncryptedBase64, Encrypted) &&
+                              Key->DecryptOaep(Encrypted.GetData(), Encrypted.Num(), Decrypted) && Decrypted.Num() > 0;
+        Finish(bSuccess, MoveTemp(Decrypted));
+    }
+
+    virtual void Abandon() override
+    {
+        // Pool is shutting down before this job ran
+        Finish(false, TArray<uint8>());
+    }
+
+private:
+    void Finish(bool bSuccess, TArray<uint8> &&Decrypted)
+    {
+        Owner->ReleaseSlot();
+
+        if (Promise.IsValid() || OnComplete)
+        {
+            // Same conversion as FRsaKey::DecryptString
+            const FString DecryptedString = bSuccess ? FString(FUTF8ToTCHAR((const ANSICHAR *)Decrypted.GetData(), Decrypted.Num())) : FString();
+            if (Promise.IsValid())
+            {
+                Promise->SetValue(DecryptedString);
+            }
+            if (OnComplete)
+            {
+                AsyncTask(ENamedThreads::GameThread, [Callback = MoveTemp(OnComplete), bSuccess, DecryptedString]()
+                          { Callback(bSuccess, DecryptedString); });
+            }
+        }
+        if (OnCompleteBytes)
+        {
+            AsyncTask(ENamedThreads::GameThread, [Callback = MoveTemp(OnCompleteBytes), bSuccess, Bytes = MoveTemp(Decrypted)]()
+                      { Callback(bSuccess, Bytes); });
+        }
+        delete this;
+    }
+
+    FProxyAsyncRsaDecryptor *Owner;
+    FRsaKeyPtr Key;
+    FString EncryptedBase64;
+    FOnDecrypted OnComplete;
+    FOnDecryptedBytes OnCompleteBytes;
+    TSharedPtr<TPromise<FString>> Promise;
+};
+
+FProxyAsyncRsaDecryptor::FProxyAsyncRsaDecryptor(int32 NumWorkers, int32 InMaxPendingJobs)
+    : MaxPendingJobs(FMath::Max(1, InMaxPendingJobs))
+{
+    Pool = FQueuedThreadPool::Allocate();
+    if (!Pool->Create(FMath::Max(1, NumWorkers), 64 * 1024, TPri_Normal, TEXT("ProxyRsaDecryptPool")))
+    {
+        UE_LOG(LogTemp, Error, TEXT("AsyncRsaDecryptor: Failed to create worker pool"));
+        delete Pool;
+        Pool = nullptr;
+    }
+}
+
+FProxyAsyncRsaDecryptor::~FProxyAsyncRsaDecryptor()
+{
+    if (Pool)
+    {
+        // Abandons queued jobs and waits for the running ones, all of which release their slot
+        Pool->Destroy();
+        delete Pool;
+        Pool = nullptr;
+    }
+}
+
+bool FProxyAsyncRsaDecryptor::TryReserveSlot()
+{
+    int32 Current = PendingJobs.load();
+    while (Current < MaxPendingJobs)
+    {
+        if (PendingJobs.compare_exchange_weak(Current, Current + 1))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FProxyAsyncRsaDecryptor::ReleaseSlot()
+{
+    PendingJobs.fetch_sub(1);
+}
+
+bool FProxyAsyncRsaDecryptor::Enqueue(const FRsaKeyPtr &PrivateKey, const FString &EncryptedBase64, FOnDecrypted OnComplete)
+{
+    if (!Pool || !PrivateKey.IsValid() || !PrivateKey->IsPrivate() || !TryReserveSlot())
+    {
+        return false;
+    }
+
+    Pool->AddQueuedWork(new FDecryptWork(this, PrivateKey, EncryptedBase64, MoveTemp(OnComplete), nullptr, nullptr));
+    return true;
+}
+
+bool FProxyAsyncRsaDecryptor::EnqueueBytes(const FRsaKeyPtr &PrivateKey, const FString &EncryptedBase64, FOnDecryptedBytes OnComplete)
+{
+    if (!Pool || !PrivateKey.IsValid() || !PrivateKey->IsPrivate() || !TryReserveSlot())
+    {
+        return false;
+    }
+
+    Pool->AddQueuedWork(new FDecryptWork(this, PrivateKey, EncryptedBase64, nullptr, MoveTemp(OnComplete), nullptr));
+    return true;
+}
+
+bool FProxyAsyncRsaDecryptor::EnqueueWithFuture(const FRsaKeyPtr &PrivateKey, const FString &EncryptedBase64, TFuture<FString> &OutFuture)
+{
+    if (!Pool || !PrivateKey.IsValid() || !PrivateKey->IsPrivate() || !TryReserveSlot())
+    {
+        return false;
+    }
+
+    TSharedPtr<TPromise<FString>> Promise = MakeShared<TPromise<FString>>();
+    OutFuture = Promise->GetFuture();
+    Pool->AddQueuedWork(new FDecryptWork(this, PrivateKey, EncryptedBase64, nullptr, nullptr, Promise));
+    return true;
+}
@@ -0,0 +1,54 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include <atomic>
+#include "CPP_RsaKey.h"
+
+class FQueuedThreadPool;
+
+/**
+ * Bounded worker pool for RSA private-key decryption (e.g. sessionJoinTokenEncryptedBASE64).
+ * Private-key operations take hundreds of microseconds, so they run here instead of on the game thread.
+ *
+ * Backpressure: at most MaxPendingJobs decryptions may be queued or running, Enqueue* returns false
+ * beyond that so callers can reject / retry instead of building an unbounded backlog.
+ * Completion callbacks are marshalled back to the game thread, futures are fulfilled on the worker.
+ */
+class P_PROXYSERVER_API FProxyAsyncRsaDecryptor
+{
+public:
+    // Result is (bSuccess, DecryptedContent), always invoked on the game thread
+    typedef TFunction<void(bool, const FString &)> FOnDecrypted;
+
+    // Result is (bSuccess, DecryptedBytes) for plaintexts that are not necessarily UTF-8 (e.g. binary join tokens)
+    typedef TFunction<void(bool, const TArray<uint8> &)> FOnDecryptedBytes;
+
+    FProxyAsyncRsaDecryptor(int32 NumWorkers, int32 InMaxPendingJobs);
+    ~FProxyAsyncRsaDecryptor();
+
+    bool Enqueue(const FRsaKeyPtr &PrivateKey, const FString &EncryptedBase64, FOnDecrypted OnComplete);
+    bool EnqueueBytes(const FRsaKeyPtr &PrivateKey, const FString &EncryptedBase64, FOnDecryptedBytes OnComplete);
+
+    // Future variant, resolves to the decrypted string (empty on failure) on the worker thread
+    bool EnqueueWithFuture(const FRsaKeyPtr &PrivateKey, const FString &EncryptedBase64, TFuture<FString> &OutFuture);
+
+    int32 GetPendingJobs() const { return PendingJobs.load(); }
+    int32 GetMaxPendingJobs() const { return MaxPendingJobs; }
+
+private:
+    class FDecryptWork;
+
+    bool TryReserveSlot();
+    void ReleaseSlot();
+
+    FQueuedThreadPool *Pool = nullptr;
+    int32 MaxPendingJobs = 0;
+    std::atomic<int32> PendingJobs{0};
+};
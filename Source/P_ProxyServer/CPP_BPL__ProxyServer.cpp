@@ -5,11 +5,12 @@
  */
 
 #include "CPP_BPL__ProxyServer.h"
+#include "CPP_Sha256.h"
+#include "CPP_RsaKey.h"
+#include "CPP_JoinTokenCodec.h"
 #include "JsonObjectConverter.h"
 #include "HAL/PlatformMisc.h"
 #include "Misc/ScopeLock.h"
-#include <stdint.h>
-#include <string.h>
 
 // OpenSSL Includes
 #define UI UI_STUB
@@ -50,6 +51,12 @@ bool UCPP_BPL__ProxyServer::SessionJoinToken_FromJson(const FString &JsonString,
         return false;
     }
 
+    // Fast path for plain tokens, anything unusual (unknown fields etc.) goes through the reflective converter
+    if (FJoinTokenJsonCodec::Parse(*JsonString, JsonString.Len(), OutToken))
+    {
+        return true;
+    }
+
     // Use JsonObjectConverter to deserialize into the struct
     return FJsonObjectConverter::JsonObjectStringToUStruct<FSessionJoinToken>(JsonString, &OutToken, 0, 0);
 }
@@ -61,145 +68,71 @@ bool UCPP_BPL__ProxyServer::SessionJoinToken_ToJson(const FSessionJoinToken &Tok
     return FJsonObjectConverter::UStructToJsonObjectString(FSessionJoinToken::StaticStruct(), &Token, OutJsonString, 0, 0);
 }
 
-// Minimal public-domain SHA256 implementation (adapted for plugin use)
-namespace
+FString UCPP_BPL__ProxyServer::SessionJoinToken_ToCanonicalJson(const FSessionJoinToken &Token)
 {
-    // rotate right
-    inline uint32_t rotr(uint32_t x, uint32_t n) { return (x >> n) | (x << (32 - n)); }
+    // Canonical form, this is what Join Token signatures are computed over
+    FString Json;
+    FJoinTokenJsonCodec::Write(Token, Json);
+    return Json;
+}
 
-    static const uint32_t K256[64] = {
-        0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
-        0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
-        0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
-        0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
-        0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
-        0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
-        0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
-        0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u};
+bool UCPP_BPL__ProxyServer::SessionJoinToken_ToBinary(const FSessionJoinToken &Token, TArray<uint8> &OutBytes)
+{
+    return FJoinTokenBinaryCodec::EncodeToken(Token, OutBytes);
+}
 
-    static void sha256_compute(const uint8_t *data, size_t len, uint8_t out[32])
-    {
-        uint64_t bitlen = (uint64_t)len * 8u;
-        size_t rem = len % 64u;
-        size_t padded_len = len + 1 + ((rem < 56) ? (56 - rem) : (120 - rem));
+bool UCPP_BPL__ProxyServer::SessionJoinTokenEncrypted_ToBinary(const FSessionJoinTokenEncrypted &Token, TArray<uint8> &OutBytes)
+{
+    return FJoinTokenBinaryCodec::EncodeEncrypted(Token, OutBytes);
+}
 
-        uint8_t *buf = (uint8_t *)FMemory::Malloc(padded_len);
-        if (!buf)
-        {
-            // out as zeros
-            FMemory::Memzero(out, 32);
-            return;
-        }
+bool UCPP_BPL__ProxyServer::SessionJoinToken_FromBytes(const TArray<uint8> &Bytes, FSessionJoinToken &OutToken)
+{
+    return FJoinTokenBinaryCodec::DecodeTokenAny(Bytes.GetData(), Bytes.Num(), OutToken);
+}
 
-        FMemory::Memcpy(buf, data, len);
-        buf[len] = 0x80;
-        if (padded_len > len + 1)
-        {
-            FMemory::Memzero(buf + len + 1, padded_len - (len + 1));
-        }
-        // write big-endian bit length at end
-        for (int i = 0; i < 8; ++i)
-        {
-            buf[padded_len - 8 + i] = (uint8_t)((bitlen >> ((7 - i) * 8)) & 0xFFu);
-        }
+bool UCPP_BPL__ProxyServer::SessionJoinTokenEncrypted_FromBytes(const TArray<uint8> &Bytes, FSessionJoinTokenEncrypted &OutToken)
+{
+    return FJoinTokenBinaryCodec::DecodeEncryptedAny(Bytes.GetData(), Bytes.Num(), OutToken);
+}
 
-        uint32_t h0 = 0x6a09e667u;
-        uint32_t h1 = 0xbb67ae85u;
-        uint32_t h2 = 0x3c6ef372u;
-        uint32_t h3 = 0xa54ff53au;
-        uint32_t h4 = 0x510e527fu;
-        uint32_t h5 = 0x9b05688cu;
-        uint32_t h6 = 0x1f83d9abu;
-        uint32_t h7 = 0x5be0cd19u;
-
-        size_t chunks = padded_len / 64u;
-        for (size_t c = 0; c < chunks; ++c)
-        {
-            const uint8_t *chunk = buf + (c * 64u);
-            uint32_t w[64];
-            for (int t = 0; t < 16; ++t)
-            {
-                w[t] = (uint32_t)chunk[t * 4] << 24 | (uint32_t)chunk[t * 4 + 1] << 16 | (uint32_t)chunk[t * 4 + 2] << 8 | (uint32_t)chunk[t * 4 + 3];
-            }
-            for (int t = 16; t < 64; ++t)
-            {
-                uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
-                uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
-                w[t] = w[t - 16] + s0 + w[t - 7] + s1;
-            }
-
-            uint32_t a = h0;
-            uint32_t b = h1;
-            uint32_t c2 = h2;
-            uint32_t d = h3;
-            uint32_t e = h4;
-            uint32_t f = h5;
-            uint32_t g = h6;
-            uint32_t h = h7;
-
-            for (int t = 0; t < 64; ++t)
-            {
-                uint32_t S1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
-                uint32_t ch = (e & f) ^ ((~e) & g);
-                uint32_t temp1 = h + S1 + ch + K256[t] + w[t];
-                uint32_t S0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
-                uint32_t maj = (a & b) ^ (a & c2) ^ (b & c2);
-                uint32_t temp2 = S0 + maj;
-
-                h = g;
-                g = f;
-                f = e;
-                e = d + temp1;
-                d = c2;
-                c2 = b;
-                b = a;
-                a = temp1 + temp2;
-            }
-
-            h0 += a;
-            h1 += b;
-            h2 += c2;
-            h3 += d;
-            h4 += e;
-            h5 += f;
-            h6 += g;
-            h7 += h;
-        }
+FString UCPP_BPL__ProxyServer::Sha256String(const FString &Input)
+{
+    FSha256Context Context;
+    Context.UpdateString(Input);
 
-        FMemory::Free(buf);
+    uint8 Hash[FSha256Context::DigestSize];
+    Context.Final(Hash);
+    return FSha256Context::DigestToHex(Hash);
+}
 
-        // store big-endian
-        uint32_t hs[8] = {h0, h1, h2, h3, h4, h5, h6, h7};
-        for (int i = 0; i < 8; ++i)
-        {
-            out[i * 4 + 0] = (uint8_t)((hs[i] >> 24) & 0xFFu);
-            out[i * 4 + 1] = (uint8_t)((hs[i] >> 16) & 0xFFu);
-            out[i * 4 + 2] = (uint8_t)((hs[i] >> 8) & 0xFFu);
-            out[i * 4 + 3] = (uint8_t)(hs[i] & 0xFFu);
-        }
-    }
-} // anonymous namespace
+void UCPP_BPL__ProxyServer::Sha256_Init(FSha256StreamContext &Context)
+{
+    Context.Context.Init();
+}
 
-FString UCPP_BPL__ProxyServer::Sha256String(const FString &Input)
+void UCPP_BPL__ProxyServer::Sha256_UpdateString(FSha256StreamContext &Context, const FString &Input)
 {
-    // Convert to UTF-8 bytes
-    FTCHARToUTF8 Converter(*Input);
-    const ANSICHAR *BytesAnsi = Converter.Get();
-    int32 Length = Converter.Length();
+    Context.Context.UpdateString(Input);
+}
 
-    const uint8_t *Data = reinterpret_cast<const uint8_t *>(reinterpret_cast<const void *>(BytesAnsi));
-    uint8_t Hash[32];
-    sha256_compute(Data, (size_t)Length, Hash);
+void UCPP_BPL__ProxyServer::Sha256_UpdateBytes(FSha256StreamContext &Context, const TArray<uint8> &Bytes)
+{
+    Context.Context.Update(Bytes.GetData(), Bytes.Num());
+}
 
-    // Convert to lowercase hex
-    FString Out;
-    Out.Reserve(64);
-    for (int i = 0; i < 32; ++i)
-    {
-        uint8_t b = Hash[i];
-        Out += FString::Printf(TEXT("%02x"), b);
-    }
-    return Out;
+FString UCPP_BPL__ProxyServer::Sha256_FinalHex(FSha256StreamContext &Context)
+{
+    uint8 Hash[FSha256Context::DigestSize];
+    Context.Context.Final(Hash);
+    // Leave the context ready for the next message
+    Context.Context.Init();
+    return FSha256Context::DigestToHex(Hash);
+}
+
+FString UCPP_BPL__ProxyServer::GetSha256BackendName()
+{
+    return FString(FSha256Context::GetBackendName());
 }
 
 FString UCPP_BPL__ProxyServer::RsaEncryptString(const FString &Content, const FString &PublicKeyPEM)
@@ -214,113 +147,94 @@ FString UCPP_BPL__ProxyServer::RsaEncryptString_Cpp(const FString &Content, cons
         return FString();
     }
 
-    // Convert PEM string to BIO
-    FTCHARToUTF8 KeyConverter(*PublicKeyPEM);
-    BIO *KeyBio = BIO_new_mem_buf((void *)KeyConverter.Get(), KeyConverter.Length());
-    if (!KeyBio)
-    {
-        return FString();
-    }
-
-    // Read Public Key
-    RSA *RsaKey = PEM_read_bio_RSA_PUBKEY(KeyBio, NULL, NULL, NULL);
-    if (!RsaKey)
-    {
-        // Try reading as RSAPublicKey (PKCS#1) if PUBKEY (SubjectPublicKeyInfo) fails
-        BIO_reset(KeyBio);
-        RsaKey = PEM_read_bio_RSAPublicKey(KeyBio, NULL, NULL, NULL);
-    }
-
-    BIO_free(KeyBio);
-
-    if (!RsaKey)
-    {
-        return FString();
-    }
-
-    // Calculate max data size
-    int32 RsaSize = RSA_size(RsaKey);
-    // OAEP padding overhead is 41 bytes (approx)
-    int32 MaxDataSize = RsaSize - 42;
+    // Parsed keys are cached, so repeated calls with the same PEM skip PEM_read_bio_*
+    FRsaKeyPtr Key = FRsaKey::FindOrLoadPublicKey(PublicKeyPEM);
+    return Key.IsValid() ? Key->EncryptString(Content) : FString();
+}
 
-    FTCHARToUTF8 DataConverter(*Content);
-    const uint8 *DataBytes = (const uint8 *)DataConverter.Get();
-    int32 DataLength = DataConverter.Length();
+FString UCPP_BPL__ProxyServer::RsaDecryptString(const FString &EncryptedBase64, const FString &PrivateKeyPEM)
+{
+    return RsaDecryptString_Cpp(EncryptedBase64, PrivateKeyPEM);
+}
 
-    if (DataLength > MaxDataSize)
+FString UCPP_BPL__ProxyServer::RsaDecryptString_Cpp(const FString &EncryptedBase64, const FString &PrivateKeyPEM)
+{
+    if (EncryptedBase64.IsEmpty() || PrivateKeyPEM.IsEmpty())
     {
-        RSA_free(RsaKey);
-        // Data too large for RSA key
         return FString();
     }
 
-    TArray<uint8> EncryptedData;
-    EncryptedData.SetNumUninitialized(RsaSize);
+    FRsaKeyPtr Key = FRsaKey::FindOrLoadPrivateKey(PrivateKeyPEM);
+    return Key.IsValid() ? Key->DecryptString(EncryptedBase64) : FString();
+}
 
-    int32 EncryptedLength = RSA_public_encrypt(DataLength, DataBytes, EncryptedData.GetData(), RsaKey, RSA_PKCS1_OAEP_PADDING);
+bool UCPP_BPL__ProxyServer::LoadRsaPublicKey(const FString &PublicKeyPEM, FRsaKeyHandle &OutHandle)
+{
+    OutHandle.Key = FRsaKey::FindOrLoadPublicKey(PublicKeyPEM);
+    return OutHandle.Key.IsValid();
+}
 
-    RSA_free(RsaKey);
+bool UCPP_BPL__ProxyServer::LoadRsaPrivateKey(const FString &PrivateKeyPEM, FRsaKeyHandle &OutHandle)
+{
+    OutHandle.Key = FRsaKey::FindOrLoadPrivateKey(PrivateKeyPEM);
+    return OutHandle.Key.IsValid();
+}
 
-    if (EncryptedLength == -1)
-    {
-        return FString();
-    }
+bool UCPP_BPL__ProxyServer::IsRsaKeyHandleValid(const FRsaKeyHandle &Handle)
+{
+    return Handle.Key.IsValid();
+}
 
-    // Encode to Base64
-    return FBase64::Encode(EncryptedData.GetData(), EncryptedLength);
+FString UCPP_BPL__ProxyServer::RsaEncryptStringWithHandle(const FString &Content, const FRsaKeyHandle &PublicKey)
+{
+    return PublicKey.Key.IsValid() ? PublicKey.Key->EncryptString(Content) : FString();
 }
 
-FString UCPP_BPL__ProxyServer::RsaDecryptString(const FString &EncryptedBase64, const FString &PrivateKeyPEM)
+FString UCPP_BPL__ProxyServer::RsaDecryptStringWithHandle(const FString &EncryptedBase64, const FRsaKeyHandle &PrivateKey)
 {
-    return RsaDecryptString_Cpp(EncryptedBase64, PrivateKeyPEM);
+    return PrivateKey.Key.IsValid() ? PrivateKey.Key->DecryptString(EncryptedBase64) : FString();
 }
 
-FString UCPP_BPL__ProxyServer::RsaDecryptString_Cpp(const FString &EncryptedBase64, const FString &PrivateKeyPEM)
+FString UCPP_BPL__ProxyServer::HybridEncryptString(const FString &Content, const FString &PublicKeyPEM)
 {
-    if (EncryptedBase64.IsEmpty() || PrivateKeyPEM.IsEmpty())
-    {
-        return FString();
-    }
+    return HybridEncryptString_Cpp(Content, PublicKeyPEM);
+}
 
-    TArray<uint8> EncryptedData;
-    if (!FBase64::Decode(EncryptedBase64, EncryptedData))
+FString UCPP_BPL__ProxyServer::HybridEncryptString_Cpp(const FString &Content, const FString &PublicKeyPEM)
+{
+    if (Content.IsEmpty() || PublicKeyPEM.IsEmpty())
     {
         return FString();
     }
 
-    // Convert PEM string to BIO
-    FTCHARToUTF8 KeyConverter(*PrivateKeyPEM);
-    BIO *KeyBio = BIO_new_mem_buf((void *)KeyConverter.Get(), KeyConverter.Length());
-    if (!KeyBio)
-    {
-        return FString();
-    }
+    FRsaKeyPtr Key = FRsaKey::FindOrLoadPublicKey(PublicKeyPEM);
+    return Key.IsValid() ? Key->SealString(Content) : FString();
+}
 
-    // Read Private Key
-    RSA *RsaKey = PEM_read_bio_RSAPrivateKey(KeyBio, NULL, NULL, NULL);
-    BIO_free(KeyBio);
+FString UCPP_BPL__ProxyServer::HybridDecryptString(const FString &EnvelopeBase64, const FString &PrivateKeyPEM)
+{
+    return HybridDecryptString_Cpp(EnvelopeBase64, PrivateKeyPEM);
+}
 
-    if (!RsaKey)
+FString UCPP_BPL__ProxyServer::HybridDecryptString_Cpp(const FString &EnvelopeBase64, const FString &PrivateKeyPEM)
+{
+    if (EnvelopeBase64.IsEmpty() || PrivateKeyPEM.IsEmpty())
     {
         return FString();
     }
 
-    int32 RsaSize = RSA_size(RsaKey);
-    TArray<uint8> DecryptedData;
-    DecryptedData.SetNumUninitialized(RsaSize);
-
-    int32 DecryptedLength = RSA_private_decrypt(EncryptedData.Num(), EncryptedData.GetData(), DecryptedData.GetData(), RsaKey, RSA_PKCS1_OAEP_PADDING);
-
-    RSA_free(RsaKey);
+    FRsaKeyPtr Key = FRsaKey::FindOrLoadPrivateKey(PrivateKeyPEM);
+    return Key.IsValid() ? Key->OpenString(EnvelopeBase64) : FString();
+}
 
-    if (DecryptedLength == -1)
-    {
-        return FString();
-    }
+FString UCPP_BPL__ProxyServer::HybridEncryptStringWithHandle(const FString &Content, const FRsaKeyHandle &PublicKey)
+{
+    return PublicKey.Key.IsValid() ? PublicKey.Key->SealString(Content) : FString();
+}
 
-    // Convert result to FString (UTF8)
-    DecryptedData.Add(0); // Null terminate
-    return FString(UTF8_TO_TCHAR((const ANSICHAR *)DecryptedData.GetData()));
+FString UCPP_BPL__ProxyServer::HybridDecryptStringWithHandle(const FString &EnvelopeBase64, const FRsaKeyHandle &PrivateKey)
+{
+    return PrivateKey.Key.IsValid() ? PrivateKey.Key->OpenString(EnvelopeBase64) : FString();
 }
 
 void UCPP_BPL__ProxyServer::GenerateRsaKeyPair(int32 KeySizeInBits, FString &OutPublicKeyPEM, FString &OutPrivateKeyPEM)
@@ -391,75 +305,127 @@ void UCPP_BPL__ProxyServer::GenerateRsaKeyPair_Cpp(int32 KeySizeInBits, FString
 
 FString UCPP_BPL__ProxyServer::HmacSha256String(const FString &Data, const FString &Key)
 {
-    // Convert inputs to UTF-8
-    FTCHARToUTF8 DataConverter(*Data);
-    const uint8 *DataBytes = (const uint8 *)DataConverter.Get();
-    int32 DataLen = DataConverter.Length();
-
-    FTCHARToUTF8 KeyConverter(*Key);
-    const uint8 *KeyBytes = (const uint8 *)KeyConverter.Get();
-    int32 KeyLen = KeyConverter.Length();
+    return FHmacSha256Key(Key).SignStringToHex(Data);
+}
 
-    // SHA256 Block Size = 64 bytes
-    const int32 BlockSize = 64;
-    uint8 KeyPad[BlockSize];
-    FMemory::Memzero(KeyPad, BlockSize);
+FHmacSha256PreparedKey UCPP_BPL__ProxyServer::PrepareHmacSha256Key(const FString &Key)
+{
+    FHmacSha256PreparedKey Prepared;
+    Prepared.Key.SetKey(Key);
+    return Prepared;
+}
 
-    if (KeyLen > BlockSize)
+FString UCPP_BPL__ProxyServer::HmacSha256StringWithPreparedKey(const FString &Data, const FHmacSha256PreparedKey &PreparedKey)
+{
+    if (!PreparedKey.Key.bIsSet)
     {
-        // If key is longer than block size, hash it
-        uint8 KeyHash[32];
-        sha256_compute(KeyBytes, KeyLen, KeyHash);
-        FMemory::Memcpy(KeyPad, KeyHash, 32);
+        return FString();
     }
-    else
+    return PreparedKey.Key.SignStringToHex(Data);
+}
+
+bool UCPP_BPL__ProxyServer::VerifyHmacSha256WithPreparedKey(const FString &Data, const FHmacSha256PreparedKey &PreparedKey, const FString &ExpectedSignature)
+{
+    return PreparedKey.Key.VerifyString(Data, ExpectedSignature);
+}
+
+TArray<bool> UCPP_BPL__ProxyServer::HmacSha256VerifyBatch(const TArray<FHmacSha256VerifyRequest> &Requests)
+{
+    TBitArray<> Valid;
+    HmacSha256VerifyBatch_Cpp(Requests, Valid);
+
+    TArray<bool> Out;
+    Out.SetNumUninitialized(Valid.Num());
+    for (int32 i = 0; i < Valid.Num(); ++i)
     {
-        FMemory::Memcpy(KeyPad, KeyBytes, KeyLen);
+        Out[i] = Valid[i];
     }
+    return Out;
+}
 
-    // Prepare ipad and opad
-    uint8 IPad[BlockSize];
-    uint8 OPad[BlockSize];
-
-    for (int32 i = 0; i < BlockSize; ++i)
+void UCPP_BPL__ProxyServer::HmacSha256VerifyBatch_Cpp(const TArray<FHmacSha256VerifyRequest> &Requests, TBitArray<> &OutValid)
+{
+    const int32 Num = Requests.Num();
+    OutValid.Init(false, Num);
+    if (Num == 0)
     {
-        IPad[i] = KeyPad[i] ^ 0x36;
-        OPad[i] = KeyPad[i] ^ 0x5c;
+        return;
     }
 
-    // Inner Hash: SHA256(IPad || Data)
-    // We need to concatenate IPad and Data
-    int32 InnerDataLen = BlockSize + DataLen;
-    uint8 *InnerData = (uint8 *)FMemory::Malloc(InnerDataLen);
-    if (!InnerData)
-        return FString();
+    // All payloads as UTF-8 in one buffer, the hash lanes read them in place
+    TArray<int64> Offsets;
+    Offsets.SetNumUninitialized(Num + 1);
+    int64 TotalLength = 0;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Offsets[i] = TotalLength;
+        TotalLength += FPlatformString::ConvertedLength<UTF8CHAR>(*Requests[i].Data, Requests[i].Data.Len());
+    }
+    Offsets[Num] = TotalLength;
 
-    FMemory::Memcpy(InnerData, IPad, BlockSize);
-    FMemory::Memcpy(InnerData + BlockSize, DataBytes, DataLen);
+    // Punal Manalan, NOTE: TArray is int32 indexed, a batch this large is verified one message at a time instead
+    if (TotalLength > MAX_int32)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("HmacSha256VerifyBatch: %lld bytes of payload do not fit one buffer, verifying one by one"), TotalLength);
+        for (int32 i = 0; i < Num; ++i)
+        {
+            OutValid[i] = FHmacSha256Key(Requests[i].Key).VerifyString(Requests[i].Data, Requests[i].ExpectedSignature);
+        }
+        return;
+    }
 
-    uint8 InnerHash[32];
-    sha256_compute(InnerData, InnerDataLen, InnerHash);
-    FMemory::Free(InnerData);
+    TArray<uint8> Utf8Data;
+    Utf8Data.SetNumUninitialized((int32)TotalLength);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        FPlatformString::Convert(reinterpret_cast<UTF8CHAR *>(Utf8Data.GetData() + Offsets[i]), (int32)(Offsets[i + 1] - Offsets[i]), *Requests[i].Data, Requests[i].Data.Len());
+    }
 
-    // Outer Hash: SHA256(OPad || InnerHash)
-    int32 OuterDataLen = BlockSize + 32;
-    uint8 *OuterData = (uint8 *)FMemory::Malloc(OuterDataLen);
-    if (!OuterData)
-        return FString();
+    // Key schedules, consecutive requests signed with the same key share one
+    TArray<FHmacSha256Key> KeyStates;
+    KeyStates.Reserve(Num);
+    TArray<int32> KeyIndex;
+    KeyIndex.SetNumUninitialized(Num);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (i == 0 || !Requests[i].Key.Equals(Requests[i - 1].Key, ESearchCase::CaseSensitive))
+        {
+            KeyStates.Emplace(Requests[i].Key);
+        }
+        KeyIndex[i] = KeyStates.Num() - 1;
+    }
 
-    FMemory::Memcpy(OuterData, OPad, BlockSize);
-    FMemory::Memcpy(OuterData + BlockSize, InnerHash, 32);
+    // Inner Hash: SHA256(IPad || Data), resumed from the ipad midstate
+    TArray<FSha256MultiBufferJob> Jobs;
+    Jobs.SetNum(Num);
+    TArray<uint8> InnerDigests;
+    InnerDigests.SetNumUninitialized(Num * FSha256Context::DigestSize);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Jobs[i].Data = Utf8Data.GetData() + Offsets[i];
+        Jobs[i].Length = Offsets[i + 1] - Offsets[i];
+        Jobs[i].StartState = KeyStates[KeyIndex[i]].InnerState;
+        Jobs[i].StartLength = FSha256Context::BlockSize;
+    }
+    FSha256MultiBuffer::Hash(Jobs.GetData(), Num, InnerDigests.GetData());
 
-    uint8 OuterHash[32];
-    sha256_compute(OuterData, OuterDataLen, OuterHash);
-    FMemory::Free(OuterData);
+    // Outer Hash: SHA256(OPad || InnerHash), resumed from the opad midstate
+    TArray<uint8> OuterDigests;
+    OuterDigests.SetNumUninitialized(Num * FSha256Context::DigestSize);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Jobs[i].Data = InnerDigests.GetData() + i * FSha256Context::DigestSize;
+        Jobs[i].Length = FSha256Context::DigestSize;
+        Jobs[i].StartState = KeyStates[KeyIndex[i]].OuterState;
+    }
+    FSha256MultiBuffer::Hash(Jobs.GetData(), Num, OuterDigests.GetData());
 
-    // Convert to hex string
-    FString Out;
-    Out.Reserve(64);
-    for (int i = 0; i < 32; ++i)
+    for (int32 i = 0; i < Num; ++i)
     {
-        Out += FString::Printf(TEXT("%02x"), OuterHash[i]);
+        uint8 Expected[FSha256Context::DigestSize];
+        if (FSha256Context::HexToDigest(Requests[i].ExpectedSignature, Expected))
+        {
+            OutValid[i] = FSha256Context::DigestEquals(Expected, OuterDigests.GetData() + i * FSha256Context::DigestSize);
+        }
     }
-    return Out;
 }
\ No newline at end of file
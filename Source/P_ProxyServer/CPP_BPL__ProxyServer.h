@@ -37,10 +37,46 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Serialization")
 	static bool SessionJoinToken_ToJson(const FSessionJoinToken &Token, FString &OutJsonString, bool bPrettyPrint = false);
 
+	// Compact {"playerID":..,"timeStamp":..,"sessionSecret":..}, the exact text Join Token signatures are computed over
+	UFUNCTION(BlueprintPure, Category = "Punal|ProxyServer|Serialization")
+	static FString SessionJoinToken_ToCanonicalJson(const FSessionJoinToken &Token);
+
+	// Serialization: Compact binary wire format (see FJoinTokenBinaryCodec)
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Serialization")
+	static bool SessionJoinToken_ToBinary(const FSessionJoinToken &Token, TArray<uint8> &OutBytes);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Serialization")
+	static bool SessionJoinTokenEncrypted_ToBinary(const FSessionJoinTokenEncrypted &Token, TArray<uint8> &OutBytes);
+
+	// Accepts either the binary format or UTF-8 JSON, detected from the first byte
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Serialization")
+	static bool SessionJoinToken_FromBytes(const TArray<uint8> &Bytes, FSessionJoinToken &OutToken);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Serialization")
+	static bool SessionJoinTokenEncrypted_FromBytes(const TArray<uint8> &Bytes, FSessionJoinTokenEncrypted &OutToken);
+
 	// Crypto: SHA256 hash of an FString, returned as lowercase hex string
 	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
 	static FString Sha256String(const FString &Input);
 
+	// Crypto: Incremental SHA256 (Init -> Update... -> Final), for hashing data that arrives in pieces
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static void Sha256_Init(UPARAM(ref) FSha256StreamContext &Context);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static void Sha256_UpdateString(UPARAM(ref) FSha256StreamContext &Context, const FString &Input);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static void Sha256_UpdateBytes(UPARAM(ref) FSha256StreamContext &Context, const TArray<uint8> &Bytes);
+
+	// Returns lowercase hex digest and resets the Context for reuse
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString Sha256_FinalHex(UPARAM(ref) FSha256StreamContext &Context);
+
+	// Crypto: Which SHA256 backend was selected for this CPU ("SHA-NI", "ARMv8-SHA2" or "Scalar")
+	UFUNCTION(BlueprintPure, Category = "Punal|ProxyServer|Crypto")
+	static FString GetSha256BackendName();
+
 	// Crypto: RSA Encrypt string using Public Key (PEM format). Returns Base64 encoded encrypted data.
 	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
 	static FString RsaEncryptString(const FString &Content, const FString &PublicKeyPEM);
@@ -49,6 +85,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
 	static FString RsaDecryptString(const FString &EncryptedBase64, const FString &PrivateKeyPEM);
 
+	// Crypto: Parse a PEM key once into a reusable handle. Handles may be shared with worker threads.
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static bool LoadRsaPublicKey(const FString &PublicKeyPEM, FRsaKeyHandle &OutHandle);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static bool LoadRsaPrivateKey(const FString &PrivateKeyPEM, FRsaKeyHandle &OutHandle);
+
+	UFUNCTION(BlueprintPure, Category = "Punal|ProxyServer|Crypto")
+	static bool IsRsaKeyHandleValid(const FRsaKeyHandle &Handle);
+
+	// Crypto: Same as RsaEncryptString / RsaDecryptString, but using an already parsed key
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString RsaEncryptStringWithHandle(const FString &Content, const FRsaKeyHandle &PublicKey);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString RsaDecryptStringWithHandle(const FString &EncryptedBase64, const FRsaKeyHandle &PrivateKey);
+
+	// Crypto: Hybrid RSA-OAEP + AES-256-GCM envelope, no size limit on Content (see FRsaKey::SealEnvelope)
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString HybridEncryptString(const FString &Content, const FString &PublicKeyPEM);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString HybridDecryptString(const FString &EnvelopeBase64, const FString &PrivateKeyPEM);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString HybridEncryptStringWithHandle(const FString &Content, const FRsaKeyHandle &PublicKey);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString HybridDecryptStringWithHandle(const FString &EnvelopeBase64, const FRsaKeyHandle &PrivateKey);
+
 	// Crypto: Generate a new RSA Public/Private Key pair (PEM format).
 	// KeySizeInBits: typically 2048 or 4096.
 	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
@@ -58,9 +124,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
 	static FString HmacSha256String(const FString &Data, const FString &Key);
 
+	// Crypto: Precompute the HMAC-SHA256 key schedule once, then sign / verify many messages with it
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FHmacSha256PreparedKey PrepareHmacSha256Key(const FString &Key);
+
+	// Crypto: Same result as HmacSha256String(Data, Key) without redoing the ipad/opad work. Returns lowercase hex string.
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static FString HmacSha256StringWithPreparedKey(const FString &Data, const FHmacSha256PreparedKey &PreparedKey);
+
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static bool VerifyHmacSha256WithPreparedKey(const FString &Data, const FHmacSha256PreparedKey &PreparedKey, const FString &ExpectedSignature);
+
+	// Crypto: Verify many HMAC-SHA256 signatures at once (e.g. every join token of a filling match).
+	// Messages are hashed side by side in SIMD lanes where the CPU allows it. Result[i] is true if Requests[i] matched.
+	UFUNCTION(BlueprintCallable, Category = "Punal|ProxyServer|Crypto")
+	static TArray<bool> HmacSha256VerifyBatch(const TArray<FHmacSha256VerifyRequest> &Requests);
+
 	// --- C++ Variants (Non-UFunction) ---
 
 	static FString RsaEncryptString_Cpp(const FString &Content, const FString &PublicKeyPEM);
 	static FString RsaDecryptString_Cpp(const FString &EncryptedBase64, const FString &PrivateKeyPEM);
+	static FString HybridEncryptString_Cpp(const FString &Content, const FString &PublicKeyPEM);
+	static FString HybridDecryptString_Cpp(const FString &EnvelopeBase64, const FString &PrivateKeyPEM);
 	static void GenerateRsaKeyPair_Cpp(int32 KeySizeInBits, FString &OutPublicKeyPEM, FString &OutPrivateKeyPEM);
+	static void HmacSha256VerifyBatch_Cpp(const TArray<FHmacSha256VerifyRequest> &Requests, TBitArray<> &OutValid);
 };
@@ -0,0 +1,438 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_BackendBatcher.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+    // JSON string escaping (FString::ReplaceCharWithEscapedChar also escapes ' which JSON does not allow)
+    void append_json_string(FString &Out, const FString &Value)
+    {
+        Out.AppendChar(TEXT('"'));
+        for (const TCHAR Char : Value)
+        {
+            switch (Char)
+            {
+            case TEXT('"'):
+                Out.Append(TEXT("\\\""));
+                break;
+            case TEXT('\\'):
+                Out.Append(TEXT("\\\\"));
+                break;
+            case TEXT('\n'):
+                Out.Append(TEXT("\\n"));
+                break;
+            case TEXT('\r'):
+                Out.Append(TEXT("\\r"));
+                break;
+            case TEXT('\t'):
+                Out.Append(TEXT("\\t"));
+                break;
+            default:
+                if (Char < 0x20)
+                {
+                    Out.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+                }
+                else
+                {
+                    Out.AppendChar(Char);
+                }
+                break;
+            }
+        }
+        Out.AppendChar(TEXT('"'));
+    }
+
+    // Strict RFC 8259 syntax check without building a DOM, nesting is capped so hostile input cannot exhaust the stack
+    class FJsonSyntaxChecker
+    {
+    public:
+        FJsonSyntaxChecker(const TCHAR *InCursor, const TCHAR *InEnd) : Cursor(InCursor), End(InEnd) {}
+
+        bool IsValidDocument()
+        {
+            SkipWhitespace();
+            if (!Value(0))
+            {
+                return false;
+            }
+            SkipWhitespace();
+            return Cursor == End;
+        }
+
+    private:
+        static constexpr int32 MaxDepth = 64;
+
+        void SkipWhitespace()
+        {
+            while (Cursor < End && (*Cursor == TEXT(' ') || *Cursor == TEXT('\t') || *Cursor == TEXT('\n') || *Cursor == TEXT('\r')))
+            {
+                ++Cursor;
+            }
+        }
+
+        bool Consume(TCHAR Char)
+        {
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == Char)
+            {
+                ++Cursor;
+                return true;
+            }
+            return false;
+        }
+
+        bool Value(int32 Depth)
+        {
+            SkipWhitespace();
+            if (Cursor >= End || Depth > MaxDepth)
+            {
+                return false;
+            }
+            switch (*Cursor)
+            {
+            case TEXT('{'):
+                return Container(TEXT('}'), true, Depth + 1);
+            case TEXT('['):
+                return Container(TEXT(']'), false, Depth + 1);
+            case TEXT('"'):
+                return String();
+            case TEXT('t'):
+                return Literal(TEXT("true"));
+            case TEXT('f'):
+                return Literal(TEXT("false"));
+            case TEXT('n'):
+                return Literal(TEXT("null"));
+            default:
+                return Number();
+            }
+        }
+
+        // Object (bKeyed) or array
+        bool Container(TCHAR Close, bool bKeyed, int32 Depth)
+        {
+            ++Cursor;
+            if (Consume(Close))
+            {
+                return true;
+            }
+            do
+            {
+                if (bKeyed)
+                {
+                    SkipWhitespace();
+                    if (!String() || !Consume(TEXT(':')))
+                    {
+                        return false;
+                    }
+                }
+                if (!Value(Depth))
+                {
+                    return false;
+                }
+            } while (Consume(TEXT(',')));
+            return Consume(Close);
+        }
+
+        bool String()
+        {
+            if (Cursor >= End || *Cursor != TEXT('"'))
+            {
+                return false;
+            }
+            ++Cursor;
+            while (Cursor < End)
+            {
+                const TCHAR Char = *Cursor++;
+                if (Char == TEXT('"'))
+                {
+                    return true;
+                }
+                if (Char < 0x20)
+                {
+                    return false;
+                }
+                if (Char != TEXT('\\'))
+                {
+                    continue;
+                }
+                if (Cursor >= End)
+                {
+                    return false;
+                }
+                const TCHAR Escape = *Cursor++;
+                if (Escape == TEXT('u'))
+                {
+                    for (int32 Index = 0; Index < 4; ++Index)
+                    {
+                        if (Cursor >= End || !FChar::IsHexDigit(*Cursor++))
+                        {
+                            return false;
+                        }
+                    }
+                }
+                else if (!FCString::Strchr(TEXT("\"\\/bfnrt"), Escape))
+                {
+                    return false;
+                }
+            }
+            return false; // Unterminated
+        }
+
+        bool Literal(const TCHAR *Text)
+        {
+            const int32 Length = FCString::Strlen(Text);
+            if (End - Cursor < Length || FCString::Strncmp(Cursor, Text, Length) != 0)
+            {
+                return false;
+            }
+            Cursor += Length;
+            return true;
+        }
+
+        bool Digits()
+        {
+            const TCHAR *Start = Cursor;
+            while (Cursor < End && FChar::IsDigit(*Cursor))
+            {
+                ++Cursor;
+            }
+            return Cursor != Start;
+        }
+
+        // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+        bool Number()
+        {
+            if (Cursor < End && *Cursor == TEXT('-'))
+            {
+                ++Cursor;
+            }
+            if (Cursor < End && *Cursor == TEXT('0'))
+            {
+                ++Cursor;
+            }
+            else if (!Digits())
+            {
+                return false;
+            }
+            if (Cursor < End && *Cursor == TEXT('.'))
+            {
+                ++Cursor;
+                if (!Digits())
+                {
+                    return false;
+                }
+            }
+            if (Cursor < End && (*Cursor == TEXT('e') || *Cursor == TEXT('E')))
+            {
+                ++Cursor;
+                if (Cursor < End && (*Cursor == TEXT('+') || *Cursor == TEXT('-')))
+                {
+                    ++Cursor;
+                }
+                if (!Digits())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const TCHAR *Cursor;
+        const TCHAR *End;
+    };
+} // anonymous namespace
+
+FString FProxyBackendBatcher::DescribeFailure(bool bConnected, int32 Code, const FString &Body)
+{
+    if (!bConnected)
+    {
+        // Timeout, circuit open, deadline exceeded... arrive as the body of a failed attempt
+        if (!Body.IsEmpty())
+        {
+            return Body;
+        }
+        return Code != 0 ? FString::Printf(TEXT("Request failed with code: %d"), Code) : FString(TEXT("Connection failed"));
+    }
+    if (Code < 200 || Code >= 300)
+    {
+        return FString::Printf(TEXT("Request failed with code: %d"), Code);
+    }
+    return FString();
+}
+
+FProxyBackendBatcher::FProxyBackendBatcher(FProxyBackendTransportPtr InTransport, const FString &InUrl, float InWindowSeconds, int32 InMaxBatchSize)
+    : Transport(MoveTemp(InTransport)), Url(InUrl), WindowSeconds(FMath::Max(0.0f, InWindowSeconds)), MaxBatchSize(FMath::Max(1, InMaxBatchSize))
+{
+}
+
+FProxyBackendBatcher::~FProxyBackendBatcher()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(FlushTimer);
+    for (FPendingRequest &Request : Pending)
+    {
+        Request.OnResponse(FString(), TEXT("Backend batcher shut down"));
+    }
+}
+
+void FProxyBackendBatcher::Enqueue(const FString &Payload, FOnResponse OnResponse, bool bIdempotent)
+{
+    Pending.Add({Payload, MoveTemp(OnResponse), bIdempotent});
+
+    if (Pending.Num() >= MaxBatchSize || WindowSeconds <= 0.0f)
+    {
+        Flush();
+        return;
+    }
+
+    // The first request of a batch opens the window
+    if (!FlushTimer.IsValid())
+    {
+        TWeakPtr<FProxyBackendBatcher, ESPMode::ThreadSafe> WeakThis = AsShared();
+        FlushTimer = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+                                                                                        {
+                                                                                            if (TSharedPtr<FProxyBackendBatcher, ESPMode::ThreadSafe> This = WeakThis.Pin())
+                                                                                            {
+                                                                                                This->FlushTimer.Reset();
+                                                                                                This->Flush();
+                                                                                            }
+                                                                                            return false; }),
+                                                          WindowSeconds);
+    }
+}
+
+void FProxyBackendBatcher::Flush()
+{
+    if (FlushTimer.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(FlushTimer);
+        FlushTimer.Reset();
+    }
+    if (Pending.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FPendingRequest> Batch = MoveTemp(Pending);
+    Pending.Reset();
+
+    TArray<FString> Payloads;
+    Payloads.Reserve(Batch.Num());
+    bool bIdempotent = true;
+    for (const FPendingRequest &Request : Batch)
+    {
+        Payloads.Add(Request.Payload);
+        bIdempotent &= Request.bIdempotent;
+    }
+
+    // The batch travels with the callback, callers are answered even if the batcher is gone by then
+    TSharedRef<TArray<FPendingRequest>, ESPMode::ThreadSafe> InFlight = MakeShared<TArray<FPendingRequest>, ESPMode::ThreadSafe>(MoveTemp(Batch));
+    FOnBackendTransportComplete OnComplete = [InFlight](bool bConnected, int32 Code, const FString &Body)
+    { Deliver(*InFlight, bConnected, Code, Body); };
+    if (bIdempotent)
+    {
+        Transport->PostIdempotent(Url, BuildBatchBody(Payloads), 0.0f, MoveTemp(OnComplete));
+    }
+    else
+    {
+        Transport->Post(Url, BuildBatchBody(Payloads), 0.0f, MoveTemp(OnComplete));
+    }
+}
+
+void FProxyBackendBatcher::Deliver(TArray<FPendingRequest> &Batch, bool bConnected, int32 Code, const FString &Body)
+{
+    FString Error = DescribeFailure(bConnected, Code, Body);
+    TArray<FString> Responses;
+    if (Error.IsEmpty() && !SplitBatchResponse(Body, Batch.Num(), Responses))
+    {
+        Error = TEXT("Malformed batch response");
+    }
+
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        if (Error.IsEmpty())
+        {
+            Batch[Index].OnResponse(Responses[Index], FString());
+        }
+        else
+        {
+            // Same as an unbatched request: a non-2xx body (the backend's error details) comes along with the error
+            Batch[Index].OnResponse(bConnected ? Body : FString(), Error);
+        }
+    }
+}
+
+FString FProxyBackendBatcher::BuildBatchBody(const TArray<FString> &Payloads)
+{
+    int32 TotalLength = 2;
+    for (const FString &Payload : Payloads)
+    {
+        TotalLength += Payload.Len() + 3;
+    }
+
+    FString Body;
+    Body.Reserve(TotalLength);
+    Body.AppendChar(TEXT('['));
+    for (int32 Index = 0; Index < Payloads.Num(); ++Index)
+    {
+        if (Index > 0)
+        {
+            Body.AppendChar(TEXT(','));
+        }
+
+        // Punal Manalan, NOTE: An object / array is embedded as-is only if it really is JSON, one bad payload
+        // (e.g. a Blueprint string that merely starts with a brace) must not break the whole batch
+        const FString &Payload = Payloads[Index];
+        const FString Trimmed = Payload.TrimStartAndEnd();
+        if ((Trimmed.StartsWith(TEXT("{")) || Trimmed.StartsWith(TEXT("["))) && FJsonSyntaxChecker(*Trimmed, *Trimmed + Trimmed.Len()).IsValidDocument())
+        {
+            Body.Append(Trimmed);
+        }
+        else
+        {
+            append_json_string(Body, Payload);
+        }
+    }
+    Body.AppendChar(TEXT(']'));
+    return Body;
+}
+
+bool FProxyBackendBatcher::SplitBatchResponse(const FString &Body, int32 Count, TArray<FString> &OutResponses)
+{
+    OutResponses.Reset();
+
+    TArray<TSharedPtr<FJsonValue>> Elements;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Body);
+    if (!FJsonSerializer::Deserialize(Reader, Elements) || Elements.Num() != Count)
+    {
+        return false;
+    }
+
+    OutResponses.Reserve(Count);
+    for (const TSharedPtr<FJsonValue> &Element : Elements)
+    {
+        FString Response;
+        if (!Element.IsValid() || Element->IsNull())
+        {
+            // Leave empty
+        }
+        else if (Element->Type == EJson::String)
+        {
+            Response = Element->AsString();
+        }
+        else
+        {
+            TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Response);
+            FJsonSerializer::Serialize(Element, FString(), Writer);
+        }
+        OutResponses.Add(MoveTemp(Response));
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPP_BackendTransport.h"
+
+/**
+ * Coalesces backend requests: payloads queued within WindowSeconds (or until MaxBatchSize is reached)
+ * go out as one POST and the response is fanned back out to each caller.
+ *
+ * Wire format:
+ *   Request : JSON array, element i is payload i (embedded as-is when it is a valid JSON object / array, else as a string)
+ *   Response: JSON array of the same length, element i is the response for payload i
+ *             (string elements are handed out as their value, anything else re-serialized as JSON)
+ * A transport failure, non-2xx status or malformed / short response fails every request of the batch,
+ * with the same errors an unbatched request gets (see DescribeFailure).
+ * Game thread only.
+ */
+class P_PROXYSERVER_API FProxyBackendBatcher : public TSharedFromThis<FProxyBackendBatcher, ESPMode::ThreadSafe>
+{
+public:
+    // (Response, Error), Error is empty on success
+    typedef TFunction<void(const FString &, const FString &)> FOnResponse;
+
+    FProxyBackendBatcher(FProxyBackendTransportPtr InTransport, const FString &InUrl, float InWindowSeconds, int32 InMaxBatchSize);
+    ~FProxyBackendBatcher();
+
+    // A batch is sent as idempotent (may be retried / hedged) only when every request in it is
+    void Enqueue(const FString &Payload, FOnResponse OnResponse, bool bIdempotent = false);
+
+    // Sends whatever is queued right away
+    void Flush();
+
+    int32 GetNumQueued() const { return Pending.Num(); }
+
+    // Payloads -> batch body, and batch body -> per-payload responses (false if it does not match Count)
+    static FString BuildBatchBody(const TArray<FString> &Payloads);
+    static bool SplitBatchResponse(const FString &Body, int32 Count, TArray<FString> &OutResponses);
+
+    // Error for a finished POST, empty for a 2xx answer. Shared with unbatched requests so both report failures alike.
+    static FString DescribeFailure(bool bConnected, int32 Code, const FString &Body);
+
+private:
+    struct FPendingRequest
+    {
+        FString Payload;
+        FOnResponse OnResponse;
+        bool bIdempotent;
+    };
+
+    static void Deliver(TArray<FPendingRequest> &Batch, bool bConnected, int32 Code, const FString &Body);
+
+    FProxyBackendTransportPtr Transport;
+    FString Url;
+    float WindowSeconds;
+    int32 MaxBatchSize;
+
+    TArray<FPendingRequest> Pending;
+    FTSTicker::FDelegateHandle FlushTimer;
+};
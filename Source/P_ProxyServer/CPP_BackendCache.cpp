@@ -0,0 +1,228 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_BackendCache.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+
+FProxyBackendCache::FProxyBackendCache(int32 InMaxEntries)
+    : MaxEntries(FMath::Max(1, InMaxEntries))
+{
+    Entries.Reserve(MaxEntries);
+    Index.Reserve(MaxEntries);
+    PlayerSlots.Reserve(MaxEntries);
+}
+
+FProxyBackendCache::FEntryKey FProxyBackendCache::MakeEntryKey(const FString &PlayerId, const FString &RequestPayload)
+{
+    // StrCrc32 is case-sensitive like the payload comparison, GetTypeHash(FString) is not
+    FEntryKey Key;
+    Key.PlayerKey = NormalizeKey(PlayerId);
+    Key.PayloadHash = FCrc::StrCrc32(*RequestPayload);
+    return Key;
+}
+
+bool FProxyBackendCache::Find(const FString &PlayerId, const FString &RequestPayload, FString &OutResponse, bool &bOutNegative)
+{
+    const FEntryKey Key = MakeEntryKey(PlayerId, RequestPayload);
+
+    FScopeLock ScopeLock(&Lock);
+    const int32 *Slot = Index.Find(Key);
+    if (!Slot)
+    {
+        ++Stats.Misses;
+        return false;
+    }
+
+    FEntry &Entry = Entries[*Slot];
+    if (FPlatformTime::Seconds() >= Entry.ExpiresAt)
+    {
+        ++Stats.Expired;
+        ++Stats.Misses;
+        RemoveSlot(*Slot);
+        return false;
+    }
+    if (!Entry.RequestPayload.Equals(RequestPayload, ESearchCase::CaseSensitive))
+    {
+        // Another payload of this player with the same hash
+        ++Stats.Misses;
+        return false;
+    }
+
+    OutResponse = Entry.Response;
+    bOutNegative = Entry.bNegative;
+    ++(Entry.bNegative ? Stats.NegativeHits : Stats.Hits);
+
+    Unlink(*Slot);
+    LinkFront(*Slot);
+    return true;
+}
+
+uint64 FProxyBackendCache::GetGeneration(const FString &PlayerId) const
+{
+    const FString Key = NormalizeKey(PlayerId);
+
+    FScopeLock ScopeLock(&Lock);
+    return GetGenerationLocked(Key);
+}
+
+uint64 FProxyBackendCache::GetGenerationLocked(const FString &Key) const
+{
+    const uint64 *KeyGeneration = KeyGenerations.Find(Key);
+    return KeyGeneration ? FMath::Max(*KeyGeneration, AllGeneration) : AllGeneration;
+}
+
+void FProxyBackendCache::Put(const FString &PlayerId, const FString &RequestPayload, const FString &Response, bool bNegative, float TtlSeconds, uint64 Generation)
+{
+    if (TtlSeconds <= 0.0f)
+    {
+        return;
+    }
+
+    FEntryKey Key = MakeEntryKey(PlayerId, RequestPayload);
+    const double ExpiresAt = FPlatformTime::Seconds() + TtlSeconds;
+
+    FScopeLock ScopeLock(&Lock);
+    if (GetGenerationLocked(Key.PlayerKey) != Generation)
+    {
+        // The backend told us this player changed after the request went out, the answer may predate that
+        ++Stats.StalePuts;
+        return;
+    }
+
+    int32 Slot;
+    if (const int32 *Existing = Index.Find(Key))
+    {
+        // Same payload stored again, or a colliding one taking the slot over
+        Slot = *Existing;
+        Unlink(Slot);
+    }
+    else
+    {
+        if (Index.Num() >= MaxEntries && Tail != INDEX_NONE)
+        {
+            ++Stats.Evictions;
+            RemoveSlot(Tail);
+        }
+
+        if (FreeSlots.Num() > 0)
+        {
+            Slot = FreeSlots.Pop();
+        }
+        else
+        {
+            Slot = Entries.AddDefaulted();
+        }
+        PlayerSlots.Add(Key.PlayerKey, Slot);
+        Entries[Slot].Key = Key;
+        Index.Add(MoveTemp(Key), Slot);
+    }
+
+    FEntry &Entry = Entries[Slot];
+    Entry.RequestPayload = RequestPayload;
+    Entry.Response = Response;
+    Entry.bNegative = bNegative;
+    Entry.ExpiresAt = ExpiresAt;
+    LinkFront(Slot);
+}
+
+bool FProxyBackendCache::Invalidate(const FString &PlayerId)
+{
+    const FString Key = NormalizeKey(PlayerId);
+
+    FScopeLock ScopeLock(&Lock);
+    if (KeyGenerations.Num() >= MaxEntries)
+    {
+        // Folding everyone into AllGeneration only drops more in-flight answers, never keeps a stale one
+        AllGeneration = NextGeneration;
+        KeyGenerations.Reset();
+    }
+    KeyGenerations.Add(Key, ++NextGeneration);
+
+    TArray<int32, TInlineAllocator<8>> Slots;
+    PlayerSlots.MultiFind(Key, Slots);
+    Stats.Invalidations += Slots.Num();
+    for (const int32 Slot : Slots)
+    {
+        RemoveSlot(Slot);
+    }
+    return Slots.Num() > 0;
+}
+
+void FProxyBackendCache::InvalidateAll()
+{
+    FScopeLock ScopeLock(&Lock);
+    Stats.Invalidations += Index.Num();
+    AllGeneration = ++NextGeneration;
+    KeyGenerations.Reset();
+    Entries.Reset();
+    FreeSlots.Reset();
+    Index.Reset();
+    PlayerSlots.Reset();
+    Head = INDEX_NONE;
+    Tail = INDEX_NONE;
+}
+
+FProxyBackendCacheStats FProxyBackendCache::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    FProxyBackendCacheStats Result = Stats;
+    Result.Num = Index.Num();
+    return Result;
+}
+
+void FProxyBackendCache::Unlink(int32 Slot)
+{
+    FEntry &Entry = Entries[Slot];
+    if (Entry.Prev != INDEX_NONE)
+    {
+        Entries[Entry.Prev].Next = Entry.Next;
+    }
+    else
+    {
+        Head = Entry.Next;
+    }
+    if (Entry.Next != INDEX_NONE)
+    {
+        Entries[Entry.Next].Prev = Entry.Prev;
+    }
+    else
+    {
+        Tail = Entry.Prev;
+    }
+    Entry.Prev = INDEX_NONE;
+    Entry.Next = INDEX_NONE;
+}
+
+void FProxyBackendCache::LinkFront(int32 Slot)
+{
+    FEntry &Entry = Entries[Slot];
+    Entry.Prev = INDEX_NONE;
+    Entry.Next = Head;
+    if (Head != INDEX_NONE)
+    {
+        Entries[Head].Prev = Slot;
+    }
+    Head = Slot;
+    if (Tail == INDEX_NONE)
+    {
+        Tail = Slot;
+    }
+}
+
+void FProxyBackendCache::RemoveSlot(int32 Slot)
+{
+    Unlink(Slot);
+
+    FEntry &Entry = Entries[Slot];
+    Index.Remove(Entry.Key);
+    PlayerSlots.RemoveSingle(Entry.Key.PlayerKey, Slot);
+    Entry.Key = FEntryKey();
+    Entry.RequestPayload.Reset();
+    Entry.Response.Reset();
+    FreeSlots.Add(Slot);
+}
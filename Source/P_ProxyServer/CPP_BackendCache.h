@@ -0,0 +1,102 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FProxyBackendCacheStats
+{
+    uint64 Hits = 0;
+    uint64 NegativeHits = 0; // Hits on a cached "not found / banned" answer
+    uint64 Misses = 0;
+    uint64 Expired = 0;
+    uint64 Evictions = 0;
+    uint64 Invalidations = 0;
+    uint64 StalePuts = 0;    // Answers dropped because the player was invalidated while the request was in flight
+    int32 Num = 0;
+};
+
+/**
+ * Bounded cache of backend answers keyed by player id (case-insensitive) and request payload, so a reconnecting
+ * player does not cost another backend round trip.
+ *
+ *  - a player can have one entry per distinct request payload. Entries are indexed by (player, payload hash),
+ *    the stored payload is compared in full so a hash collision is a miss, never a wrong answer.
+ *  - every entry has its own expiry, negative answers ("not found / banned") usually a shorter one
+ *  - at MaxEntries the least recently used entry is evicted. Entries live in a slab linked into
+ *    an LRU list by index, evicted slots are reused.
+ *  - Invalidate drops every entry of a player, InvalidateAll everything. Both bump the player's generation,
+ *    so an answer requested before the invalidation and arriving after it is not stored.
+ * Thread-safe.
+ */
+class P_PROXYSERVER_API FProxyBackendCache
+{
+public:
+    explicit FProxyBackendCache(int32 InMaxEntries);
+
+    // True on a fresh hit. bOutNegative tells a cached negative answer apart.
+    bool Find(const FString &PlayerId, const FString &RequestPayload, FString &OutResponse, bool &bOutNegative);
+
+    // Take this before sending the request and hand it to Put with the answer
+    uint64 GetGeneration(const FString &PlayerId) const;
+
+    // Dropped when PlayerId was invalidated since Generation was taken
+    void Put(const FString &PlayerId, const FString &RequestPayload, const FString &Response, bool bNegative, float TtlSeconds, uint64 Generation);
+
+    // False when nothing was cached for PlayerId, in-flight answers for it are dropped either way
+    bool Invalidate(const FString &PlayerId);
+    void InvalidateAll();
+
+    FProxyBackendCacheStats GetStats() const;
+
+private:
+    struct FEntryKey
+    {
+        FString PlayerKey;
+        uint32 PayloadHash = 0;
+
+        bool operator==(const FEntryKey &Other) const { return PayloadHash == Other.PayloadHash && PlayerKey.Equals(Other.PlayerKey, ESearchCase::CaseSensitive); }
+        friend uint32 GetTypeHash(const FEntryKey &Key) { return HashCombine(GetTypeHash(Key.PlayerKey), Key.PayloadHash); }
+    };
+
+    struct FEntry
+    {
+        FEntryKey Key;
+        FString RequestPayload;
+        FString Response;
+        double ExpiresAt = 0.0;
+        bool bNegative = false;
+        int32 Prev = INDEX_NONE; // Towards most recently used
+        int32 Next = INDEX_NONE; // Towards least recently used
+    };
+
+    static FString NormalizeKey(const FString &PlayerId) { return PlayerId.ToLower(); }
+    static FEntryKey MakeEntryKey(const FString &PlayerId, const FString &RequestPayload);
+
+    uint64 GetGenerationLocked(const FString &Key) const;
+
+    void Unlink(int32 Slot);
+    void LinkFront(int32 Slot);
+    void RemoveSlot(int32 Slot);
+
+    mutable FCriticalSection Lock;
+    int32 MaxEntries;
+    TArray<FEntry> Entries;
+    TArray<int32> FreeSlots;
+    TMap<FEntryKey, int32> Index;
+    TMultiMap<FString, int32> PlayerSlots; // Every slot of a player, for Invalidate
+    int32 Head = INDEX_NONE; // Most recently used
+    int32 Tail = INDEX_NONE; // Least recently used
+
+    // Every invalidation takes the next value of NextGeneration. Players invalidated one by one keep theirs in
+    // KeyGenerations, InvalidateAll (and a full KeyGenerations) folds them into AllGeneration.
+    uint64 NextGeneration = 0;
+    uint64 AllGeneration = 0;
+    TMap<FString, uint64> KeyGenerations;
+
+    FProxyBackendCacheStats Stats;
+};
@@ -0,0 +1,289 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_BackendClient.h"
+#include "HAL/PlatformTime.h"
+#include "CPP_Metrics.h"
+
+namespace
+{
+    constexpr int32 LatencySamples = 64;
+    constexpr int32 MinSamplesForP95 = 8;
+    constexpr int32 P95RecomputeInterval = 8;
+
+    const FProxyHistogram BackendAttemptLatency(TEXT("proxy_backend_attempt_seconds"), TEXT(""), TEXT("Latency of single backend HTTP attempts"));
+    const FProxyHistogram BackendRequestLatency(TEXT("proxy_backend_request_seconds"), TEXT(""), TEXT("Backend request latency including retries and hedging"));
+    const FProxyCounter BackendAttemptsOk(TEXT("proxy_backend_attempts_total"), TEXT("result=\"ok\""), TEXT("Backend HTTP attempts"));
+    const FProxyCounter BackendAttemptsFailed(TEXT("proxy_backend_attempts_total"), TEXT("result=\"failed\""), TEXT("Backend HTTP attempts"));
+} // anonymous namespace
+
+FProxyBackendClient::FProxyBackendClient(FProxyBackendTransportPtr InTransport, const FProxyBackendClientSettings &InSettings)
+    : Transport(MoveTemp(InTransport)), Settings(InSettings)
+{
+    Settings.AttemptTimeoutSeconds = FMath::Max(0.01f, Settings.AttemptTimeoutSeconds);
+    Settings.MaxRetries = FMath::Max(0, Settings.MaxRetries);
+    Settings.CircuitFailureThreshold = FMath::Max(1, Settings.CircuitFailureThreshold);
+    if (Settings.DeadlineSeconds <= 0.0f)
+    {
+        Settings.DeadlineSeconds = Settings.AttemptTimeoutSeconds * (Settings.MaxRetries + 1);
+    }
+}
+
+void FProxyBackendClient::Post(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete)
+{
+    Begin(Url, Body, Settings.bIdempotentByDefault, TimeoutSeconds > 0.0f ? TimeoutSeconds : Settings.AttemptTimeoutSeconds, MoveTemp(OnComplete));
+}
+
+void FProxyBackendClient::PostIdempotent(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete)
+{
+    Begin(Url, Body, true, TimeoutSeconds > 0.0f ? TimeoutSeconds : Settings.AttemptTimeoutSeconds, MoveTemp(OnComplete));
+}
+
+void FProxyBackendClient::Send(const FString &Url, const FString &Body, bool bIdempotent, FOnBackendTransportComplete OnComplete)
+{
+    Begin(Url, Body, bIdempotent, Settings.AttemptTimeoutSeconds, MoveTemp(OnComplete));
+}
+
+void FProxyBackendClient::Begin(const FString &Url, const FString &Body, bool bIdempotent, float AttemptTimeout, FOnBackendTransportComplete OnComplete)
+{
+    FCallRef Call = MakeShared<FCall, ESPMode::ThreadSafe>();
+    Call->Url = Url;
+    Call->Body = Body;
+    Call->bIdempotent = bIdempotent;
+    Call->AttemptTimeout = AttemptTimeout;
+    Call->StartTime = FPlatformTime::Seconds();
+    Call->Deadline = Call->StartTime + FMath::Max(Settings.DeadlineSeconds, AttemptTimeout);
+    Call->OnComplete = MoveTemp(OnComplete);
+
+    StartAttempt(Call);
+}
+
+void FProxyBackendClient::StartAttempt(const FCallRef &Call)
+{
+    const double Remaining = Call->Deadline - FPlatformTime::Seconds();
+    if (Remaining <= 0.0)
+    {
+        Finish(Call, false, 0, TEXT("Deadline exceeded"));
+        return;
+    }
+
+    const bool bHasHedgeEndpoint = !Settings.HedgeUrl.IsEmpty() && Settings.HedgeUrl != Call->Url;
+
+    // Punal Manalan, NOTE: An open circuit never reached the primary, so even non-idempotent requests may go to the other endpoint
+    FString Target = Call->Url;
+    if (!AllowRequest(Target))
+    {
+        ++NumShortCircuited;
+        if (!bHasHedgeEndpoint || !AllowRequest(Settings.HedgeUrl))
+        {
+            Finish(Call, false, 0, TEXT("Circuit open"));
+            return;
+        }
+        Target = Settings.HedgeUrl;
+    }
+
+    Issue(Call, Target);
+
+    // Hedge: a slow primary gets a second copy sent to the other endpoint, first answer wins
+    if (bHasHedgeEndpoint && Call->bIdempotent && Target == Call->Url)
+    {
+        const float HedgeDelay = GetHedgeDelaySeconds(Target);
+        if (HedgeDelay < Remaining)
+        {
+            TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Self = AsShared();
+            const int32 Attempt = Call->Attempt;
+            Call->HedgeTimer = After(HedgeDelay, [Self, Call, Attempt]()
+                                     {
+                                         Call->HedgeTimer.Reset();
+                                         if (Call->bDone || Call->Attempt != Attempt || Call->Outstanding == 0 || !Self->AllowRequest(Self->Settings.HedgeUrl))
+                                         {
+                                             return;
+                                         }
+                                         ++Self->NumHedges;
+                                         Self->Issue(Call, Self->Settings.HedgeUrl); });
+        }
+    }
+}
+
+void FProxyBackendClient::Issue(const FCallRef &Call, const FString &Url)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const float Timeout = FMath::Max(0.01f, FMath::Min(Call->AttemptTimeout, static_cast<float>(Call->Deadline - StartTime)));
+
+    ++Call->Outstanding;
+
+    TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Self = AsShared();
+    Transport->Post(Url, Call->Body, Timeout, [Self, Call, Url, StartTime, Timeout](bool bConnected, int32 Code, const FString &Body)
+                    { Self->OnAttemptComplete(Call, Url, StartTime, Timeout, bConnected, Code, Body); });
+}
+
+void FProxyBackendClient::OnAttemptComplete(const FCallRef &Call, const FString &Url, double StartTime, float Timeout, bool bConnected, int32 Code, const FString &Body)
+{
+    const double Now = FPlatformTime::Seconds();
+    const float Latency = static_cast<float>(Now - StartTime);
+    const bool bSuccess = !IsRetryable(bConnected, Code);
+
+    RecordOutcome(Url, bSuccess, Latency);
+    BackendAttemptLatency.RecordSeconds(Latency);
+    (bSuccess ? BackendAttemptsOk : BackendAttemptsFailed).Add();
+    --Call->Outstanding;
+
+    if (Call->bDone)
+    {
+        // The other leg of a hedged request already answered
+        return;
+    }
+    if (bSuccess)
+    {
+        Finish(Call, bConnected, Code, Body);
+        return;
+    }
+    if (Call->Outstanding > 0)
+    {
+        // The other leg may still succeed
+        return;
+    }
+
+    if (Call->bIdempotent && Call->Attempt < Settings.MaxRetries)
+    {
+        const float Cap = FMath::Min(Settings.RetryMaxDelaySeconds, Settings.RetryBaseDelaySeconds * static_cast<float>(1 << FMath::Min(Call->Attempt, 16)));
+        const float Delay = FMath::FRandRange(0.0f, FMath::Max(0.0f, Cap));
+        if (Now + Delay < Call->Deadline)
+        {
+            ++Call->Attempt;
+            ++NumRetries;
+            TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Self = AsShared();
+            After(Delay, [Self, Call]()
+                  { Self->StartAttempt(Call); });
+            return;
+        }
+    }
+
+    if (bConnected)
+    {
+        // Out of retries, hand the last 5xx / 429 response to the caller as it is
+        Finish(Call, true, Code, Body);
+    }
+    else if (Latency >= Timeout * 0.95f)
+    {
+        Finish(Call, false, 0, FString::Printf(TEXT("Request timed out after %.1f seconds"), Timeout));
+    }
+    else
+    {
+        Finish(Call, false, Code, Body.IsEmpty() ? FString(TEXT("Connection failed")) : Body);
+    }
+}
+
+void FProxyBackendClient::Finish(const FCallRef &Call, bool bConnected, int32 Code, const FString &Body)
+{
+    Call->bDone = true;
+    BackendRequestLatency.RecordSeconds(FPlatformTime::Seconds() - Call->StartTime);
+    if (Call->HedgeTimer.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(Call->HedgeTimer);
+        Call->HedgeTimer.Reset();
+    }
+
+    FOnBackendTransportComplete Callback = MoveTemp(Call->OnComplete);
+    if (Callback)
+    {
+        Callback(bConnected, Code, Body);
+    }
+}
+
+FTSTicker::FDelegateHandle FProxyBackendClient::After(float Seconds, TFunction<void()> Callback)
+{
+    return FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Callback = MoveTemp(Callback)](float)
+                                                                              {
+                                                                                  Callback();
+                                                                                  return false; // One shot
+                                                                              }),
+                                                Seconds);
+}
+
+bool FProxyBackendClient::IsRetryable(bool bConnected, int32 Code)
+{
+    return !bConnected || Code >= 500 || Code == 429;
+}
+
+bool FProxyBackendClient::AllowRequest(const FString &Url)
+{
+    FEndpoint &Endpoint = Endpoints.FindOrAdd(Url);
+    if (Endpoint.ConsecutiveFailures < Settings.CircuitFailureThreshold)
+    {
+        return true;
+    }
+    if (FPlatformTime::Seconds() < Endpoint.OpenUntil || Endpoint.bProbeInFlight)
+    {
+        return false;
+    }
+
+    // Half open: one probe decides whether the circuit closes again
+    Endpoint.bProbeInFlight = true;
+    return true;
+}
+
+void FProxyBackendClient::RecordOutcome(const FString &Url, bool bSuccess, float Latency)
+{
+    FEndpoint &Endpoint = Endpoints.FindOrAdd(Url);
+    Endpoint.bProbeInFlight = false;
+
+    if (!bSuccess)
+    {
+        ++Endpoint.ConsecutiveFailures;
+        if (Endpoint.ConsecutiveFailures >= Settings.CircuitFailureThreshold)
+        {
+            if (Endpoint.ConsecutiveFailures == Settings.CircuitFailureThreshold)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("BackendClient: Circuit opened for %s after %d consecutive failures"), *Url, Endpoint.ConsecutiveFailures);
+            }
+            Endpoint.OpenUntil = FPlatformTime::Seconds() + Settings.CircuitOpenSeconds;
+        }
+        return;
+    }
+
+    if (Endpoint.ConsecutiveFailures >= Settings.CircuitFailureThreshold)
+    {
+        UE_LOG(LogTemp, Log, TEXT("BackendClient: Circuit closed for %s"), *Url);
+    }
+    Endpoint.ConsecutiveFailures = 0;
+
+    if (Endpoint.Latencies.Num() < LatencySamples)
+    {
+        Endpoint.Latencies.Add(Latency);
+    }
+    else
+    {
+        Endpoint.Latencies[Endpoint.NextLatency] = Latency;
+        Endpoint.NextLatency = (Endpoint.NextLatency + 1) % LatencySamples;
+    }
+
+    if (++Endpoint.SamplesSinceP95 >= P95RecomputeInterval && Endpoint.Latencies.Num() >= MinSamplesForP95)
+    {
+        TArray<float, TInlineAllocator<LatencySamples>> Sorted(Endpoint.Latencies);
+        Sorted.Sort();
+        Endpoint.P95 = Sorted[FMath::Min(Sorted.Num() - 1, (Sorted.Num() * 95) / 100)];
+        Endpoint.SamplesSinceP95 = 0;
+    }
+}
+
+EProxyCircuitState FProxyBackendClient::GetCircuitState(const FString &Url) const
+{
+    const FEndpoint *Endpoint = Endpoints.Find(Url);
+    if (!Endpoint || Endpoint->ConsecutiveFailures < Settings.CircuitFailureThreshold)
+    {
+        return EProxyCircuitState::Closed;
+    }
+    return FPlatformTime::Seconds() < Endpoint->OpenUntil ? EProxyCircuitState::Open : EProxyCircuitState::HalfOpen;
+}
+
+float FProxyBackendClient::GetHedgeDelaySeconds(const FString &Url) const
+{
+    // Until there are enough samples, only hedge requests that are clearly slow
+    const FEndpoint *Endpoint = Endpoints.Find(Url);
+    const float P95 = (Endpoint && Endpoint->P95 > 0.0f) ? Endpoint->P95 : Settings.AttemptTimeoutSeconds * 0.5f;
+    return FMath::Max(Settings.HedgeMinDelaySeconds, P95);
+}
@@ -0,0 +1,112 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPP_BackendTransport.h"
+
+struct FProxyBackendClientSettings
+{
+    float AttemptTimeoutSeconds = 5.0f;  // Per attempt
+    float DeadlineSeconds = 15.0f;       // Whole request including retries, <= 0 = AttemptTimeoutSeconds * (MaxRetries + 1)
+    int32 MaxRetries = 2;                // Idempotent requests only
+    float RetryBaseDelaySeconds = 0.2f;  // Exponential backoff with full jitter
+    float RetryMaxDelaySeconds = 2.0f;
+    FString HedgeUrl;                    // Empty = no hedging. Must accept the same requests as the primary URL.
+    float HedgeMinDelaySeconds = 0.05f;  // Lower bound for the p95 based hedge delay
+    int32 CircuitFailureThreshold = 5;   // Consecutive failures that open an endpoint's circuit
+    float CircuitOpenSeconds = 10.0f;    // Then one probe request is let through
+    bool bIdempotentByDefault = false;   // For requests made through Post, reads opt in through PostIdempotent / Send
+};
+
+enum class EProxyCircuitState : uint8
+{
+    Closed,
+    Open,
+    HalfOpen
+};
+
+/**
+ * Resilient backend client, itself a transport so it slots in under the batcher:
+ * - every attempt has a timeout and the request as a whole a deadline
+ * - idempotent requests are retried on connection failures / 5xx / 429 with exponential backoff
+ * - with a HedgeUrl, a second copy of an idempotent request goes there once the primary has taken longer
+ *   than its recent p95, the first answer wins
+ * - per endpoint circuit breaker, an open circuit fails fast (or goes straight to the hedge endpoint)
+ *
+ * When bConnectedSuccessfully is false the body carries the reason (timeout, circuit open, deadline...).
+ * Connection reuse (keep-alive) is left to the HTTP module underneath. Game thread only.
+ */
+class P_PROXYSERVER_API FProxyBackendClient : public IProxyBackendTransport, public TSharedFromThis<FProxyBackendClient, ESPMode::ThreadSafe>
+{
+public:
+    FProxyBackendClient(FProxyBackendTransportPtr InTransport, const FProxyBackendClientSettings &InSettings);
+
+    // TimeoutSeconds > 0 overrides the per attempt timeout
+    virtual void Post(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete) override;
+    virtual void PostIdempotent(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete) override;
+
+    void Send(const FString &Url, const FString &Body, bool bIdempotent, FOnBackendTransportComplete OnComplete);
+
+    EProxyCircuitState GetCircuitState(const FString &Url) const;
+    float GetHedgeDelaySeconds(const FString &Url) const;
+
+    int32 GetNumRetries() const { return NumRetries; }
+    int32 GetNumHedges() const { return NumHedges; }
+    int32 GetNumShortCircuited() const { return NumShortCircuited; }
+
+private:
+    struct FEndpoint
+    {
+        int32 ConsecutiveFailures = 0;
+        double OpenUntil = 0.0;
+        bool bProbeInFlight = false;
+
+        // Recent successful latencies, p95 recomputed every few samples
+        TArray<float> Latencies;
+        int32 NextLatency = 0;
+        int32 SamplesSinceP95 = 0;
+        float P95 = 0.0f;
+    };
+
+    struct FCall
+    {
+        FString Url;
+        FString Body;
+        bool bIdempotent = true;
+        float AttemptTimeout = 0.0f;
+        double Deadline = 0.0;
+        int32 Attempt = 0;
+        int32 Outstanding = 0;
+        bool bDone = false;
+        double StartTime = 0.0;
+        FTSTicker::FDelegateHandle HedgeTimer;
+        FOnBackendTransportComplete OnComplete;
+    };
+    typedef TSharedRef<FCall, ESPMode::ThreadSafe> FCallRef;
+
+    void Begin(const FString &Url, const FString &Body, bool bIdempotent, float AttemptTimeout, FOnBackendTransportComplete OnComplete);
+    void StartAttempt(const FCallRef &Call);
+    void Issue(const FCallRef &Call, const FString &Url);
+    void OnAttemptComplete(const FCallRef &Call, const FString &Url, double StartTime, float Timeout, bool bConnected, int32 Code, const FString &Body);
+    void Finish(const FCallRef &Call, bool bConnected, int32 Code, const FString &Body);
+    static FTSTicker::FDelegateHandle After(float Seconds, TFunction<void()> Callback);
+
+    // Circuit breaker, false = fail fast
+    bool AllowRequest(const FString &Url);
+    void RecordOutcome(const FString &Url, bool bSuccess, float Latency);
+
+    static bool IsRetryable(bool bConnected, int32 Code);
+
+    FProxyBackendTransportPtr Transport;
+    FProxyBackendClientSettings Settings;
+    TMap<FString, FEndpoint> Endpoints;
+
+    int32 NumRetries = 0;
+    int32 NumHedges = 0;
+    int32 NumShortCircuited = 0;
+};
@@ -0,0 +1,717 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_BackendPushChannel.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "IWebSocket.h"
+#include "JsonObjectConverter.h"
+#include "Modules/ModuleManager.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "WebSocketsModule.h"
+
+namespace
+{
+    FString to_condensed_json(const TSharedRef<FJsonObject> &Object)
+    {
+        FString Out;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+        FJsonSerializer::Serialize(Object, Writer);
+        return Out;
+    }
+
+    // One shot on the core ticker, used to answer "later" like a real socket would
+    void run_next_tick(TFunction<void()> Callback, float Delay = 0.0f)
+    {
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Callback = MoveTemp(Callback)](float)
+                                                                           {
+                                                                               Callback();
+                                                                               return false;
+                                                                           }),
+                                             Delay);
+    }
+
+    // Best effort for a frame that is not JSON: every number following a "seq" key, in order
+    TArray<int64> find_seqs(const FString &Frame)
+    {
+        TArray<int64> Seqs;
+        const TCHAR *Key = TEXT("\"seq\"");
+        int32 From = 0;
+        for (int32 Found; (Found = Frame.Find(Key, ESearchCase::CaseSensitive, ESearchDir::FromStart, From)) != INDEX_NONE;)
+        {
+            int32 Index = Found + FCString::Strlen(Key);
+            while (Index < Frame.Len() && FChar::IsWhitespace(Frame[Index]))
+            {
+                ++Index;
+            }
+            if (Index < Frame.Len() && Frame[Index] == TEXT(':'))
+            {
+                ++Index;
+                while (Index < Frame.Len() && FChar::IsWhitespace(Frame[Index]))
+                {
+                    ++Index;
+                }
+                int64 Seq = 0;
+                int32 Digits = 0;
+                while (Index < Frame.Len() && FChar::IsDigit(Frame[Index]) && Digits < 18)
+                {
+                    Seq = Seq * 10 + (Frame[Index++] - TEXT('0'));
+                    ++Digits;
+                }
+                if (Seq > 0)
+                {
+                    Seqs.Add(Seq);
+                }
+            }
+            From = Index;
+        }
+        return Seqs;
+    }
+} // anonymous namespace
+
+// --- FProxyPushEvent ---
+
+bool FProxyPushEvent::ParseFrame(const FString &Frame, TArray<FProxyPushEvent> &OutEvents)
+{
+    TSharedPtr<FJsonValue> Root;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Frame);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        return false;
+    }
+
+    if (Root->Type == EJson::Object)
+    {
+        OutEvents.Add(ParseObject(*Root->AsObject()));
+        return true;
+    }
+    if (Root->Type == EJson::Array)
+    {
+        for (const TSharedPtr<FJsonValue> &Element : Root->AsArray())
+        {
+            const TSharedPtr<FJsonObject> *Object = nullptr;
+            if (Element.IsValid() && Element->TryGetObject(Object))
+            {
+                OutEvents.Add(ParseObject(**Object));
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+FProxyPushEvent FProxyPushEvent::ParseObject(const FJsonObject &Object)
+{
+    FProxyPushEvent Event;
+    Object.TryGetNumberField(TEXT("seq"), Event.Seq);
+    Object.TryGetStringField(TEXT("playerId"), Event.PlayerId);
+
+    FString TypeName;
+    if (!Object.TryGetStringField(TEXT("type"), TypeName))
+    {
+        bool bInvalidateAll = false;
+        TypeName = (Object.TryGetBoolField(TEXT("invalidateAll"), bInvalidateAll) && bInvalidateAll) ? TEXT("invalidateAll") : TEXT("invalidate");
+    }
+
+    if (TypeName == TEXT("session.upsert"))
+    {
+        const TSharedPtr<FJsonObject> *DataObject = nullptr;
+        if (Object.TryGetObjectField(TEXT("data"), DataObject) && FJsonObjectConverter::JsonObjectToUStruct(DataObject->ToSharedRef(), &Event.Data))
+        {
+            if (Event.PlayerId.IsEmpty())
+            {
+                Event.PlayerId = Event.Data.playerID;
+            }
+            Event.Type = EProxyPushEventType::SessionUpsert;
+            return Event;
+        }
+        UE_LOG(LogTemp, Warning, TEXT("BackendPush: Malformed session.upsert for %s (seq %lld), only invalidating it"), *Event.PlayerId, Event.Seq);
+    }
+    else if (TypeName == TEXT("session.remove"))
+    {
+        Event.Type = EProxyPushEventType::SessionRemove;
+        return Event;
+    }
+    else if (TypeName == TEXT("roles"))
+    {
+        Object.TryGetStringArrayField(TEXT("roles"), Event.Roles);
+        Event.Type = EProxyPushEventType::RolesChanged;
+        return Event;
+    }
+    else if (TypeName == TEXT("ban"))
+    {
+        Object.TryGetStringField(TEXT("reason"), Event.Reason);
+        Event.Type = EProxyPushEventType::Banned;
+        return Event;
+    }
+    else if (TypeName == TEXT("invalidateAll"))
+    {
+        Event.Type = EProxyPushEventType::InvalidateAll;
+        return Event;
+    }
+    else if (TypeName == TEXT("resyncRequired"))
+    {
+        Event.Type = EProxyPushEventType::ResyncRequired;
+        return Event;
+    }
+    else if (TypeName != TEXT("invalidate"))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("BackendPush: Unknown event type %s (seq %lld)"), *TypeName, Event.Seq);
+    }
+
+    // Punal Manalan, NOTE: Unknown and malformed events still become an (at worst empty) invalidation,
+    // dropping them would leave a hole in the sequence that no resume could ever fill
+    Event.Type = EProxyPushEventType::Invalidate;
+    Object.TryGetStringArrayField(TEXT("playerIds"), Event.PlayerIds);
+    return Event;
+}
+
+// --- FProxyWebSocketPushConnection ---
+
+FProxyWebSocketPushConnection::FProxyWebSocketPushConnection(const FString &InUrl)
+    : Url(InUrl)
+{
+}
+
+FProxyWebSocketPushConnection::~FProxyWebSocketPushConnection()
+{
+    Close();
+}
+
+void FProxyWebSocketPushConnection::Connect(FOnConnected OnConnected, FOnMessage OnMessage, FOnClosed OnClosed)
+{
+    Close();
+
+    Socket = FModuleManager::LoadModuleChecked<FWebSocketsModule>(TEXT("WebSockets")).CreateWebSocket(Url);
+    Socket->OnConnected().AddLambda([OnConnected]()
+                                    { OnConnected(); });
+    Socket->OnMessage().AddLambda([OnMessage](const FString &Message)
+                                  { OnMessage(Message); });
+    Socket->OnConnectionError().AddLambda([OnClosed](const FString &Error)
+                                          { OnClosed(Error); });
+    Socket->OnClosed().AddLambda([OnClosed](int32 StatusCode, const FString &Reason, bool bWasClean)
+                                 { OnClosed(FString::Printf(TEXT("Closed with status %d: %s"), StatusCode, *Reason)); });
+    Socket->Connect();
+}
+
+void FProxyWebSocketPushConnection::Send(const FString &Message)
+{
+    if (Socket.IsValid() && Socket->IsConnected())
+    {
+        Socket->Send(Message);
+    }
+}
+
+void FProxyWebSocketPushConnection::Close()
+{
+    if (!Socket.IsValid())
+    {
+        return;
+    }
+
+    // A deliberate close is not reported back as a disconnect
+    Socket->OnConnected().Clear();
+    Socket->OnMessage().Clear();
+    Socket->OnConnectionError().Clear();
+    Socket->OnClosed().Clear();
+    Socket->Close();
+    Socket.Reset();
+}
+
+// --- FProxyMockPushServer ---
+
+class FProxyMockPushServer::FConnection : public IProxyPushConnection, public TSharedFromThis<FProxyMockPushServer::FConnection, ESPMode::ThreadSafe>
+{
+public:
+    explicit FConnection(TWeakPtr<FProxyMockPushServer, ESPMode::ThreadSafe> InServer)
+        : Server(InServer)
+    {
+    }
+
+    virtual void Connect(FOnConnected OnConnected, FOnMessage InOnMessage, FOnClosed InOnClosed) override
+    {
+        TSharedPtr<FProxyMockPushServer, ESPMode::ThreadSafe> PinnedServer = Server.Pin();
+        if (!PinnedServer.IsValid())
+        {
+            run_next_tick([InOnClosed]()
+                          { InOnClosed(TEXT("Connection refused")); });
+            return;
+        }
+
+        OnMessage = MoveTemp(InOnMessage);
+        OnClosed = MoveTemp(InOnClosed);
+        bOpen = true;
+        PinnedServer->Connections.Add(AsShared());
+
+        TWeakPtr<FConnection, ESPMode::ThreadSafe> WeakThis = AsShared();
+        run_next_tick([WeakThis, OnConnected]()
+                      {
+                          TSharedPtr<FConnection, ESPMode::ThreadSafe> This = WeakThis.Pin();
+                          if (This.IsValid() && This->bOpen)
+                          {
+                              OnConnected();
+                          } });
+    }
+
+    virtual void Send(const FString &Message) override
+    {
+        TSharedPtr<FProxyMockPushServer, ESPMode::ThreadSafe> PinnedServer = Server.Pin();
+        if (bOpen && PinnedServer.IsValid())
+        {
+            PinnedServer->HandleClientMessage(AsShared(), Message);
+        }
+    }
+
+    virtual void Close() override
+    {
+        bOpen = false;
+    }
+
+    void Deliver(const FString &Frame)
+    {
+        TWeakPtr<FConnection, ESPMode::ThreadSafe> WeakThis = AsShared();
+        run_next_tick([WeakThis, Frame]()
+                      {
+                          TSharedPtr<FConnection, ESPMode::ThreadSafe> This = WeakThis.Pin();
+                          if (This.IsValid() && This->bOpen)
+                          {
+                              This->OnMessage(Frame);
+                          } });
+    }
+
+    void Drop()
+    {
+        if (!bOpen)
+        {
+            return;
+        }
+        bOpen = false;
+        run_next_tick([Callback = OnClosed]()
+                      { Callback(TEXT("Connection dropped")); });
+    }
+
+    bool IsOpen() const { return bOpen; }
+
+private:
+    TWeakPtr<FProxyMockPushServer, ESPMode::ThreadSafe> Server;
+    FOnMessage OnMessage;
+    FOnClosed OnClosed;
+    bool bOpen = false;
+};
+
+FProxyMockPushServer::FProxyMockPushServer(int32 InHistoryLimit)
+    : HistoryLimit(FMath::Max(1, InHistoryLimit))
+{
+}
+
+int64 FProxyMockPushServer::Publish(const TSharedRef<FJsonObject> &Event)
+{
+    const int64 Seq = NextSeq++;
+    Event->SetNumberField(TEXT("seq"), (double)Seq);
+    Broadcast(Seq, to_condensed_json(Event));
+    return Seq;
+}
+
+int64 FProxyMockPushServer::PublishMalformed()
+{
+    const int64 Seq = NextSeq++;
+    Broadcast(Seq, FString::Printf(TEXT("{\"seq\":%lld,\"type\":\"session.remove\",\"playerId\":"), Seq));
+    return Seq;
+}
+
+void FProxyMockPushServer::Broadcast(int64 Seq, const FString &Frame)
+{
+    History.Emplace(Seq, Frame);
+    if (History.Num() > HistoryLimit)
+    {
+        History.RemoveAt(0, History.Num() - HistoryLimit);
+    }
+
+    Connections.RemoveAll([](const TWeakPtr<FConnection, ESPMode::ThreadSafe> &Weak)
+                          {
+                              TSharedPtr<FConnection, ESPMode::ThreadSafe> Connection = Weak.Pin();
+                              return !Connection.IsValid() || !Connection->IsOpen(); });
+    for (const TWeakPtr<FConnection, ESPMode::ThreadSafe> &Weak : Connections)
+    {
+        Weak.Pin()->Deliver(Frame);
+    }
+}
+
+void FProxyMockPushServer::DropConnections()
+{
+    for (const TWeakPtr<FConnection, ESPMode::ThreadSafe> &Weak : Connections)
+    {
+        if (TSharedPtr<FConnection, ESPMode::ThreadSafe> Connection = Weak.Pin())
+        {
+            Connection->Drop();
+        }
+    }
+    Connections.Reset();
+}
+
+FProxyPushConnectionFactory FProxyMockPushServer::MakeConnectionFactory()
+{
+    TWeakPtr<FProxyMockPushServer, ESPMode::ThreadSafe> WeakThis = AsShared();
+    return [WeakThis]() -> FProxyPushConnectionPtr
+    {
+        return MakeShared<FConnection, ESPMode::ThreadSafe>(WeakThis);
+    };
+}
+
+void FProxyMockPushServer::HandleClientMessage(const TSharedRef<FConnection, ESPMode::ThreadSafe> &Connection, const FString &Message)
+{
+    TSharedPtr<FJsonObject> Object;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+    FString Type;
+    if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid() || !Object->TryGetStringField(TEXT("type"), Type) || Type != TEXT("resume"))
+    {
+        return;
+    }
+
+    int64 LastSeq = 0;
+    Object->TryGetNumberField(TEXT("lastSeq"), LastSeq);
+
+    // Older than what we kept, or ahead of us (we restarted): the client has to rebuild its state
+    const int64 OldestSeq = History.Num() > 0 ? History[0].Key : NextSeq;
+    if (LastSeq + 1 < OldestSeq || LastSeq >= NextSeq)
+    {
+        Connection->Deliver(FString::Printf(TEXT("{\"type\":\"resyncRequired\",\"seq\":%lld}"), NextSeq - 1));
+        return;
+    }
+
+    for (const TPair<int64, FString> &Entry : History)
+    {
+        if (Entry.Key > LastSeq)
+        {
+            Connection->Deliver(Entry.Value);
+        }
+    }
+}
+
+// --- FProxyBackendPushChannel ---
+
+FProxyBackendPushChannel::FProxyBackendPushChannel(FProxyPushConnectionFactory InFactory, FOnEvents InOnEvents, int64 InLastAppliedSeq)
+    : Factory(MoveTemp(InFactory)), OnEvents(MoveTemp(InOnEvents)), LastAppliedSeq(InLastAppliedSeq)
+{
+}
+
+FProxyBackendPushChannel::~FProxyBackendPushChannel()
+{
+    Stop();
+}
+
+void FProxyBackendPushChannel::Start(int64 ResumeFromSeq)
+{
+    if (bRunning)
+    {
+        return;
+    }
+
+    bRunning = true;
+    LastAppliedSeq = ResumeFromSeq;
+    OutOfOrder.Reset();
+    GapSince = 0.0;
+    ReconnectAttempt = 0;
+
+    TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FProxyBackendPushChannel::Tick));
+    Connect();
+}
+
+void FProxyBackendPushChannel::Stop()
+{
+    bRunning = false;
+    bConnected = false;
+    ++Generation;
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+    TickHandle.Reset();
+    ReconnectHandle.Reset();
+
+    if (Connection.IsValid())
+    {
+        Connection->Close();
+        Connection.Reset();
+    }
+}
+
+void FProxyBackendPushChannel::Connect()
+{
+    const uint32 ConnectionGeneration = ++Generation;
+    Connection = Factory ? Factory() : nullptr;
+    if (!Connection.IsValid())
+    {
+        Reconnect(TEXT("No connection available"));
+        return;
+    }
+
+    TWeakPtr<FProxyBackendPushChannel, ESPMode::ThreadSafe> WeakThis = AsShared();
+    Connection->Connect(
+        [WeakThis, ConnectionGeneration]()
+        {
+            if (TSharedPtr<FProxyBackendPushChannel, ESPMode::ThreadSafe> This = WeakThis.Pin())
+            {
+                This->HandleConnected(ConnectionGeneration);
+            }
+        },
+        [WeakThis, ConnectionGeneration](const FString &Frame)
+        {
+            if (TSharedPtr<FProxyBackendPushChannel, ESPMode::ThreadSafe> This = WeakThis.Pin())
+            {
+                This->HandleMessage(ConnectionGeneration, Frame);
+            }
+        },
+        [WeakThis, ConnectionGeneration](const FString &Reason)
+        {
+            if (TSharedPtr<FProxyBackendPushChannel, ESPMode::ThreadSafe> This = WeakThis.Pin())
+            {
+                This->HandleClosed(ConnectionGeneration, Reason);
+            }
+        });
+}
+
+void FProxyBackendPushChannel::HandleConnected(uint32 ConnectionGeneration)
+{
+    if (ConnectionGeneration != Generation)
+    {
+        return;
+    }
+
+    bConnected = true;
+    ReconnectAttempt = 0;
+    UE_LOG(LogTemp, Log, TEXT("BackendPush: Connected, resuming after seq %lld"), LastAppliedSeq);
+    Connection->Send(FString::Printf(TEXT("{\"type\":\"resume\",\"lastSeq\":%lld}"), LastAppliedSeq));
+}
+
+void FProxyBackendPushChannel::HandleMessage(uint32 ConnectionGeneration, const FString &Frame)
+{
+    if (ConnectionGeneration != Generation)
+    {
+        return;
+    }
+
+    // Parsing (and FPlayerData conversion) happens off the game thread, one frame after another so a burst
+    // costs one task and frames come out in the order they arrived. Tick applies the result.
+    Frames.Enqueue(Frame);
+    if (bParsing.exchange(true))
+    {
+        return; // The running task picks it up
+    }
+
+    TSharedRef<FProxyBackendPushChannel, ESPMode::ThreadSafe> Self = AsShared();
+    Async(EAsyncExecution::ThreadPool, [Self]()
+          { Self->ParseFrames(); });
+}
+
+void FProxyBackendPushChannel::ParseFrames()
+{
+    do
+    {
+        FString Frame;
+        while (Frames.Dequeue(Frame))
+        {
+            TArray<FProxyPushEvent> Events;
+            if (!FProxyPushEvent::ParseFrame(Frame, Events))
+            {
+                NumParseErrors.fetch_add(1);
+                Events.Reset();
+
+                // Punal Manalan, NOTE: Dropping the frame would leave a hole no resume fills (it would be re-sent just as broken),
+                // so whatever sequence numbers it carried are taken as applied and their state rebuilt instead
+                for (const int64 Seq : find_seqs(Frame))
+                {
+                    FProxyPushEvent &Placeholder = Events.AddDefaulted_GetRef();
+                    Placeholder.Seq = Seq;
+                    Placeholder.Type = EProxyPushEventType::Malformed;
+                }
+                UE_LOG(LogTemp, Warning, TEXT("BackendPush: Skipping a frame that is not JSON (%d sequence numbers): %s"), Events.Num(), *Frame.Left(256));
+                if (Events.Num() == 0)
+                {
+                    NumUnsequencedParseErrors.fetch_add(1);
+                    continue;
+                }
+            }
+            Parsed.Enqueue(MoveTemp(Events));
+        }
+        bParsing.store(false);
+
+        // A frame enqueued between the last Dequeue and the store above saw bParsing still set, pick it up here
+    } while (!Frames.IsEmpty() && !bParsing.exchange(true));
+}
+
+void FProxyBackendPushChannel::Submit(TArray<FProxyPushEvent> Events)
+{
+    TArray<FProxyPushEvent> Batch;
+    Order(Events, Batch);
+    Advance(Batch);
+
+    if (Batch.Num() > 0 && OnEvents)
+    {
+        OnEvents(Batch);
+    }
+}
+
+void FProxyBackendPushChannel::HandleClosed(uint32 ConnectionGeneration, const FString &Reason)
+{
+    if (ConnectionGeneration != Generation)
+    {
+        return;
+    }
+    Reconnect(Reason);
+}
+
+void FProxyBackendPushChannel::Reconnect(const FString &Reason)
+{
+    if (!bRunning)
+    {
+        return;
+    }
+
+    ++Generation;
+    bConnected = false;
+    if (Connection.IsValid())
+    {
+        Connection->Close();
+        Connection.Reset();
+    }
+
+    // Whatever waited behind a gap is sent again after the resume
+    OutOfOrder.Reset();
+    GapSince = 0.0;
+
+    const float Backoff = FMath::Min(MaxReconnectDelaySeconds, static_cast<float>(1 << FMath::Min(ReconnectAttempt, 5)));
+    const float Delay = Backoff * FMath::FRandRange(0.5f, 1.0f);
+    ++ReconnectAttempt;
+    ++NumReconnects;
+    UE_LOG(LogTemp, Warning, TEXT("BackendPush: %s, reconnecting in %.1f seconds"), *Reason, Delay);
+
+    FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+    TWeakPtr<FProxyBackendPushChannel, ESPMode::ThreadSafe> WeakThis = AsShared();
+    ReconnectHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+                                                                                         {
+                                                                                             TSharedPtr<FProxyBackendPushChannel, ESPMode::ThreadSafe> This = WeakThis.Pin();
+                                                                                             if (This.IsValid() && This->bRunning)
+                                                                                             {
+                                                                                                 This->ReconnectHandle.Reset();
+                                                                                                 This->Connect();
+                                                                                             }
+                                                                                             return false; }),
+                                                           Delay);
+}
+
+bool FProxyBackendPushChannel::Tick(float DeltaTime)
+{
+    TArray<FProxyPushEvent> Batch;
+    TArray<FProxyPushEvent> FrameEvents;
+    while (Parsed.Dequeue(FrameEvents))
+    {
+        Order(FrameEvents, Batch);
+        FrameEvents.Reset();
+    }
+    Advance(Batch);
+
+    if (Batch.Num() > 0 && OnEvents)
+    {
+        OnEvents(Batch);
+    }
+    return true;
+}
+
+void FProxyBackendPushChannel::Order(TArray<FProxyPushEvent> &FrameEvents, TArray<FProxyPushEvent> &OutBatch)
+{
+    for (FProxyPushEvent &Event : FrameEvents)
+    {
+        if (Event.Type == EProxyPushEventType::ResyncRequired)
+        {
+            // The backend restarts our position at Seq, anything older that is still waiting is moot
+            if (Event.Seq > 0)
+            {
+                const int64 NewBase = Event.Seq;
+                LastAppliedSeq = NewBase;
+                for (auto It = OutOfOrder.CreateIterator(); It; ++It)
+                {
+                    if (It.Key() <= NewBase)
+                    {
+                        It.RemoveCurrent();
+                    }
+                }
+            }
+            OutBatch.Add(MoveTemp(Event));
+        }
+        else if (Event.Seq == 0)
+        {
+            OutBatch.Add(MoveTemp(Event));
+        }
+        else if (Event.Seq > LastAppliedSeq)
+        {
+            // A readable copy of the same event (e.g. re-sent by a resume) beats the placeholder
+            if (Event.Type != EProxyPushEventType::Malformed || !OutOfOrder.Contains(Event.Seq))
+            {
+                OutOfOrder.Add(Event.Seq, MoveTemp(Event));
+            }
+        }
+        // else: already applied, re-sent by a resume
+    }
+}
+
+void FProxyBackendPushChannel::Advance(TArray<FProxyPushEvent> &OutBatch)
+{
+    for (;;)
+    {
+        while (FProxyPushEvent *Next = OutOfOrder.Find(LastAppliedSeq + 1))
+        {
+            if (Next->Type == EProxyPushEventType::Malformed)
+            {
+                ++NumSkippedEvents;
+            }
+            OutBatch.Add(MoveTemp(*Next));
+            OutOfOrder.Remove(++LastAppliedSeq);
+        }
+
+        if (OutOfOrder.Num() == 0)
+        {
+            GapSince = 0.0;
+            return;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        if (GapSince == 0.0)
+        {
+            GapSince = Now;
+            UnsequencedParseErrorsAtGap = NumUnsequencedParseErrors.load();
+            return;
+        }
+        if (Now - GapSince <= GapTimeoutSeconds)
+        {
+            return;
+        }
+
+        // A resume can fill the gap unless it was left by a frame we could not read (it would come back just as broken),
+        // or there is no connection to resume (events only arrive through Submit)
+        if (bRunning && NumUnsequencedParseErrors.load() == UnsequencedParseErrorsAtGap)
+        {
+            Reconnect(FString::Printf(TEXT("Missing event after seq %lld"), LastAppliedSeq));
+            return;
+        }
+
+        int64 FirstWaiting = MAX_int64;
+        for (const TPair<int64, FProxyPushEvent> &Waiting : OutOfOrder)
+        {
+            FirstWaiting = FMath::Min(FirstWaiting, Waiting.Key);
+        }
+        UE_LOG(LogTemp, Warning, TEXT("BackendPush: Giving up on seq %lld to %lld, rebuilding their state instead"), LastAppliedSeq + 1, FirstWaiting - 1);
+
+        FProxyPushEvent &Skipped = OutBatch.AddDefaulted_GetRef();
+        Skipped.Seq = LastAppliedSeq + 1;
+        Skipped.Type = EProxyPushEventType::Malformed;
+        NumSkippedEvents += static_cast<int32>(FirstWaiting - 1 - LastAppliedSeq);
+        LastAppliedSeq = FirstWaiting - 1;
+        GapSince = 0.0;
+    }
+}
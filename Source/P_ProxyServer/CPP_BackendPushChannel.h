@@ -0,0 +1,196 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "CPP_STRUCT__ProxyServer.h"
+#include <atomic>
+
+class IWebSocket;
+class FJsonObject;
+
+enum class EProxyPushEventType : uint8
+{
+    SessionUpsert,  // Data holds the new FPlayerData
+    SessionRemove,
+    RolesChanged,   // Roles holds the player's new roles
+    Banned,         // Reason is shown to the player if they are connected
+    Invalidate,     // Drop whatever is cached about PlayerId and PlayerIds
+    InvalidateAll,
+    ResyncRequired, // The backend cannot resume from our sequence number, incremental state must be rebuilt
+    Malformed       // Stands in for sequenced events whose frame could not be parsed, their state must be rebuilt too
+};
+
+/**
+ * One event pushed by the backend. Wire format is a JSON object (or an array of them per frame):
+ *   {"seq": 42, "type": "session.upsert", "playerId": "...", "data": {FPlayerData}}
+ *   {"seq": 43, "type": "session.remove", "playerId": "..."}
+ *   {"seq": 44, "type": "roles", "playerId": "...", "roles": ["VIP"]}
+ *   {"seq": 45, "type": "ban", "playerId": "...", "reason": "..."}
+ *   {"type": "invalidate", "playerId": "..." | "playerIds": [...]}  /  {"type": "invalidateAll"}
+ *   {"type": "resyncRequired", "seq": 45}
+ * Events without "seq" are applied as they arrive and are not part of resume. A bare object without "type"
+ * (e.g. {"playerIds": [...]} or {"invalidateAll": true}) is an invalidation.
+ */
+struct P_PROXYSERVER_API FProxyPushEvent
+{
+    int64 Seq = 0;
+    EProxyPushEventType Type = EProxyPushEventType::Invalidate;
+    FString PlayerId;
+    TArray<FString> PlayerIds; // Invalidate naming several players
+    FPlayerData Data;
+    TArray<FString> Roles;
+    FString Reason;
+
+    // False if the frame is not JSON. Unknown event types become empty invalidations. Safe to call off the game thread.
+    static bool ParseFrame(const FString &Frame, TArray<FProxyPushEvent> &OutEvents);
+
+    static FProxyPushEvent ParseObject(const FJsonObject &Object);
+};
+
+/** A persistent text connection to the backend's event stream. Callbacks run on the game thread. */
+class P_PROXYSERVER_API IProxyPushConnection
+{
+public:
+    typedef TFunction<void()> FOnConnected;
+    typedef TFunction<void(const FString &)> FOnMessage;
+    typedef TFunction<void(const FString &)> FOnClosed; // Reason
+
+    virtual ~IProxyPushConnection() = default;
+
+    virtual void Connect(FOnConnected OnConnected, FOnMessage OnMessage, FOnClosed OnClosed) = 0;
+    virtual void Send(const FString &Message) = 0;
+    virtual void Close() = 0;
+};
+
+typedef TSharedPtr<IProxyPushConnection, ESPMode::ThreadSafe> FProxyPushConnectionPtr;
+typedef TFunction<FProxyPushConnectionPtr()> FProxyPushConnectionFactory;
+
+class P_PROXYSERVER_API FProxyWebSocketPushConnection : public IProxyPushConnection
+{
+public:
+    explicit FProxyWebSocketPushConnection(const FString &InUrl);
+    virtual ~FProxyWebSocketPushConnection() override;
+
+    virtual void Connect(FOnConnected OnConnected, FOnMessage OnMessage, FOnClosed OnClosed) override;
+    virtual void Send(const FString &Message) override;
+    virtual void Close() override;
+
+private:
+    FString Url;
+    TSharedPtr<IWebSocket> Socket;
+};
+
+/**
+ * In-process stand-in for the backend's event stream. Published events get consecutive sequence numbers
+ * and are kept (up to HistoryLimit) so reconnecting clients can resume, older resumes get "resyncRequired".
+ */
+class P_PROXYSERVER_API FProxyMockPushServer : public TSharedFromThis<FProxyMockPushServer, ESPMode::ThreadSafe>
+{
+public:
+    explicit FProxyMockPushServer(int32 InHistoryLimit = 1024);
+
+    // Stamps "seq" onto the event, records it and sends it to every connected client. Returns the sequence number.
+    int64 Publish(const TSharedRef<FJsonObject> &Event);
+
+    // Takes the next sequence number for a frame that is cut short, as a buggy backend would send it
+    int64 PublishMalformed();
+
+    // Simulates a network failure on every open connection
+    void DropConnections();
+
+    int64 GetLastSeq() const { return NextSeq - 1; }
+
+    FProxyPushConnectionFactory MakeConnectionFactory();
+
+private:
+    class FConnection;
+
+    void HandleClientMessage(const TSharedRef<FConnection, ESPMode::ThreadSafe> &Connection, const FString &Message);
+    void Broadcast(int64 Seq, const FString &Frame);
+
+    int32 HistoryLimit;
+    int64 NextSeq = 1;
+    TArray<TPair<int64, FString>> History;
+    TArray<TWeakPtr<FConnection, ESPMode::ThreadSafe>> Connections;
+};
+
+/**
+ * Keeps a push connection to the backend open and turns its frames into ordered event batches.
+ *  - frames are parsed one after another on a single background task, the game thread only applies the result
+ *  - once per frame, everything that arrived in sequence order is handed to OnEvents as one batch.
+ *    Duplicates (after a resume) are dropped, events after a gap wait until the gap fills.
+ *  - an unparsable frame is skipped: its sequence numbers (when they can still be read) become Malformed
+ *    events, otherwise the gap it leaves is skipped with a Malformed event once it times out
+ *  - on connect the channel sends {"type": "resume", "lastSeq": N}. On disconnect, or a gap that does not
+ *    fill within GapTimeoutSeconds, it reconnects with exponential backoff and resumes.
+ *  - Submit feeds events that came another way (e.g. over HTTP) through the same ordering and dedup,
+ *    it works whether or not the channel was started
+ * Game thread only.
+ */
+class P_PROXYSERVER_API FProxyBackendPushChannel : public TSharedFromThis<FProxyBackendPushChannel, ESPMode::ThreadSafe>
+{
+public:
+    typedef TFunction<void(const TArray<FProxyPushEvent> &)> FOnEvents;
+
+    static constexpr float GapTimeoutSeconds = 5.0f;
+    static constexpr float MaxReconnectDelaySeconds = 30.0f;
+
+    // InLastAppliedSeq: where Submit continues from when the channel is never started
+    FProxyBackendPushChannel(FProxyPushConnectionFactory InFactory, FOnEvents InOnEvents, int64 InLastAppliedSeq = 0);
+    ~FProxyBackendPushChannel();
+
+    void Start(int64 ResumeFromSeq);
+    void Stop();
+
+    // Orders and applies already parsed events right away, OnEvents runs before this returns if anything is in order
+    void Submit(TArray<FProxyPushEvent> Events);
+
+    bool IsConnected() const { return bConnected; }
+    int64 GetLastAppliedSeq() const { return LastAppliedSeq; }
+    int32 GetNumReconnects() const { return NumReconnects; }
+    int32 GetNumParseErrors() const { return NumParseErrors.load(); }
+    int32 GetNumSkippedEvents() const { return NumSkippedEvents; }
+
+private:
+    void Connect();
+    void HandleConnected(uint32 ConnectionGeneration);
+    void HandleMessage(uint32 ConnectionGeneration, const FString &Frame);
+    void HandleClosed(uint32 ConnectionGeneration, const FString &Reason);
+    void Reconnect(const FString &Reason);
+    bool Tick(float DeltaTime);
+
+    void ParseFrames(); // Background, at most one at a time
+    void Order(TArray<FProxyPushEvent> &FrameEvents, TArray<FProxyPushEvent> &OutBatch);
+    void Advance(TArray<FProxyPushEvent> &OutBatch);
+
+    FProxyPushConnectionFactory Factory;
+    FOnEvents OnEvents;
+    FProxyPushConnectionPtr Connection;
+
+    uint32 Generation = 0; // Callbacks of replaced connections are ignored
+    bool bRunning = false;
+    bool bConnected = false;
+    int32 ReconnectAttempt = 0;
+    int32 NumReconnects = 0;
+    int32 NumSkippedEvents = 0;
+    std::atomic<int32> NumParseErrors{0};
+    std::atomic<int32> NumUnsequencedParseErrors{0}; // Frames so broken that not even a "seq" could be read
+
+    TQueue<FString, EQueueMode::Spsc> Frames; // Received, waiting for ParseFrames
+    std::atomic<bool> bParsing{false};
+    TQueue<TArray<FProxyPushEvent>, EQueueMode::Mpsc> Parsed;
+    TMap<int64, FProxyPushEvent> OutOfOrder;
+    int64 LastAppliedSeq = 0;
+    double GapSince = 0.0;
+    int32 UnsequencedParseErrorsAtGap = 0;
+
+    FTSTicker::FDelegateHandle TickHandle;
+    FTSTicker::FDelegateHandle ReconnectHandle;
+};
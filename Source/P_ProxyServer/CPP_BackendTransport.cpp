@@ -0,0 +1,100 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_BackendTransport.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+void FProxyHttpBackendTransport::Post(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete)
+{
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+
+    Request->SetURL(Url);
+    Request->SetVerb(TEXT("POST"));
+    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+    Request->SetHeader(TEXT("Connection"), TEXT("keep-alive")); // Reuse the pooled connection to the backend
+    Request->SetContentAsString(Body);
+    if (TimeoutSeconds > 0.0f)
+    {
+        Request->SetTimeout(TimeoutSeconds);
+    }
+
+    Request->OnProcessRequestComplete().BindLambda(
+        [Callback = MoveTemp(OnComplete)](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+        {
+            const bool bConnected = bConnectedSuccessfully && Response.IsValid();
+            Callback(bConnected, Response.IsValid() ? Response->GetResponseCode() : 0, bConnected ? Response->GetContentAsString() : FString());
+        });
+
+    Request->ProcessRequest();
+}
+
+FProxyMockBackendTransport::FProxyMockBackendTransport(FHandler InHandler)
+    : Handler(MoveTemp(InHandler))
+{
+}
+
+FProxyMockBackendTransport::FFaultRule &FProxyMockBackendTransport::FindOrAddRule(const FString &UrlSubstring)
+{
+    for (FFaultRule &Rule : Rules)
+    {
+        if (Rule.UrlSubstring == UrlSubstring)
+        {
+            return Rule;
+        }
+    }
+    FFaultRule &Rule = Rules.AddDefaulted_GetRef();
+    Rule.UrlSubstring = UrlSubstring;
+    return Rule;
+}
+
+void FProxyMockBackendTransport::SetLatency(float Seconds, const FString &UrlSubstring)
+{
+    FindOrAddRule(UrlSubstring).Latency = FMath::Max(0.0f, Seconds);
+}
+
+void FProxyMockBackendTransport::SetFailureRate(float Probability, const FString &UrlSubstring)
+{
+    FindOrAddRule(UrlSubstring).FailureRate = FMath::Clamp(Probability, 0.0f, 1.0f);
+}
+
+void FProxyMockBackendTransport::Post(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete)
+{
+    ++NumRequests;
+
+    float Latency = 0.0f;
+    float FailureRate = 0.0f;
+    for (const FFaultRule &Rule : Rules)
+    {
+        if (Rule.UrlSubstring.IsEmpty() || Url.Contains(Rule.UrlSubstring))
+        {
+            Latency = FMath::Max(Latency, Rule.Latency);
+            FailureRate = FMath::Max(FailureRate, Rule.FailureRate);
+        }
+    }
+
+    // A request that outlives its deadline fails like a real timeout would, at the deadline
+    const bool bTimedOut = TimeoutSeconds > 0.0f && Latency > TimeoutSeconds;
+    const bool bFailed = bTimedOut || FMath::FRand() < FailureRate;
+
+    int32 Code = 0;
+    FString Response;
+    if (!bFailed)
+    {
+        Code = Handler ? Handler(Url, Body, Response) : 404;
+    }
+
+    // Always answer from a later tick, like a real request
+    const float Delay = bTimedOut ? TimeoutSeconds : Latency;
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+                                             [Callback = MoveTemp(OnComplete), bFailed, Code, Response](float)
+                                             {
+                                                 Callback(!bFailed, Code, Response);
+                                                 return false; // One shot
+                                             }),
+                                         Delay);
+}
@@ -0,0 +1,75 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+// (bConnectedSuccessfully, HTTP response code, response body). Always invoked on the game thread.
+// When not connected the body may carry the failure reason.
+typedef TFunction<void(bool, int32, const FString &)> FOnBackendTransportComplete;
+
+/**
+ * Where backend requests actually go. The HTTP implementation is the default, the mock one answers in-process
+ * so the batching / retry / caching layers above can be exercised without a backend.
+ */
+class P_PROXYSERVER_API IProxyBackendTransport
+{
+public:
+    virtual ~IProxyBackendTransport() = default;
+
+    // TimeoutSeconds <= 0 means no deadline
+    virtual void Post(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete) = 0;
+
+    // Same, for a request that is safe to send more than once (a read). Transports that never resend simply Post it.
+    virtual void PostIdempotent(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete)
+    {
+        Post(Url, Body, TimeoutSeconds, MoveTemp(OnComplete));
+    }
+};
+
+typedef TSharedPtr<IProxyBackendTransport, ESPMode::ThreadSafe> FProxyBackendTransportPtr;
+
+class P_PROXYSERVER_API FProxyHttpBackendTransport : public IProxyBackendTransport
+{
+public:
+    virtual void Post(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete) override;
+};
+
+/**
+ * In-process stand-in for the backend. Handler computes the response (return value is the HTTP code),
+ * latency and connection failures can be injected per URL to simulate a slow or flaky node.
+ */
+class P_PROXYSERVER_API FProxyMockBackendTransport : public IProxyBackendTransport
+{
+public:
+    typedef TFunction<int32(const FString &Url, const FString &Body, FString &OutResponse)> FHandler;
+
+    explicit FProxyMockBackendTransport(FHandler InHandler);
+
+    // Applies to every URL containing UrlSubstring (empty = all)
+    void SetLatency(float Seconds, const FString &UrlSubstring = FString());
+    void SetFailureRate(float Probability, const FString &UrlSubstring = FString());
+
+    int32 GetNumRequests() const { return NumRequests; }
+
+    virtual void Post(const FString &Url, const FString &Body, float TimeoutSeconds, FOnBackendTransportComplete OnComplete) override;
+
+private:
+    struct FFaultRule
+    {
+        FString UrlSubstring;
+        float Latency = 0.0f;
+        float FailureRate = 0.0f;
+    };
+
+    FFaultRule &FindOrAddRule(const FString &UrlSubstring);
+
+    FHandler Handler;
+    TArray<FFaultRule> Rules;
+    int32 NumRequests = 0;
+};
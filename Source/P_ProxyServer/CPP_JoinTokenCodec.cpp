@@ -0,0 +1,617 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_JoinTokenCodec.h"
+#include "CPP_Sha256.h"
+#include "CPP_Metrics.h"
+#include "JsonObjectConverter.h"
+#include "Misc/Base64.h"
+
+namespace
+{
+    const FProxyHistogram JsonParseLatency(TEXT("proxy_join_token_json_seconds"), TEXT("op=\"parse\""), TEXT("Join token JSON codec latency"));
+    const FProxyHistogram JsonWriteLatency(TEXT("proxy_join_token_json_seconds"), TEXT("op=\"write\""), TEXT("Join token JSON codec latency"));
+
+    // Append a run of raw (unescaped) characters to an FString
+    static void append_run(FString &Out, const TCHAR *Run, int32 Length)
+    {
+        Out.AppendChars(Run, Length);
+    }
+
+    static void append_run(FString &Out, const ANSICHAR *Run, int32 Length)
+    {
+        if (Length > 0)
+        {
+            FUTF8ToTCHAR Converter(Run, Length);
+            Out.AppendChars(Converter.Get(), Converter.Length());
+        }
+    }
+
+    template <typename CharType>
+    struct TJoinTokenParser
+    {
+        const CharType *Cursor;
+        const CharType *End;
+
+        void SkipWhitespace()
+        {
+            while (Cursor < End && (*Cursor == ' ' || *Cursor == '\t' || *Cursor == '\n' || *Cursor == '\r'))
+            {
+                ++Cursor;
+            }
+        }
+
+        bool Consume(CharType Expected)
+        {
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == Expected)
+            {
+                ++Cursor;
+                return true;
+            }
+            return false;
+        }
+
+        static int32 hex_value(CharType Char)
+        {
+            if (Char >= '0' && Char <= '9')
+                return Char - '0';
+            if (Char >= 'a' && Char <= 'f')
+                return Char - 'a' + 10;
+            if (Char >= 'A' && Char <= 'F')
+                return Char - 'A' + 10;
+            return -1;
+        }
+
+        bool ParseString(FString &Out)
+        {
+            if (!Consume('"'))
+            {
+                return false;
+            }
+
+            Out.Reset();
+            const CharType *RunStart = Cursor;
+            while (Cursor < End)
+            {
+                const CharType Char = *Cursor;
+                if (Char == '"')
+                {
+                    append_run(Out, RunStart, (int32)(Cursor - RunStart));
+                    ++Cursor;
+                    return true;
+                }
+                if ((uint32)Char < 0x20)
+                {
+                    return false; // Raw control characters are not valid JSON
+                }
+                if (Char != '\\')
+                {
+                    ++Cursor;
+                    continue;
+                }
+
+                append_run(Out, RunStart, (int32)(Cursor - RunStart));
+                if (++Cursor >= End)
+                {
+                    return false;
+                }
+                switch (*Cursor++)
+                {
+                case '"':
+                    Out.AppendChar(TEXT('"'));
+                    break;
+                case '\\':
+                    Out.AppendChar(TEXT('\\'));
+                    break;
+                case '/':
+                    Out.AppendChar(TEXT('/'));
+                    break;
+                case 'b':
+                    Out.AppendChar(TEXT('\b'));
+                    break;
+                case 'f':
+                    Out.AppendChar(TEXT('\f'));
+                    break;
+                case 'n':
+                    Out.AppendChar(TEXT('\n'));
+                    break;
+                case 'r':
+                    Out.AppendChar(TEXT('\r'));
+                    break;
+                case 't':
+                    Out.AppendChar(TEXT('\t'));
+                    break;
+                case 'u':
+                {
+                    // UTF-16 code unit, surrogate pairs arrive as two escapes (same as FJsonReader)
+                    if (End - Cursor < 4)
+                    {
+                        return false;
+                    }
+                    int32 Unit = 0;
+                    for (int32 Index = 0; Index < 4; ++Index)
+                    {
+                        const int32 Nibble = hex_value(*Cursor++);
+                        if (Nibble < 0)
+                        {
+                            return false;
+                        }
+                        Unit = (Unit << 4) | Nibble;
+                    }
+                    Out.AppendChar((TCHAR)Unit);
+                    break;
+                }
+                default:
+                    return false;
+                }
+                RunStart = Cursor;
+            }
+            return false; // Unterminated
+        }
+
+        bool ParseInteger(int64 &Out)
+        {
+            SkipWhitespace();
+            const bool bNegative = Cursor < End && *Cursor == '-';
+            if (bNegative)
+            {
+                ++Cursor;
+            }
+
+            const CharType *DigitsStart = Cursor;
+            const uint64 Limit = bNegative ? uint64(MAX_int64) + 1 : uint64(MAX_int64);
+            uint64 Value = 0;
+            while (Cursor < End && *Cursor >= '0' && *Cursor <= '9')
+            {
+                const uint64 Digit = *Cursor++ - '0';
+                if (Value > (Limit - Digit) / 10)
+                {
+                    return false; // Overflow, let the reflective path decide
+                }
+                Value = Value * 10 + Digit;
+            }
+
+            // Fractions / exponents are left to the reflective path
+            if (Cursor == DigitsStart || (Cursor < End && (*Cursor == '.' || *Cursor == 'e' || *Cursor == 'E')))
+            {
+                return false;
+            }
+            Out = bNegative ? (int64)(uint64(0) - Value) : (int64)Value;
+            return true;
+        }
+
+        // Key names match case-insensitively, same as FJsonObject field lookup
+        static bool key_equals(const FString &Key, const TCHAR *Expected)
+        {
+            return Key.Equals(Expected, ESearchCase::IgnoreCase);
+        }
+
+        bool Parse(FSessionJoinToken &OutToken)
+        {
+            FSessionJoinToken Token = OutToken; // Fields missing from the JSON keep their current value
+            FString Key;
+
+            if (!Consume('{'))
+            {
+                return false;
+            }
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == '}')
+            {
+                ++Cursor;
+            }
+            else
+            {
+                do
+                {
+                    if (!ParseString(Key) || !Consume(':'))
+                    {
+                        return false;
+                    }
+
+                    if (key_equals(Key, TEXT("playerID")))
+                    {
+                        if (!ParseString(Token.playerID))
+                            return false;
+                    }
+                    else if (key_equals(Key, TEXT("timeStamp")))
+                    {
+                        if (!ParseInteger(Token.timeStamp))
+                            return false;
+                    }
+                    else if (key_equals(Key, TEXT("sessionSecret")))
+                    {
+                        if (!ParseString(Token.sessionSecret))
+                            return false;
+                    }
+                    else
+                    {
+                        return false; // Unknown field
+                    }
+                } while (Consume(','));
+
+                if (!Consume('}'))
+                {
+                    return false;
+                }
+            }
+
+            SkipWhitespace();
+            if (Cursor != End)
+            {
+                return false;
+            }
+            OutToken = MoveTemp(Token);
+            return true;
+        }
+    };
+
+    template <typename BufferType>
+    static void append_literal(BufferType &Out, const ANSICHAR *Literal)
+    {
+        while (*Literal)
+        {
+            Out.Add(*Literal++);
+        }
+    }
+
+    template <typename BufferType, typename CharType>
+    static void append_escaped(BufferType &Out, const CharType *Chars, int32 Length)
+    {
+        static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+        Out.Add('"');
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            const CharType Char = Chars[Index];
+            switch (Char)
+            {
+            case '"':
+                append_literal(Out, "\\\"");
+                break;
+            case '\\':
+                append_literal(Out, "\\\\");
+                break;
+            case '\b':
+                append_literal(Out, "\\b");
+                break;
+            case '\f':
+                append_literal(Out, "\\f");
+                break;
+            case '\n':
+                append_literal(Out, "\\n");
+                break;
+            case '\r':
+                append_literal(Out, "\\r");
+                break;
+            case '\t':
+                append_literal(Out, "\\t");
+                break;
+            default:
+                if ((uint32)Char < 0x20)
+                {
+                    append_literal(Out, "\\u00");
+                    Out.Add(HexDigits[(Char >> 4) & 0xF]);
+                    Out.Add(HexDigits[Char & 0xF]);
+                }
+                else
+                {
+                    Out.Add(Char);
+                }
+                break;
+            }
+        }
+        Out.Add('"');
+    }
+
+    template <typename BufferType>
+    static void append_integer(BufferType &Out, int64 Value)
+    {
+        ANSICHAR Digits[24];
+        int32 Count = 0;
+        uint64 Magnitude = Value < 0 ? (uint64)0 - (uint64)Value : (uint64)Value;
+        do
+        {
+            Digits[Count++] = (ANSICHAR)('0' + Magnitude % 10);
+            Magnitude /= 10;
+        } while (Magnitude);
+
+        if (Value < 0)
+        {
+            Out.Add('-');
+        }
+        while (Count > 0)
+        {
+            Out.Add(Digits[--Count]);
+        }
+    }
+
+    // Both string fields go through StringEmitter, which knows how to encode an FString for the buffer
+    template <typename BufferType, typename StringEmitter>
+    static void write_token(BufferType &Out, const FSessionJoinToken &Token, StringEmitter &&EmitString)
+    {
+        append_literal(Out, "{\"playerID\":");
+        EmitString(Token.playerID);
+        append_literal(Out, ",\"timeStamp\":");
+        append_integer(Out, Token.timeStamp);
+        append_literal(Out, ",\"sessionSecret\":");
+        EmitString(Token.sessionSecret);
+        Out.Add('}');
+    }
+} // anonymous namespace
+
+bool FJoinTokenJsonCodec::Parse(const TCHAR *Json, int32 Length, FSessionJoinToken &OutToken)
+{
+    FProxyScopedLatency Latency(JsonParseLatency);
+    TJoinTokenParser<TCHAR> Parser{Json, Json + Length};
+    return Json && Parser.Parse(OutToken);
+}
+
+bool FJoinTokenJsonCodec::ParseUtf8(const ANSICHAR *Json, int32 Length, FSessionJoinToken &OutToken)
+{
+    FProxyScopedLatency Latency(JsonParseLatency);
+    TJoinTokenParser<ANSICHAR> Parser{Json, Json + Length};
+    return Json && Parser.Parse(OutToken);
+}
+
+void FJoinTokenJsonCodec::Write(const FSessionJoinToken &Token, FString &OutJson)
+{
+    FProxyScopedLatency Latency(JsonWriteLatency);
+
+    // Escaping happens in TCHAR space, the result is the same text WriteUtf8 produces
+    TArray<TCHAR, TInlineAllocator<256>> Buffer;
+    write_token(Buffer, Token, [&Buffer](const FString &Value)
+                { append_escaped(Buffer, *Value, Value.Len()); });
+    OutJson = FString(Buffer.Num(), Buffer.GetData());
+}
+
+void FJoinTokenJsonCodec::WriteUtf8(const FSessionJoinToken &Token, FUtf8Buffer &OutJson)
+{
+    FProxyScopedLatency Latency(JsonWriteLatency);
+    OutJson.Reset();
+    write_token(OutJson, Token, [&OutJson](const FString &Value)
+                {
+                    // Bytes >= 0x80 never need escaping, so escaping the UTF-8 bytes directly is exact
+                    FTCHARToUTF8 Converter(*Value, Value.Len());
+                    append_escaped(OutJson, Converter.Get(), Converter.Length()); });
+}
+
+namespace
+{
+    class FBinaryWriter
+    {
+    public:
+        explicit FBinaryWriter(TArray<uint8> &InBytes) : Bytes(InBytes) {}
+
+        void WriteUInt(uint64 Value, int32 Width)
+        {
+            for (int32 Shift = (Width - 1) * 8; Shift >= 0; Shift -= 8)
+            {
+                Bytes.Add((uint8)(Value >> Shift));
+            }
+        }
+
+        bool WriteBytes(const uint8 *Data, int32 Length, int32 LengthWidth)
+        {
+            if (LengthWidth < 4 && (uint64)Length >= (uint64(1) << (LengthWidth * 8)))
+            {
+                return false; // Does not fit the length prefix
+            }
+            WriteUInt((uint64)Length, LengthWidth);
+            Bytes.Append(Data, Length);
+            return true;
+        }
+
+        bool WriteString(const FString &Value)
+        {
+            FTCHARToUTF8 Converter(*Value, Value.Len());
+            return WriteBytes((const uint8 *)Converter.Get(), Converter.Length(), 2);
+        }
+
+    private:
+        TArray<uint8> &Bytes;
+    };
+
+    class FBinaryReader
+    {
+    public:
+        FBinaryReader(const uint8 *InData, int32 InLength) : Data(InData), Remaining(InLength) {}
+
+        bool ReadUInt(uint64 &OutValue, int32 Width)
+        {
+            if (Remaining < Width)
+            {
+                return false;
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < Width; ++Index)
+            {
+                OutValue = (OutValue << 8) | *Data++;
+            }
+            Remaining -= Width;
+            return true;
+        }
+
+        // Points into the input, nothing is copied
+        bool ReadBytes(const uint8 *&OutBytes, int32 &OutLength, int32 LengthWidth)
+        {
+            uint64 Length = 0;
+            if (!ReadUInt(Length, LengthWidth) || Length > (uint64)Remaining)
+            {
+                return false;
+            }
+            OutBytes = Data;
+            OutLength = (int32)Length;
+            Data += Length;
+            Remaining -= (int32)Length;
+            return true;
+        }
+
+        bool ReadString(FString &OutValue)
+        {
+            const uint8 *Bytes = nullptr;
+            int32 Length = 0;
+            if (!ReadBytes(Bytes, Length, 2))
+            {
+                return false;
+            }
+            OutValue.Reset();
+            append_run(OutValue, (const ANSICHAR *)Bytes, Length);
+            return true;
+        }
+
+        bool ReadHeader(FJoinTokenBinaryCodec::EKind Kind)
+        {
+            uint64 MagicByte = 0, VersionByte = 0, KindByte = 0;
+            return ReadUInt(MagicByte, 1) && MagicByte == FJoinTokenBinaryCodec::Magic &&
+                   ReadUInt(VersionByte, 1) && VersionByte == FJoinTokenBinaryCodec::Version &&
+                   ReadUInt(KindByte, 1) && KindByte == (uint64)Kind;
+        }
+
+        bool AtEnd() const { return Remaining == 0; }
+
+    private:
+        const uint8 *Data;
+        int32 Remaining;
+    };
+
+    static void write_header(FBinaryWriter &Writer, FJoinTokenBinaryCodec::EKind Kind)
+    {
+        Writer.WriteUInt(FJoinTokenBinaryCodec::Magic, 1);
+        Writer.WriteUInt(FJoinTokenBinaryCodec::Version, 1);
+        Writer.WriteUInt((uint8)Kind, 1);
+    }
+} // anonymous namespace
+
+bool FJoinTokenBinaryCodec::EncodeToken(const FSessionJoinToken &Token, TArray<uint8> &OutBytes)
+{
+    OutBytes.Reset();
+    FBinaryWriter Writer(OutBytes);
+    write_header(Writer, EKind::Token);
+    Writer.WriteUInt((uint64)Token.timeStamp, 8);
+    if (!Writer.WriteString(Token.playerID) || !Writer.WriteString(Token.sessionSecret))
+    {
+        OutBytes.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool FJoinTokenBinaryCodec::DecodeToken(const uint8 *Data, int32 Length, FSessionJoinToken &OutToken)
+{
+    FBinaryReader Reader(Data, Length);
+    FSessionJoinToken Token;
+    uint64 TimeStamp = 0;
+    if (!Data || !Reader.ReadHeader(EKind::Token) || !Reader.ReadUInt(TimeStamp, 8) ||
+        !Reader.ReadString(Token.playerID) || !Reader.ReadString(Token.sessionSecret) || !Reader.AtEnd())
+    {
+        return false;
+    }
+    Token.timeStamp = (int64)TimeStamp;
+    OutToken = MoveTemp(Token);
+    return true;
+}
+
+bool FJoinTokenBinaryCodec::EncodeEncrypted(const FSessionJoinTokenEncrypted &Token, TArray<uint8> &OutBytes)
+{
+    OutBytes.Reset();
+
+    uint8 Signature[FSha256Context::DigestSize];
+    const bool bHasSignature = !Token.signature.IsEmpty();
+    if (bHasSignature && !FSha256Context::HexToDigest(Token.signature, Signature))
+    {
+        return false;
+    }
+
+    TArray<uint8> Ciphertext;
+    if (!Token.sessionJoinTokenEncryptedBASE64.IsEmpty() && !FBase64::Decode(Token.sessionJoinTokenEncryptedBASE64, Ciphertext))
+    {
+        return false;
+    }
+
+    FBinaryWriter Writer(OutBytes);
+    write_header(Writer, EKind::EncryptedToken);
+    if (!Writer.WriteString(Token.playerID) ||
+        !Writer.WriteBytes(Signature, bHasSignature ? FSha256Context::DigestSize : 0, 1) ||
+        !Writer.WriteBytes(Ciphertext.GetData(), Ciphertext.Num(), 4))
+    {
+        OutBytes.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool FJoinTokenBinaryCodec::DecodeEncrypted(const uint8 *Data, int32 Length, FSessionJoinTokenEncrypted &OutToken, TArray<uint8> *OutCiphertext)
+{
+    FBinaryReader Reader(Data, Length);
+    FSessionJoinTokenEncrypted Token;
+    const uint8 *Signature = nullptr;
+    int32 SignatureLength = 0;
+    const uint8 *Ciphertext = nullptr;
+    int32 CiphertextLength = 0;
+    if (!Data || !Reader.ReadHeader(EKind::EncryptedToken) || !Reader.ReadString(Token.playerID) ||
+        !Reader.ReadBytes(Signature, SignatureLength, 1) || !Reader.ReadBytes(Ciphertext, CiphertextLength, 4) || !Reader.AtEnd())
+    {
+        return false;
+    }
+    if (SignatureLength != 0 && SignatureLength != FSha256Context::DigestSize)
+    {
+        return false;
+    }
+
+    if (SignatureLength > 0)
+    {
+        Token.signature = FSha256Context::DigestToHex(Signature);
+    }
+    if (CiphertextLength > 0)
+    {
+        Token.sessionJoinTokenEncryptedBASE64 = FBase64::Encode(Ciphertext, CiphertextLength);
+    }
+    if (OutCiphertext)
+    {
+        OutCiphertext->Reset();
+        OutCiphertext->Append(Ciphertext, CiphertextLength);
+    }
+    OutToken = MoveTemp(Token);
+    return true;
+}
+
+bool FJoinTokenBinaryCodec::DecodeTokenAny(const uint8 *Data, int32 Length, FSessionJoinToken &OutToken)
+{
+    if (!Data || Length <= 0)
+    {
+        return false;
+    }
+    if (IsBinary(Data, Length))
+    {
+        return DecodeToken(Data, Length, OutToken);
+    }
+    if (FJoinTokenJsonCodec::ParseUtf8((const ANSICHAR *)Data, Length, OutToken))
+    {
+        return true;
+    }
+
+    const FUTF8ToTCHAR Converter((const ANSICHAR *)Data, Length);
+    const FString Json(Converter.Length(), Converter.Get());
+    return FJsonObjectConverter::JsonObjectStringToUStruct<FSessionJoinToken>(Json, &OutToken, 0, 0);
+}
+
+bool FJoinTokenBinaryCodec::DecodeEncryptedAny(const uint8 *Data, int32 Length, FSessionJoinTokenEncrypted &OutToken)
+{
+    if (!Data || Length <= 0)
+    {
+        return false;
+    }
+    if (IsBinary(Data, Length))
+    {
+        return DecodeEncrypted(Data, Length, OutToken);
+    }
+
+    const FUTF8ToTCHAR Converter((const ANSICHAR *)Data, Length);
+    const FString Json(Converter.Length(), Converter.Get());
+    return FJsonObjectConverter::JsonObjectStringToUStruct<FSessionJoinTokenEncrypted>(Json, &OutToken, 0, 0);
+}
@@ -0,0 +1,70 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPP_STRUCT__ProxyServer.h"
+
+/**
+ * Direct JSON codec for FSessionJoinToken, no FJsonObject DOM and no reflection.
+ *
+ * Output is canonical: {"playerID":"...","timeStamp":123,"sessionSecret":"..."} in that order, no whitespace,
+ * minimal escaping (", \ and control characters). Join token signatures (HMAC-SHA256) are computed over exactly this.
+ *
+ * Parse only takes the fast path for input it fully understands (the three known keys, string / integer values).
+ * Anything else, such as unknown fields, a quoted timestamp or malformed input, returns false so the caller can
+ * fall back to FJsonObjectConverter, which keeps the reflective semantics for those cases.
+ */
+struct P_PROXYSERVER_API FJoinTokenJsonCodec
+{
+    // Inline capacity that fits typical tokens, so encoding does not touch the heap
+    typedef TArray<ANSICHAR, TInlineAllocator<256>> FUtf8Buffer;
+
+    static bool Parse(const TCHAR *Json, int32 Length, FSessionJoinToken &OutToken);
+    static bool ParseUtf8(const ANSICHAR *Json, int32 Length, FSessionJoinToken &OutToken);
+
+    static void Write(const FSessionJoinToken &Token, FString &OutJson);
+    static void WriteUtf8(const FSessionJoinToken &Token, FUtf8Buffer &OutJson);
+};
+
+/**
+ * Compact binary encoding of the join token structs, an alternative to JSON (+ Base64) on the wire.
+ * All integers big endian, strings UTF-8 with a length prefix:
+ *
+ *   Header         : [1] Magic (0xA7) | [1] Version (1) | [1] Kind
+ *   Token          : [8] timeStamp | [2] + playerID | [2] + sessionSecret
+ *   Encrypted Token: [2] + playerID | [1] + raw signature (32 bytes, or 0 when unsigned) | [4] + raw ciphertext
+ *
+ * The magic byte can never start JSON text or Base64, so DecodeTokenAny / DecodeEncryptedAny tell the formats apart
+ * by the first byte and backends can migrate one message type at a time.
+ */
+struct P_PROXYSERVER_API FJoinTokenBinaryCodec
+{
+    static constexpr uint8 Magic = 0xA7;
+    static constexpr uint8 Version = 1;
+
+    enum class EKind : uint8
+    {
+        Token = 1,
+        EncryptedToken = 2
+    };
+
+    static bool IsBinary(const uint8 *Data, int32 Length) { return Length >= 3 && Data[0] == Magic; }
+
+    static bool EncodeToken(const FSessionJoinToken &Token, TArray<uint8> &OutBytes);
+    static bool DecodeToken(const uint8 *Data, int32 Length, FSessionJoinToken &OutToken);
+
+    // Signature must be hex (as produced by SignSessionJoinToken) or empty, the ciphertext Base64 (or empty)
+    static bool EncodeEncrypted(const FSessionJoinTokenEncrypted &Token, TArray<uint8> &OutBytes);
+
+    // OutCiphertext (optional) receives the raw ciphertext, so callers can decrypt without a Base64 round trip
+    static bool DecodeEncrypted(const uint8 *Data, int32 Length, FSessionJoinTokenEncrypted &OutToken, TArray<uint8> *OutCiphertext = nullptr);
+
+    // Format detection: binary, else UTF-8 JSON (canonical fast path, then the reflective converter)
+    static bool DecodeTokenAny(const uint8 *Data, int32 Length, FSessionJoinToken &OutToken);
+    static bool DecodeEncryptedAny(const uint8 *Data, int32 Length, FSessionJoinTokenEncrypted &OutToken);
+};
@@ -5,24 +5,231 @@
  */
 
 #include "CPP_LoginManagerSubsystem.h"
+#include "CPP_BPL__ProxyServer.h"
+#include "CPP_JoinTokenCodec.h"
+#include "CPP_Metrics.h"
+#include "CPP_Sha256.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameSession.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
 #include "OnlineSubsystemTypes.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/Paths.h"
+#include "Misc/Base64.h"
 #include "Misc/FileHelper.h"
+#include "Misc/DateTime.h"
+#include "Misc/Guid.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 
-#include "HttpModule.h"
-#include "Interfaces/IHttpRequest.h"
-#include "Interfaces/IHttpResponse.h"
+namespace
+{
+    // Backend answers worth caching as negative: {"found": false} or {"banned": true}
+    bool is_negative_backend_response(const FString &Response)
+    {
+        TSharedPtr<FJsonObject> Object;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+        if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+        {
+            return false;
+        }
+
+        bool bFlag = false;
+        return (Object->TryGetBoolField(TEXT("found"), bFlag) && !bFlag) || (Object->TryGetBoolField(TEXT("banned"), bFlag) && bFlag);
+    }
+
+    // Ties a backend confirmation to the join token it was issued for, without sending the session secret:
+    // hex SHA-256 of the UTF-8 "<timeStamp>:<sessionSecret>", easy for the backend to recompute
+    FString join_token_digest(const FSessionJoinToken &Token)
+    {
+        FSha256Context Context;
+        Context.UpdateString(FString::Printf(TEXT("%lld:%s"), Token.timeStamp, *Token.sessionSecret));
+
+        uint8 Digest[FSha256Context::DigestSize];
+        Context.Final(Digest);
+        return FSha256Context::DigestToHex(Digest);
+    }
+
+    const FProxyHistogram ValidatePlayerLoginLatency(TEXT("proxy_validate_player_login_seconds"), TEXT(""), TEXT("ValidatePlayerLogin (policy checks) latency"));
+    const FProxyCounter LoginsAdmitted(TEXT("proxy_login_admission_total"), TEXT("result=\"admitted\""), TEXT("Login admission decisions"));
+    const FProxyCounter LoginsShedPerAddress(TEXT("proxy_login_admission_total"), TEXT("result=\"shed_address\""), TEXT("Login admission decisions"));
+    const FProxyCounter LoginsShedGlobal(TEXT("proxy_login_admission_total"), TEXT("result=\"shed_global\""), TEXT("Login admission decisions"));
+
+    // One per ValidatePlayerLoginAsync stage
+    const FProxyHistogram PolicyStageLatency(TEXT("proxy_login_stage_seconds"), TEXT("stage=\"policy\""), TEXT("Latency of each login validation stage"));
+    const FProxyHistogram DecryptStageLatency(TEXT("proxy_login_stage_seconds"), TEXT("stage=\"decrypt\""), TEXT("Latency of each login validation stage"));
+    const FProxyHistogram SignatureStageLatency(TEXT("proxy_login_stage_seconds"), TEXT("stage=\"signature\""), TEXT("Latency of each login validation stage"));
+    const FProxyHistogram BackendStageLatency(TEXT("proxy_login_stage_seconds"), TEXT("stage=\"backend\""), TEXT("Latency of each login validation stage"));
+    const FProxyHistogram EngineStageLatency(TEXT("proxy_login_stage_seconds"), TEXT("stage=\"engine\""), TEXT("Latency of each login validation stage"));
+    const FProxyHistogram ReplayStageLatency(TEXT("proxy_login_stage_seconds"), TEXT("stage=\"replay\""), TEXT("Latency of each login validation stage"));
+
+    // Whatever ValidatePlayerLoginAsync learns about one login, shared by its stages
+    struct FLoginAttempt
+    {
+        FString Options;
+        FString Address;
+        FUniqueNetIdRepl UniqueId;
+        FString PlayerId;
+        FString EncryptedToken; // ?JoinToken=
+        FString Signature;      // ?JoinTokenSignature=, falls back to the one stored with the session
+        bool bUseGlobalKey = false;
+        bool bHasToken = false;
+        FSessionJoinToken Token;
+    };
+    typedef TSharedRef<FLoginAttempt, ESPMode::ThreadSafe> FLoginAttemptRef;
+
+    // Does not stop at the first difference, so the comparison time says nothing about the secret
+    bool secrets_equal(const FString &A, const FString &B)
+    {
+        if (A.Len() != B.Len())
+        {
+            return false;
+        }
+        uint32 Diff = 0;
+        for (int32 Index = 0; Index < A.Len(); ++Index)
+        {
+            Diff |= (uint32)A[Index] ^ (uint32)B[Index];
+        }
+        return Diff == 0;
+    }
+
+    // Checks shared by the sync and async login paths, safe off the game thread. Returns the rejection message, empty = valid.
+    // HMAC over the canonical token JSON, not past ExpiresAt (0 = never), and the token must be the one the backend issued
+    // for this session. Without a session the token is only accepted when bRequireSession is false.
+    FString check_join_token(const FSessionJoinToken &Token, const FString &PlayerId, const FString &Signature, const FHmacSha256Key &Key, const FProxySessionEntryPtr &Session,
+                             int64 ExpiresAt, bool bRequireSession)
+    {
+        if (!PlayerId.IsEmpty() && !Token.playerID.Equals(PlayerId, ESearchCase::IgnoreCase))
+        {
+            return TEXT("Your join token belongs to another player.");
+        }
+
+        uint8 Expected[FSha256Context::DigestSize];
+        if (!Key.bIsSet || !FSha256Context::HexToDigest(Signature, Expected))
+        {
+            return TEXT("Your join token signature is invalid.");
+        }
+
+        FJoinTokenJsonCodec::FUtf8Buffer TokenJson;
+        FJoinTokenJsonCodec::WriteUtf8(Token, TokenJson);
+        uint8 Actual[FSha256Context::DigestSize];
+        Key.Sign((const uint8 *)TokenJson.GetData(), TokenJson.Num(), Actual);
+        if (!FSha256Context::DigestEquals(Expected, Actual))
+        {
+            return TEXT("Your join token signature is invalid.");
+        }
+
+        // The presented token's own timestamp, the session's copy may have been reissued or already swept
+        if (ExpiresAt != 0 && FDateTime::UtcNow().ToUnixTimestamp() >= ExpiresAt)
+        {
+            return TEXT("Your join token has expired.");
+        }
+
+        if (!Session.IsValid() && bRequireSession)
+        {
+            return TEXT("There is no session for you on this server.");
+        }
+
+        const FSessionJoinToken *Issued = Session.IsValid() ? &Session->sessionJoinTokenFromServer : nullptr;
+        if (Issued && !Issued->sessionSecret.IsEmpty() && (Issued->timeStamp != Token.timeStamp || !secrets_equal(Issued->sessionSecret, Token.sessionSecret)))
+        {
+            return TEXT("Your join token does not match this session.");
+        }
+        return FString();
+    }
+} // anonymous namespace
 
 bool UCPP_LoginManagerSubsystem::ShouldCreateSubsystem(UObject *Outer) const
 {
-    // ShouldCreateSubsystem is const; call the non-const implementation via const_cast
-    const_cast<UCPP_LoginManagerSubsystem *>(this)->InitializeLoginHandler_Implementation();
     return true;
 }
 
+void UCPP_LoginManagerSubsystem::Initialize(FSubsystemCollectionBase &Collection)
+{
+    Super::Initialize(Collection);
+
+    // Punal Manalan, NOTE: Initialized on the created instance (ShouldCreateSubsystem runs on the CDO).
+    // Nothing in here blocks on RSA key generation, the Local Key arrives from FProxyRsaKeyPool.
+    ApplyRoleLists(AllowedRole_List, RestrictedRole_List, RequiredRole_List);
+    InitializeLoginHandler_Implementation();
+
+    // Consumed Join Tokens are remembered for as long as they could still be accepted, unless configured otherwise
+    const int32 ReplayWindowSeconds = ReplayCache_WindowSeconds > 0 ? ReplayCache_WindowSeconds : JoinSessionToken_Expiry_Seconds;
+    if (ReplayWindowSeconds <= 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Join Tokens never expire and ReplayCache_WindowSeconds is not set, Join Token replay protection is OFF"));
+    }
+    else
+    {
+        if (JoinSessionToken_Expiry_Seconds <= 0 || ReplayWindowSeconds < JoinSessionToken_Expiry_Seconds)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Join Tokens outlive the %d second replay window, a consumed token can be replayed after it"), ReplayWindowSeconds);
+        }
+        ReplayCache = MakeUnique<FProxyReplayCache>(ReplayWindowSeconds, ReplayCache_ExpectedTokensPerWindow, ReplayCache_ExactCapacity);
+    }
+
+    AdmissionController = MakeUnique<FProxyAdmissionController>(Admission_PerAddressRatePerSecond, Admission_PerAddressBurst, Admission_MaxConcurrentValidations, Admission_TableSize);
+
+    if (BackendCache_MaxEntries > 0)
+    {
+        BackendCache = MakeUnique<FProxyBackendCache>(BackendCache_MaxEntries);
+    }
+
+    // Incremental session / role / ban events from the backend
+    StartBackendPushChannel();
+
+    if (SessionSync_IntervalSeconds > 0.0f)
+    {
+        SessionSyncTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCPP_LoginManagerSubsystem::TickBackendSessionSync), SessionSync_IntervalSeconds);
+    }
+
+    // Expired Join Tokens are swept once a second
+    RescheduleAllSessionExpiry();
+    SessionExpiryTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCPP_LoginManagerSubsystem::TickSessionExpiry), 1.0f);
+}
+
+void UCPP_LoginManagerSubsystem::Deinitialize()
+{
+    // Waits for in-flight decryptions, their game thread callbacks are guarded by weak pointers
+    AsyncDecryptor.Reset();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(SessionExpiryTickerHandle);
+    SessionExpiryTickerHandle.Reset();
+    FTSTicker::GetCoreTicker().RemoveTicker(SessionSyncTickerHandle);
+    SessionSyncTickerHandle.Reset();
+
+    if (BackendPushChannel.IsValid())
+    {
+        BackendPushChannel->Stop();
+        BackendPushChannel.Reset();
+    }
+
+    // Logins still validating are rejected now rather than by their stage timeouts
+    for (const TWeakPtr<FProxyLoginPipeline, ESPMode::ThreadSafe> &WeakPipeline : ActiveLoginPipelines)
+    {
+        if (TSharedPtr<FProxyLoginPipeline, ESPMode::ThreadSafe> Pipeline = WeakPipeline.Pin())
+        {
+            Pipeline->Cancel(TEXT("Server is shutting down."));
+        }
+    }
+    ActiveLoginPipelines.Reset();
+
+    // Send out anything still queued, responses are delivered through the callers' own delegates
+    if (BackendBatcher.IsValid())
+    {
+        BackendBatcher->Flush();
+        BackendBatcher.Reset();
+    }
+
+    Super::Deinitialize();
+}
+
 void UCPP_LoginManagerSubsystem::GenerateNewRSAKeyPair(int32 KeySizeInBits, bool bIsGlobalKey)
 {
     if (bIsGlobalKey)
@@ -33,6 +240,64 @@ void UCPP_LoginManagerSubsystem::GenerateNewRSAKeyPair(int32 KeySizeInBits, bool
     {
         UCPP_BPL__ProxyServer::GenerateRsaKeyPair(KeySizeInBits, Server_Local_PublicKeyPEM, Server_Local_PrivateKeyPEM);
     }
+
+    RefreshServerKeys();
+}
+
+void UCPP_LoginManagerSubsystem::RefreshServerKeys()
+{
+    // Parse outside the lock, then swap everything in at once
+    FRsaKeyPtr GlobalPrivate = FRsaKey::FindOrLoadPrivateKey(Server_Global_PrivateKeyPEM);
+    FRsaKeyPtr GlobalPublic = FRsaKey::FindOrLoadPublicKey(Server_Global_PublicKeyPEM);
+    FRsaKeyPtr LocalPrivate = FRsaKey::FindOrLoadPrivateKey(Server_Local_PrivateKeyPEM);
+    FRsaKeyPtr LocalPublic = FRsaKey::FindOrLoadPublicKey(Server_Local_PublicKeyPEM);
+
+    // Punal Manalan, NOTE: By default both Global filenames point at the same Private Key PEM, a Private Key can do Public Key operations too.
+    if (!GlobalPublic.IsValid())
+    {
+        GlobalPublic = GlobalPrivate;
+    }
+    if (!LocalPublic.IsValid())
+    {
+        LocalPublic = LocalPrivate;
+    }
+
+    FHmacSha256Key GlobalHmac;
+    if (!Server_Global_PrivateKeyPEM.IsEmpty())
+    {
+        GlobalHmac.SetKey(Server_Global_PrivateKeyPEM);
+    }
+    FHmacSha256Key LocalHmac;
+    if (!Server_Local_PrivateKeyPEM.IsEmpty())
+    {
+        LocalHmac.SetKey(Server_Local_PrivateKeyPEM);
+    }
+
+    FWriteScopeLock WriteLock(ServerKeyLock);
+    Server_Global_PrivateKey = MoveTemp(GlobalPrivate);
+    Server_Global_PublicKey = MoveTemp(GlobalPublic);
+    Server_Local_PrivateKey = MoveTemp(LocalPrivate);
+    Server_Local_PublicKey = MoveTemp(LocalPublic);
+    Server_Global_HmacKey = GlobalHmac;
+    Server_Local_HmacKey = LocalHmac;
+}
+
+FRsaKeyPtr UCPP_LoginManagerSubsystem::GetServerPrivateKey(bool bUseGlobalKey) const
+{
+    FReadScopeLock ReadLock(ServerKeyLock);
+    return bUseGlobalKey ? Server_Global_PrivateKey : Server_Local_PrivateKey;
+}
+
+FRsaKeyPtr UCPP_LoginManagerSubsystem::GetServerPublicKey(bool bUseGlobalKey) const
+{
+    FReadScopeLock ReadLock(ServerKeyLock);
+    return bUseGlobalKey ? Server_Global_PublicKey : Server_Local_PublicKey;
+}
+
+FHmacSha256Key UCPP_LoginManagerSubsystem::GetServerHmacKey(bool bUseGlobalKey) const
+{
+    FReadScopeLock ReadLock(ServerKeyLock);
+    return bUseGlobalKey ? Server_Global_HmacKey : Server_Local_HmacKey;
 }
 
 bool UCPP_LoginManagerSubsystem::InitializeLoginHandler_Implementation()
@@ -55,16 +320,94 @@ bool UCPP_LoginManagerSubsystem::InitializeLoginHandler_Implementation()
         }
     }
 
+    RefreshServerKeys();
+
     if (EnableLocalEncryptionValidation)
     {
-        // Generate a new Local Key Pair at Runtime
-        // Note: GenerateNewRSAKeyPair is a void function that populates member vars.
-        GenerateNewRSAKeyPair(2048, false);
+        // Local Key Pair comes from the background pool, logins wait on IsLocalKeyReady()
+        AcquireLocalKeyPair();
     }
 
     return true;
 }
 
+void UCPP_LoginManagerSubsystem::AcquireLocalKeyPair()
+{
+    FProxyRsaKeyPool &Pool = FProxyRsaKeyPool::Get();
+    FString PersistDirectory;
+    if (LocalKeyPool_PersistPrivateKeys && !LocalKeyPool_PersistDirectory.IsEmpty())
+    {
+        PersistDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), LocalKeyPool_PersistDirectory);
+    }
+    else if (!LocalKeyPool_PersistDirectory.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LocalKeyPool_PersistDirectory is set but LocalKeyPool_PersistPrivateKeys is not, pre-generated keys stay in memory"));
+    }
+    Pool.Configure(LocalKey_SizeInBits, LocalKeyPool_Size, PersistDirectory);
+
+    FRsaKeyPairPEM Pair;
+    if (Pool.TryTake(Pair))
+    {
+        InstallLocalKeyPair(Pair);
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("No pre-generated Local Key Pair ready, waiting for background generation"));
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakThis(this);
+    Pool.TakeAsync([WeakThis](const FRsaKeyPairPEM &GeneratedPair)
+                   {
+                       if (WeakThis.IsValid())
+                       {
+                           WeakThis->InstallLocalKeyPair(GeneratedPair);
+                       } });
+}
+
+void UCPP_LoginManagerSubsystem::InstallLocalKeyPair(const FRsaKeyPairPEM &Pair)
+{
+    check(IsInGameThread());
+
+    if (!Pair.IsValid())
+    {
+        // Logins keep using the current Local Key, or are refused until RotateLocalKeyPair succeeds
+        UE_LOG(LogTemp, Error, TEXT("Local Key Pair generation failed, %s"), bIsLocalKeyReady ? TEXT("keeping the current key") : TEXT("local encryption logins are refused"));
+        return;
+    }
+
+    Server_Local_PublicKeyPEM = Pair.PublicKeyPEM;
+    Server_Local_PrivateKeyPEM = Pair.PrivateKeyPEM;
+    RefreshServerKeys();
+
+    bIsLocalKeyReady = true;
+    TArray<TFunction<void()>> Waiters = MoveTemp(LocalKeyReadyWaiters);
+    LocalKeyReadyWaiters.Reset();
+    for (TFunction<void()> &Waiter : Waiters)
+    {
+        Waiter();
+    }
+}
+
+void UCPP_LoginManagerSubsystem::WhenLocalKeyReady(TFunction<void()> Callback)
+{
+    check(IsInGameThread());
+    if (bIsLocalKeyReady || !EnableLocalEncryptionValidation)
+    {
+        Callback();
+        return;
+    }
+    LocalKeyReadyWaiters.Add(MoveTemp(Callback));
+}
+
+bool UCPP_LoginManagerSubsystem::IsLocalKeyReady() const
+{
+    return bIsLocalKeyReady;
+}
+
+void UCPP_LoginManagerSubsystem::RotateLocalKeyPair()
+{
+    // The current Local Key stays in use until the replacement is installed
+    AcquireLocalKeyPair();
+}
+
 bool UCPP_LoginManagerSubsystem::LoadGlobalKeyFromFile_Implementation(const FString &RelativePath, FString &OutKeyContent)
 {
     // 1. Get the Plugin pointer
@@ -96,173 +439,1216 @@ bool UCPP_LoginManagerSubsystem::LoadGlobalKeyFromFile_Implementation(const FStr
 bool UCPP_LoginManagerSubsystem::SendAPIRequestToBackendServer_Implementation(const FString &Send_Payload, const FOnSentAPIResponse &ResponseDelegate)
 {
     // Punal Manalan, NOTE: For the Most Part ResponseDelegate will be HandleAPIResponseFromBackendServer Function
-    FHttpModule *Http = &FHttpModule::Get();
-    if (!Http)
+    SendBackendRequest_Cpp(Send_Payload, [Send_Payload, ResponseDelegate](const FString &ResponseContent, const FString &ErrorMessage)
+                           {
+                               /* Punal Manalan, NOTE: No need to Handle the response internally, as the Delegate will do that
+                                * as the Passed Delegate would normally be the HandleAPIResponseFromBackendServer Function
+                                */
+                               ResponseDelegate.ExecuteIfBound(Send_Payload, ResponseContent, ErrorMessage); });
+    return true;
+}
+
+void UCPP_LoginManagerSubsystem::SendBackendRequest_Cpp(const FString &Payload, FProxyBackendBatcher::FOnResponse OnResponse, const FString &DedupKey, bool bIdempotent)
+{
+    // Identical concurrent reads (join retries, several systems asking about one player) share one POST.
+    // Punal Manalan, NOTE: Anything else is only coalesced under a key the caller chose, two writes with the same
+    // payload (e.g. "grant item") are two separate requests.
+    const FString Key = !DedupKey.IsEmpty() ? DedupKey : (bIdempotent ? Payload : FString());
+    if (!BackendDedup_Enabled || Key.IsEmpty())
     {
-        return false;
+        DispatchBackendRequest(Payload, MoveTemp(OnResponse), bIdempotent);
+        return;
     }
 
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
+    if (!BackendSingleFlight->Join(Key, MoveTemp(OnResponse)))
+    {
+        return;
+    }
 
-    Request->SetURL(Backend_Server_URL);
-    Request->SetVerb(TEXT("POST"));
-    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-    Request->SetContentAsString(Send_Payload);
+    TSharedRef<FProxySingleFlight, ESPMode::ThreadSafe> Flight = BackendSingleFlight;
+    DispatchBackendRequest(Payload, [Flight, Key](const FString &Response, const FString &Error)
+                           { Flight->Complete(Key, Response, Error); }, bIdempotent);
+}
 
-    Request->OnProcessRequestComplete().BindLambda(
-        [this, Send_Payload, ResponseDelegate](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+void UCPP_LoginManagerSubsystem::DispatchBackendRequest(const FString &Payload, FProxyBackendBatcher::FOnResponse OnResponse, bool bIdempotent)
+{
+    if (BackendBatch_WindowSeconds > 0.0f)
+    {
+        if (!BackendBatcher.IsValid())
         {
-            if (bConnectedSuccessfully && Response.IsValid())
-            {
-                FString ResponseContent = Response->GetContentAsString();
-
-                /* Punal Manalan, NOTE: No need to Handle the response internally, as the Delegate will do that
-                 * as the Passed Delegate would normally be the HandleAPIResponseFromBackendServer Function
-                 */
-                // HandleAPIResponseFromBackendServer_Implementation(Send_Payload, ResponseContent, TEXT(""));
-
-                // Notify the delegate
-                ResponseDelegate.ExecuteIfBound(Send_Payload, ResponseContent, TEXT(""));
-            }
-            else
-            {
-                FString ErrorMessage = TEXT("Connection failed");
-                if (Response.IsValid())
-                {
-                    ErrorMessage = FString::Printf(TEXT("Request failed with code: %d"), Response->GetResponseCode());
-                }
-                ResponseDelegate.ExecuteIfBound(Send_Payload, TEXT(""), ErrorMessage);
-            }
-        });
+            const FString BatchUrl = BackendBatch_URL.IsEmpty() ? Backend_Server_URL : BackendBatch_URL;
+            BackendBatcher = MakeShared<FProxyBackendBatcher, ESPMode::ThreadSafe>(GetBackendClient(), BatchUrl, BackendBatch_WindowSeconds, BackendBatch_MaxSize);
+        }
+        BackendBatcher->Enqueue(Payload, MoveTemp(OnResponse), bIdempotent);
+        return;
+    }
 
-    Request->ProcessRequest();
-    return true;
+    // Only a 2xx answer is a success, same as in a batch. A non-2xx body still reaches the caller next to the error.
+    GetBackendClient()->Send(Backend_Server_URL, Payload, bIdempotent, [Callback = MoveTemp(OnResponse)](bool bConnected, int32 Code, const FString &Body)
+                             {
+                                 const FString Error = FProxyBackendBatcher::DescribeFailure(bConnected, Code, Body);
+                                 Callback(bConnected ? Body : FString(), Error); });
 }
 
-bool UCPP_LoginManagerSubsystem::HandleAPIResponseFromBackendServer_Implementation(const FString &Sent_Payload, const FString &Response_Payload, FString &Error)
+void UCPP_LoginManagerSubsystem::SendPlayerBackendRequest_Cpp(const FString &PlayerId, const FString &Payload, FProxyBackendBatcher::FOnResponse OnResponse, bool bIdempotent)
 {
-    // TODO: parse response and update internal state as required.
-    return true;
-}
+    if (!BackendCache.IsValid() || PlayerId.IsEmpty())
+    {
+        SendBackendRequest_Cpp(Payload, MoveTemp(OnResponse), FString(), bIdempotent);
+        return;
+    }
 
-bool UCPP_LoginManagerSubsystem::HandleAPIFromBackendServer_Implementation(const FString &Received_Payload)
-{
-    // TODO: handle push/API events from backend
-    return true;
-}
-bool UCPP_LoginManagerSubsystem::IsServerLocked() const
-{
-    return bIsServerLocked;
-}
+    FString CachedResponse;
+    bool bNegative = false;
+    if (BackendCache->Find(PlayerId, Payload, CachedResponse, bNegative))
+    {
+        OnResponse(CachedResponse, FString());
+        return;
+    }
 
-void UCPP_LoginManagerSubsystem::SetServerLocked(bool bLocked)
-{
-    bIsServerLocked = bLocked;
+    // Only answers are cached, failures go back to the backend next time. An answer that was in flight when the
+    // player got invalidated is passed on but not cached.
+    const uint64 Generation = BackendCache->GetGeneration(PlayerId);
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakThis(this);
+    SendBackendRequest_Cpp(Payload, [WeakThis, PlayerId, Payload, Generation, Callback = MoveTemp(OnResponse)](const FString &Response, const FString &Error)
+                           {
+                               UCPP_LoginManagerSubsystem *This = WeakThis.Get();
+                               if (This && This->BackendCache.IsValid() && Error.IsEmpty())
+                               {
+                                   const bool bIsNegative = is_negative_backend_response(Response);
+                                   This->BackendCache->Put(PlayerId, Payload, Response, bIsNegative, bIsNegative ? This->BackendCache_NegativeTTLSeconds : This->BackendCache_TTLSeconds, Generation);
+                               }
+                               Callback(Response, Error); }, FString(), bIdempotent);
 }
 
-FString UCPP_LoginManagerSubsystem::GetBackendServerURL() const
+bool UCPP_LoginManagerSubsystem::SendPlayerAPIRequestToBackendServer(const FString &PlayerId, const FString &Send_Payload, const FOnSentAPIResponse &ResponseDelegate, bool bIdempotent)
 {
-    return Backend_Server_URL;
+    SendPlayerBackendRequest_Cpp(PlayerId, Send_Payload, [Send_Payload, ResponseDelegate](const FString &ResponseContent, const FString &ErrorMessage)
+                                 { ResponseDelegate.ExecuteIfBound(Send_Payload, ResponseContent, ErrorMessage); }, bIdempotent);
+    return true;
 }
 
-void UCPP_LoginManagerSubsystem::SetBackendServerURL(const FString &URL)
+bool UCPP_LoginManagerSubsystem::SendDedupedAPIRequestToBackendServer(const FString &Send_Payload, const FString &DedupKey, const FOnSentAPIResponse &ResponseDelegate, bool bIdempotent)
 {
-    Backend_Server_URL = URL;
+    SendBackendRequest_Cpp(Send_Payload, [Send_Payload, ResponseDelegate](const FString &ResponseContent, const FString &ErrorMessage)
+                           { ResponseDelegate.ExecuteIfBound(Send_Payload, ResponseContent, ErrorMessage); }, DedupKey, bIdempotent);
+    return true;
 }
 
-TArray<FString> UCPP_LoginManagerSubsystem::GetAllowedRoleList() const
+bool UCPP_LoginManagerSubsystem::InvalidateBackendCacheForPlayer(const FString &PlayerId)
 {
-    return AllowedRole_List;
+    return BackendCache.IsValid() && BackendCache->Invalidate(PlayerId);
 }
 
-void UCPP_LoginManagerSubsystem::SetAllowedRoleList(const TArray<FString> &NewList)
+void UCPP_LoginManagerSubsystem::InvalidateBackendCache()
 {
-    AllowedRole_List = NewList;
+    if (BackendCache.IsValid())
+    {
+        BackendCache->InvalidateAll();
+    }
 }
 
-TArray<FString> UCPP_LoginManagerSubsystem::GetBannedRoleList() const
+int64 UCPP_LoginManagerSubsystem::GetNumCoalescedBackendRequests() const
 {
-    return RestrictedRole_List;
+    return (int64)BackendSingleFlight->GetNumCoalesced();
 }
 
-void UCPP_LoginManagerSubsystem::SetBannedRoleList(const TArray<FString> &NewList)
+FBackendCacheStats UCPP_LoginManagerSubsystem::GetBackendCacheStats() const
 {
-    RestrictedRole_List = NewList;
+    FBackendCacheStats Result;
+    if (BackendCache.IsValid())
+    {
+        const FProxyBackendCacheStats Stats = BackendCache->GetStats();
+        Result.Hits = (int64)Stats.Hits;
+        Result.NegativeHits = (int64)Stats.NegativeHits;
+        Result.Misses = (int64)Stats.Misses;
+        Result.Evictions = (int64)Stats.Evictions;
+        Result.Invalidations = (int64)Stats.Invalidations;
+        Result.StalePuts = (int64)Stats.StalePuts;
+        Result.Num = Stats.Num;
+    }
+    return Result;
 }
 
-TMap<FString, FPlayerData> UCPP_LoginManagerSubsystem::GetPlayerID_SessionData_Map() const
+TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> UCPP_LoginManagerSubsystem::GetBackendClient()
 {
-    return PlayerID_SessionData_Map;
-}
+    if (!BackendClient.IsValid())
+    {
+        if (!BackendTransport.IsValid())
+        {
+            BackendTransport = MakeShared<FProxyHttpBackendTransport, ESPMode::ThreadSafe>();
+        }
 
-void UCPP_LoginManagerSubsystem::SetPlayerID_SessionData_Map(const TMap<FString, FPlayerData> &NewMap)
-{
-    PlayerID_SessionData_Map = NewMap;
+        FProxyBackendClientSettings Settings;
+        Settings.AttemptTimeoutSeconds = Backend_TimeoutSeconds;
+        Settings.DeadlineSeconds = Backend_DeadlineSeconds;
+        Settings.MaxRetries = Backend_MaxRetries;
+        Settings.RetryBaseDelaySeconds = Backend_RetryBaseDelaySeconds;
+        Settings.HedgeUrl = Backend_HedgeURL;
+        Settings.CircuitFailureThreshold = Backend_CircuitFailureThreshold;
+        Settings.CircuitOpenSeconds = Backend_CircuitOpenSeconds;
+        BackendClient = MakeShared<FProxyBackendClient, ESPMode::ThreadSafe>(BackendTransport, Settings);
+    }
+    return BackendClient.ToSharedRef();
 }
 
-FString UCPP_LoginManagerSubsystem::GetServer_Global_PrivateKeyPEM() const
+void UCPP_LoginManagerSubsystem::SetBackendTransport(FProxyBackendTransportPtr InTransport)
 {
-    return Server_Global_PrivateKeyPEM;
+    if (BackendBatcher.IsValid())
+    {
+        BackendBatcher->Flush();
+        BackendBatcher.Reset();
+    }
+    BackendClient.Reset();
+    BackendTransport = MoveTemp(InTransport);
 }
 
-void UCPP_LoginManagerSubsystem::SetServer_Global_PrivateKeyPEM(const FString &NewPrivateKeyPEM)
+bool UCPP_LoginManagerSubsystem::HandleAPIResponseFromBackendServer_Implementation(const FString &Sent_Payload, const FString &Response_Payload, FString &Error)
 {
-    Server_Global_PrivateKeyPEM = NewPrivateKeyPEM;
+    // TODO: parse response and update internal state as required.
+    return true;
 }
 
-FString UCPP_LoginManagerSubsystem::GetServer_Global_PublicKeyPEM() const
+bool UCPP_LoginManagerSubsystem::HandleAPIFromBackendServer_Implementation(const FString &Received_Payload)
 {
-    return Server_Global_PublicKeyPEM;
-}
+    // Same events as the push channel, sequenced ones go through its ordering and dedup (an event that also
+    // arrived over the push connection is applied once, one that is ahead waits for the gap to fill)
+    TArray<FProxyPushEvent> Events;
+    if (!FProxyPushEvent::ParseFrame(Received_Payload, Events))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("HandleAPIFromBackendServer: Ignoring a payload that is not JSON"));
+        return false;
+    }
 
-void UCPP_LoginManagerSubsystem::SetServer_Global_PublicKeyPEM(const FString &NewPublicKeyPEM)
-{
-    Server_Global_PublicKeyPEM = NewPublicKeyPEM;
+    if (BackendPushChannel.IsValid())
+    {
+        BackendPushChannel->Submit(MoveTemp(Events));
+    }
+    else
+    {
+        ApplyBackendPushEvents(Events);
+    }
+    return true;
 }
 
-bool UCPP_LoginManagerSubsystem::ValidatePlayerLogin_Implementation(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, FString &OutErrorMessage)
+void UCPP_LoginManagerSubsystem::ApplyBackendPushEvents(const TArray<FProxyPushEvent> &Events)
 {
-    // Check if server is "locked"
-    if (bIsServerLocked)
+    for (const FProxyPushEvent &Event : Events)
     {
-        OutErrorMessage = TEXT("Server is currently locked by the Admin.");
-        return false; // REJECT
-    }
+        // Punal Manalan, NOTE: Whatever the backend pushes about a player makes our cached answer for that player stale
+        if (BackendCache.IsValid())
+        {
+            if (!Event.PlayerId.IsEmpty())
+            {
+                BackendCache->Invalidate(Event.PlayerId);
+            }
+            for (const FString &PlayerId : Event.PlayerIds)
+            {
+                BackendCache->Invalidate(PlayerId);
+            }
+        }
 
-    // Check if the player is assigned a role that is Valid or Banned
-    bool HasValidRole = false;
-    bool HasRestrictedRole = false;
-    const FString PlayerId = UniqueId.ToString();
-    for (const TPair<FString, FPlayerData> &Pair : PlayerID_SessionData_Map)
-    {
-        const FString &MappedId = Pair.Key;
-        if (MappedId == PlayerId)
+        switch (Event.Type)
+        {
+        case EProxyPushEventType::SessionUpsert:
+            if (!Event.PlayerId.IsEmpty())
+            {
+                UpsertPlayerSessionData(Event.PlayerId, Event.Data);
+            }
+            break;
+
+        case EProxyPushEventType::SessionRemove:
+            RemovePlayerSessionData(Event.PlayerId);
+            break;
+
+        case EProxyPushEventType::RolesChanged:
         {
-            for (const FString &Role : Pair.Value.roles)
+            const FProxySessionEntryPtr Entry = PlayerID_SessionData_Map.Find(Event.PlayerId);
+            if (Entry.IsValid())
             {
-                if (RestrictedRole_List.Contains(Role))
-                {
-                    OutErrorMessage = TEXT("You are restricted from this server.");
-                    // HasRestrictedRole = true;
-                    return false; // REJECT
-                }
-                if (!HasValidRole)
-                {
-                    if (AllowedRole_List.Contains(Role))
-                    {
-                        HasValidRole = true; // found a valid role
-                    }
-                }
+                FPlayerData Data = *Entry;
+                Data.roles = Event.Roles;
+                UpsertPlayerSessionData(Event.PlayerId, Data);
             }
-            break; // found mapping, stop searching
+            break;
         }
-    }
 
-    // If no valid role found, reject
-    if (!HasValidRole)
-    {
-        OutErrorMessage = TEXT("This server is not configured to accept the Specific roles of the Player.");
+        case EProxyPushEventType::Banned:
+            RemovePlayerSessionData(Event.PlayerId);
+            KickPlayerById(Event.PlayerId, Event.Reason.IsEmpty() ? FString(TEXT("Banned")) : Event.Reason);
+            break;
+
+        case EProxyPushEventType::InvalidateAll:
+            if (BackendCache.IsValid())
+            {
+                BackendCache->InvalidateAll();
+            }
+            break;
+
+        case EProxyPushEventType::ResyncRequired:
+            UE_LOG(LogTemp, Warning, TEXT("BackendPush: Backend asked for a resync (seq %lld), pulling a full session snapshot"), Event.Seq);
+            if (BackendCache.IsValid())
+            {
+                BackendCache->InvalidateAll();
+            }
+            RequestBackendSessionSync(true);
+            break;
+
+        case EProxyPushEventType::Malformed:
+            UE_LOG(LogTemp, Warning, TEXT("BackendPush: Event seq %lld was unreadable, pulling a full session snapshot"), Event.Seq);
+            if (BackendCache.IsValid())
+            {
+                BackendCache->InvalidateAll();
+            }
+            RequestBackendSessionSync(true);
+            break;
+
+        case EProxyPushEventType::Invalidate:
+        default:
+            break;
+        }
+    }
+}
+
+void UCPP_LoginManagerSubsystem::KickPlayerById(const FString &PlayerId, const FString &Reason)
+{
+    UWorld *World = GetWorld();
+    AGameModeBase *GameMode = World ? World->GetAuthGameMode() : nullptr;
+    if (!GameMode || !GameMode->GameSession || PlayerId.IsEmpty())
+    {
+        return;
+    }
+
+    const FProxySessionKey Key(PlayerId);
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController *PlayerController = It->Get();
+        if (PlayerController && PlayerController->PlayerState && FProxySessionKey::FromNetId(PlayerController->PlayerState->GetUniqueId()) == Key)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Kicking %s: %s"), *PlayerId, *Reason);
+            GameMode->GameSession->KickPlayer(PlayerController, FText::FromString(Reason));
+        }
+    }
+}
+
+void UCPP_LoginManagerSubsystem::StartBackendPushChannel()
+{
+    int64 ResumeFromSeq = 0;
+    if (BackendPushChannel.IsValid())
+    {
+        ResumeFromSeq = BackendPushChannel->GetLastAppliedSeq();
+        BackendPushChannel->Stop();
+        BackendPushChannel.Reset();
+    }
+
+    // Without a push URL the channel is never started, it still orders events that arrive through HandleAPIFromBackendServer
+    FProxyPushConnectionFactory Factory = BackendPushConnectionFactory;
+    if (!Factory && !BackendPush_URL.IsEmpty())
+    {
+        const FString Url = BackendPush_URL;
+        Factory = [Url]() -> FProxyPushConnectionPtr
+        {
+            return MakeShared<FProxyWebSocketPushConnection, ESPMode::ThreadSafe>(Url);
+        };
+    }
+    const bool bHasConnection = (bool)Factory;
+
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakThis(this);
+    BackendPushChannel = MakeShared<FProxyBackendPushChannel, ESPMode::ThreadSafe>(MoveTemp(Factory), [WeakThis](const TArray<FProxyPushEvent> &Events)
+                                                                                   {
+                                                                                       if (UCPP_LoginManagerSubsystem *This = WeakThis.Get())
+                                                                                       {
+                                                                                           This->ApplyBackendPushEvents(Events);
+                                                                                       } },
+                                                                                   ResumeFromSeq);
+    if (bHasConnection)
+    {
+        BackendPushChannel->Start(ResumeFromSeq);
+    }
+}
+
+void UCPP_LoginManagerSubsystem::SetBackendPushConnectionFactory(FProxyPushConnectionFactory InFactory)
+{
+    BackendPushConnectionFactory = MoveTemp(InFactory);
+    StartBackendPushChannel();
+}
+
+bool UCPP_LoginManagerSubsystem::IsBackendPushConnected() const
+{
+    return BackendPushChannel.IsValid() && BackendPushChannel->IsConnected();
+}
+
+int64 UCPP_LoginManagerSubsystem::GetBackendPushLastSeq() const
+{
+    return BackendPushChannel.IsValid() ? BackendPushChannel->GetLastAppliedSeq() : 0;
+}
+
+bool UCPP_LoginManagerSubsystem::IsServerLocked() const
+{
+    return bIsServerLocked;
+}
+
+void UCPP_LoginManagerSubsystem::SetServerLocked(bool bLocked)
+{
+    bIsServerLocked = bLocked;
+}
+
+FString UCPP_LoginManagerSubsystem::GetBackendServerURL() const
+{
+    return Backend_Server_URL;
+}
+
+void UCPP_LoginManagerSubsystem::SetBackendServerURL(const FString &URL)
+{
+    Backend_Server_URL = URL;
+
+    // Queued batches still go to the old URL, new ones to the new URL
+    if (BackendBatcher.IsValid())
+    {
+        BackendBatcher->Flush();
+        BackendBatcher.Reset();
+    }
+}
+
+TArray<FString> UCPP_LoginManagerSubsystem::GetAllowedRoleList() const
+{
+    return AllowedRole_List;
+}
+
+void UCPP_LoginManagerSubsystem::SetAllowedRoleList(const TArray<FString> &NewList)
+{
+    ApplyRoleLists(NewList, RestrictedRole_List, RequiredRole_List);
+}
+
+TArray<FString> UCPP_LoginManagerSubsystem::GetBannedRoleList() const
+{
+    return RestrictedRole_List;
+}
+
+void UCPP_LoginManagerSubsystem::SetBannedRoleList(const TArray<FString> &NewList)
+{
+    ApplyRoleLists(AllowedRole_List, NewList, RequiredRole_List);
+}
+
+TArray<FString> UCPP_LoginManagerSubsystem::GetRequiredRoleList() const
+{
+    return RequiredRole_List;
+}
+
+void UCPP_LoginManagerSubsystem::SetRequiredRoleList(const TArray<FString> &NewList)
+{
+    ApplyRoleLists(AllowedRole_List, RestrictedRole_List, NewList);
+}
+
+bool UCPP_LoginManagerSubsystem::ApplyRoleLists(const TArray<FString> &Allowed, const TArray<FString> &Restricted, const TArray<FString> &Required)
+{
+    // Compile outside the lock, readers only ever see a complete policy
+    FString Error;
+    FProxyRolePolicyPtr NewPolicy = FProxyRolePolicy::Compile(Allowed, Restricted, Required, Error);
+    if (!NewPolicy.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Role lists not updated: %s"), *Error);
+        return false;
+    }
+
+    // Copy first, the arguments may alias the lists being replaced
+    TArray<FString> NewAllowed = Allowed;
+    TArray<FString> NewRestricted = Restricted;
+    TArray<FString> NewRequired = Required;
+
+    FWriteScopeLock WriteLock(RolePolicyLock);
+    AllowedRole_List = MoveTemp(NewAllowed);
+    RestrictedRole_List = MoveTemp(NewRestricted);
+    RequiredRole_List = MoveTemp(NewRequired);
+    RolePolicy = MoveTemp(NewPolicy);
+    return true;
+}
+
+FProxyRolePolicyPtr UCPP_LoginManagerSubsystem::GetRolePolicy() const
+{
+    FReadScopeLock ReadLock(RolePolicyLock);
+    return RolePolicy;
+}
+
+TMap<FString, FPlayerData> UCPP_LoginManagerSubsystem::GetPlayerID_SessionData_Map() const
+{
+    return PlayerID_SessionData_Map.ToMap();
+}
+
+void UCPP_LoginManagerSubsystem::SetPlayerID_SessionData_Map(const TMap<FString, FPlayerData> &NewMap)
+{
+    // Punal Manalan, NOTE: Applied as a diff, unchanged reservations keep their entries and are not reported as changes
+    if (PlayerID_SessionData_Map.SyncTo(NewMap) > 0)
+    {
+        RescheduleAllSessionExpiry();
+    }
+}
+
+void UCPP_LoginManagerSubsystem::RequestBackendSessionSync(bool bFullSnapshot)
+{
+    if (bIsSessionSyncInFlight)
+    {
+        bIsFullSessionSyncPending |= bFullSnapshot;
+        return;
+    }
+    bIsSessionSyncInFlight = true;
+
+    const int64 SinceVersion = bFullSnapshot ? 0 : BackendSessionVersion;
+    const FString Payload = FString::Printf(TEXT("{\"type\":\"sessionSync\",\"sinceVersion\":%lld,\"maxChanges\":%d}"), SinceVersion, SessionSync_MaxDeltaChanges);
+
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakThis(this);
+    SendBackendRequest_Cpp(Payload, [WeakThis](const FString &Response, const FString &Error)
+                           {
+                               if (!WeakThis.IsValid())
+                               {
+                                   return;
+                               }
+                               if (!Error.IsEmpty())
+                               {
+                                   UE_LOG(LogTemp, Warning, TEXT("SessionSync: Request failed: %s"), *Error);
+                                   WeakThis->FinishBackendSessionSync();
+                                   return;
+                               }
+
+                               // Thousands of reservations take a while to parse, keep that off the game thread
+                               Async(EAsyncExecution::ThreadPool, [WeakThis, Response]()
+                                     {
+                                         TSharedRef<FProxySessionSyncPayload, ESPMode::ThreadSafe> Sync = MakeShared<FProxySessionSyncPayload, ESPMode::ThreadSafe>();
+                                         const bool bParsed = FProxySessionSyncPayload::Parse(Response, *Sync);
+                                         AsyncTask(ENamedThreads::GameThread, [WeakThis, Sync, bParsed]()
+                                                   {
+                                                       if (UCPP_LoginManagerSubsystem *This = WeakThis.Get())
+                                                       {
+                                                           if (!bParsed)
+                                                           {
+                                                               UE_LOG(LogTemp, Warning, TEXT("SessionSync: Malformed response from the backend"));
+                                                           }
+                                                           else
+                                                           {
+                                                               // Checked against where we are now, a pushed sync may have moved us on meanwhile
+                                                               This->ApplySessionSync(*Sync);
+                                                           }
+                                                           This->FinishBackendSessionSync();
+                                                       } }); }); }, FString(), true);
+}
+
+bool UCPP_LoginManagerSubsystem::ApplyBackendSessionSync(const FString &SyncPayload)
+{
+    FProxySessionSyncPayload Sync;
+    if (!FProxySessionSyncPayload::Parse(SyncPayload, Sync))
+    {
+        return false;
+    }
+    const bool bApplied = ApplySessionSync(Sync);
+    if (!bIsSessionSyncInFlight && bIsFullSessionSyncPending)
+    {
+        FinishBackendSessionSync();
+    }
+    return bApplied;
+}
+
+bool UCPP_LoginManagerSubsystem::ApplySessionSync(const FProxySessionSyncPayload &Sync)
+{
+    const EProxySessionSyncCheck SyncCheck = Sync.Check(BackendSessionVersion);
+    if (SyncCheck == EProxySessionSyncCheck::Stale)
+    {
+        // Punal Manalan, NOTE: A backend that started its versions over is picked up with ResetBackendSessionSync
+        UE_LOG(LogTemp, Warning, TEXT("SessionSync: Ignoring snapshot at version %lld, already at %lld"), Sync.Version, BackendSessionVersion);
+        return false;
+    }
+
+    // A delta from somewhere other than where we are (or from who knows where) cannot be applied, fall back to a full snapshot
+    if (SyncCheck == EProxySessionSyncCheck::NeedFullSnapshot)
+    {
+        if (Sync.BaseVersion < 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SessionSync: Delta to version %lld has no baseVersion, requesting a full snapshot"), Sync.Version);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Log, TEXT("SessionSync: Delta is based on version %lld but we are at %lld, requesting a full snapshot"), Sync.BaseVersion, BackendSessionVersion);
+        }
+        bIsFullSessionSyncPending = true;
+        return false;
+    }
+
+    TArray<FString> Changed;
+    if (Sync.bIsFullSnapshot)
+    {
+        TMap<FString, FPlayerData> Snapshot;
+        Snapshot.Reserve(Sync.Upserted.Num());
+        for (const TPair<FString, FPlayerData> &Pair : Sync.Upserted)
+        {
+            Snapshot.Add(Pair.Key, Pair.Value);
+        }
+        PlayerID_SessionData_Map.SyncTo(Snapshot, &Changed);
+    }
+    else
+    {
+        PlayerID_SessionData_Map.ApplyChanges(Sync.Upserted, Sync.Removed, &Changed);
+    }
+
+    for (const FString &PlayerId : Changed)
+    {
+        if (BackendCache.IsValid())
+        {
+            BackendCache->Invalidate(PlayerId);
+        }
+        if (const FProxySessionEntryPtr Entry = PlayerID_SessionData_Map.Find(PlayerId))
+        {
+            ScheduleSessionExpiry(PlayerId, *Entry);
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("SessionSync: %s to version %lld, %d entries changed"), Sync.bIsFullSnapshot ? TEXT("Snapshot") : TEXT("Delta"), Sync.Version, Changed.Num());
+    BackendSessionVersion = Sync.Version;
+    return true;
+}
+
+void UCPP_LoginManagerSubsystem::FinishBackendSessionSync()
+{
+    bIsSessionSyncInFlight = false;
+    if (bIsFullSessionSyncPending)
+    {
+        bIsFullSessionSyncPending = false;
+        RequestBackendSessionSync(true);
+    }
+}
+
+bool UCPP_LoginManagerSubsystem::TickBackendSessionSync(float DeltaTime)
+{
+    RequestBackendSessionSync(false);
+    return true;
+}
+
+int64 UCPP_LoginManagerSubsystem::GetBackendSessionVersion() const
+{
+    return BackendSessionVersion;
+}
+
+void UCPP_LoginManagerSubsystem::ResetBackendSessionSync()
+{
+    UE_LOG(LogTemp, Log, TEXT("SessionSync: Forgetting version %lld, requesting a full snapshot"), BackendSessionVersion);
+    BackendSessionVersion = 0;
+    RequestBackendSessionSync(true);
+}
+
+bool UCPP_LoginManagerSubsystem::GetPlayerSessionData(const FString &PlayerId, FPlayerData &OutData) const
+{
+    const FProxySessionEntryPtr Entry = PlayerID_SessionData_Map.Find(PlayerId);
+    if (!Entry.IsValid())
+    {
+        return false;
+    }
+    OutData = *Entry;
+    return true;
+}
+
+void UCPP_LoginManagerSubsystem::UpsertPlayerSessionData(const FString &PlayerId, const FPlayerData &Data)
+{
+    PlayerID_SessionData_Map.Upsert(PlayerId, Data);
+    ScheduleSessionExpiry(PlayerId, Data);
+}
+
+bool UCPP_LoginManagerSubsystem::ConsumeSessionJoinToken(const FSessionJoinToken &Token)
+{
+    if (!ReplayCache.IsValid())
+    {
+        return true; // Replay protection is off, logged at Initialize
+    }
+    return ReplayCache->CheckAndInsert(Token.playerID, Token.timeStamp, Token.sessionSecret, FDateTime::UtcNow().ToUnixTimestamp());
+}
+
+FReplayCacheStats UCPP_LoginManagerSubsystem::GetReplayCacheStats() const
+{
+    FReplayCacheStats Result;
+    if (ReplayCache.IsValid())
+    {
+        const FProxyReplayCacheStats Stats = ReplayCache->GetStats();
+        Result.Checks = (int64)Stats.Checks;
+        Result.Accepted = (int64)Stats.Accepted;
+        Result.ExactReplays = (int64)Stats.ExactReplays;
+        Result.FilterReplays = (int64)Stats.FilterReplays;
+        Result.EstimatedFalsePositiveRate = (float)Stats.EstimatedFalsePositiveRate;
+    }
+    return Result;
+}
+
+int64 UCPP_LoginManagerSubsystem::GetJoinTokenExpiryTime(const FPlayerData &Data) const
+{
+    return GetJoinTokenExpiryTime(Data.sessionJoinTokenFromServer);
+}
+
+int64 UCPP_LoginManagerSubsystem::GetJoinTokenExpiryTime(const FSessionJoinToken &Token) const
+{
+    int64 IssuedAt = Token.timeStamp;
+    if (IssuedAt <= 0 || JoinSessionToken_Expiry_Seconds <= 0)
+    {
+        return 0;
+    }
+
+    // Punal Manalan, NOTE: Backends send Unix seconds, but accept milliseconds too (anything past year 5000 in seconds)
+    if (IssuedAt > 100000000000LL)
+    {
+        IssuedAt /= 1000;
+    }
+    return IssuedAt + JoinSessionToken_Expiry_Seconds;
+}
+
+bool UCPP_LoginManagerSubsystem::IsJoinTokenExpired(const FPlayerData &Data, int64 NowUnixSeconds) const
+{
+    const int64 ExpiresAt = GetJoinTokenExpiryTime(Data);
+    return ExpiresAt != 0 && NowUnixSeconds >= ExpiresAt;
+}
+
+void UCPP_LoginManagerSubsystem::ScheduleSessionExpiry(const FString &PlayerId, const FPlayerData &Data)
+{
+    const int64 ExpiresAt = GetJoinTokenExpiryTime(Data);
+    if (ExpiresAt == 0)
+    {
+        return;
+    }
+
+    FScopeLock ScopeLock(&SessionExpiryLock);
+    SessionExpiryWheel.Schedule(PlayerId, ExpiresAt);
+}
+
+void UCPP_LoginManagerSubsystem::RescheduleAllSessionExpiry()
+{
+    FScopeLock ScopeLock(&SessionExpiryLock);
+    SessionExpiryWheel.Reset(FDateTime::UtcNow().ToUnixTimestamp());
+    PlayerID_SessionData_Map.ForEach([this](const FProxySessionKey &Key, const FProxySessionEntryPtr &Entry)
+                                     {
+                                         const int64 ExpiresAt = GetJoinTokenExpiryTime(*Entry);
+                                         if (ExpiresAt != 0)
+                                         {
+                                             SessionExpiryWheel.Schedule(Key.PlayerId, ExpiresAt);
+                                         } });
+}
+
+bool UCPP_LoginManagerSubsystem::TickSessionExpiry(float DeltaTime)
+{
+    const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+
+    TArray<FString> Due;
+    {
+        FScopeLock ScopeLock(&SessionExpiryLock);
+        SessionExpiryWheel.Advance(Now, Due);
+    }
+
+    int32 NumEvicted = 0;
+    for (const FString &PlayerId : Due)
+    {
+        // The wheel only hints, a refreshed token has its own (later) entry and must survive this one
+        NumEvicted += PlayerID_SessionData_Map.RemoveIf(PlayerId, [this, Now](const FPlayerData &Data)
+                                                        { return IsJoinTokenExpired(Data, Now); })
+                          ? 1
+                          : 0;
+    }
+
+    if (NumEvicted > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Evicted %d expired session reservations"), NumEvicted);
+    }
+    return true; // Keep ticking
+}
+
+bool UCPP_LoginManagerSubsystem::RemovePlayerSessionData(const FString &PlayerId)
+{
+    const FProxySessionEntryPtr Entry = PlayerID_SessionData_Map.Find(PlayerId);
+    if (!PlayerID_SessionData_Map.Remove(PlayerId))
+    {
+        return false;
+    }
+
+    // Nothing left to expire, drop the wheel entry instead of waiting for its deadline
+    const int64 ExpiresAt = Entry.IsValid() ? GetJoinTokenExpiryTime(*Entry) : 0;
+    if (ExpiresAt != 0)
+    {
+        FScopeLock ScopeLock(&SessionExpiryLock);
+        SessionExpiryWheel.Remove(PlayerId, ExpiresAt);
+    }
+    return true;
+}
+
+int32 UCPP_LoginManagerSubsystem::GetPlayerSessionCount() const
+{
+    return PlayerID_SessionData_Map.Num();
+}
+
+int64 UCPP_LoginManagerSubsystem::GetPlayerSessionVersion() const
+{
+    return (int64)PlayerID_SessionData_Map.GetVersion();
+}
+
+FPlayerSessionDelta UCPP_LoginManagerSubsystem::GetPlayerSessionChangesSince(int64 SinceVersion) const
+{
+    FPlayerSessionDelta Delta;
+
+    TArray<TPair<FString, FProxySessionEntryPtr>> Upserted;
+    uint64 Version = 0;
+    if (SinceVersion >= 0 && PlayerID_SessionData_Map.GetChangesSince((uint64)SinceVersion, Upserted, Delta.Removed, Version))
+    {
+        Delta.Upserted.Reserve(Upserted.Num());
+        for (const TPair<FString, FProxySessionEntryPtr> &Pair : Upserted)
+        {
+            Delta.Upserted.Add(Pair.Key, *Pair.Value);
+        }
+    }
+    else
+    {
+        // Too far behind for the change log, hand out the whole table
+        Version = PlayerID_SessionData_Map.GetVersion();
+        Delta.bIsFullSnapshot = true;
+        Delta.Upserted = PlayerID_SessionData_Map.ToMap();
+    }
+
+    Delta.Version = (int64)Version;
+    return Delta;
+}
+
+FString UCPP_LoginManagerSubsystem::GetServer_Global_PrivateKeyPEM() const
+{
+    return Server_Global_PrivateKeyPEM;
+}
+
+void UCPP_LoginManagerSubsystem::SetServer_Global_PrivateKeyPEM(const FString &NewPrivateKeyPEM)
+{
+    Server_Global_PrivateKeyPEM = NewPrivateKeyPEM;
+    RefreshServerKeys();
+}
+
+FString UCPP_LoginManagerSubsystem::GetServer_Global_PublicKeyPEM() const
+{
+    return Server_Global_PublicKeyPEM;
+}
+
+void UCPP_LoginManagerSubsystem::SetServer_Global_PublicKeyPEM(const FString &NewPublicKeyPEM)
+{
+    Server_Global_PublicKeyPEM = NewPublicKeyPEM;
+    RefreshServerKeys();
+}
+
+FString UCPP_LoginManagerSubsystem::EncryptWithServerPublicKey(const FString &Content, bool bUseGlobalKey) const
+{
+    FRsaKeyPtr Key = GetServerPublicKey(bUseGlobalKey);
+    return Key.IsValid() ? Key->EncryptString(Content) : FString();
+}
+
+FString UCPP_LoginManagerSubsystem::DecryptWithServerPrivateKey(const FString &EncryptedBase64, bool bUseGlobalKey) const
+{
+    FRsaKeyPtr Key = GetServerPrivateKey(bUseGlobalKey);
+    return Key.IsValid() ? Key->DecryptString(EncryptedBase64) : FString();
+}
+
+FProxyAsyncRsaDecryptor &UCPP_LoginManagerSubsystem::GetAsyncDecryptor()
+{
+    check(IsInGameThread());
+    if (!AsyncDecryptor.IsValid())
+    {
+        AsyncDecryptor = MakeUnique<FProxyAsyncRsaDecryptor>(AsyncDecrypt_WorkerCount, AsyncDecrypt_MaxPendingJobs);
+    }
+    return *AsyncDecryptor;
+}
+
+bool UCPP_LoginManagerSubsystem::DecryptWithServerPrivateKeyAsync(const FString &EncryptedBase64, bool bUseGlobalKey, const FOnAsyncDecryptComplete &OnComplete)
+{
+    return DecryptWithServerPrivateKeyAsync_Cpp(EncryptedBase64, bUseGlobalKey, [OnComplete](bool bSuccess, const FString &Decrypted)
+                                                { OnComplete.ExecuteIfBound(bSuccess, Decrypted); });
+}
+
+bool UCPP_LoginManagerSubsystem::DecryptWithServerPrivateKeyAsync_Cpp(const FString &EncryptedBase64, bool bUseGlobalKey, FProxyAsyncRsaDecryptor::FOnDecrypted OnComplete)
+{
+    FRsaKeyPtr Key = GetServerPrivateKey(bUseGlobalKey);
+    if (!Key.IsValid())
+    {
+        return false;
+    }
+
+    // Drop the result if the subsystem went away while the job was in flight
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakThis(this);
+    const bool bQueued = GetAsyncDecryptor().Enqueue(Key, EncryptedBase64, [WeakThis, Callback = MoveTemp(OnComplete)](bool bSuccess, const FString &Decrypted)
+                                                     {
+                                                         if (WeakThis.IsValid() && Callback)
+                                                         {
+                                                             Callback(bSuccess, Decrypted);
+                                                         } });
+    if (!bQueued)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Async decrypt refused: %d/%d jobs pending"), AsyncDecryptor->GetPendingJobs(), AsyncDecryptor->GetMaxPendingJobs());
+    }
+    return bQueued;
+}
+
+bool UCPP_LoginManagerSubsystem::DecryptBytesWithServerPrivateKeyAsync_Cpp(const FString &EncryptedBase64, bool bUseGlobalKey, FProxyAsyncRsaDecryptor::FOnDecryptedBytes OnComplete)
+{
+    FRsaKeyPtr Key = GetServerPrivateKey(bUseGlobalKey);
+    if (!Key.IsValid())
+    {
+        return false;
+    }
+
+    // Drop the result if the subsystem went away while the job was in flight
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakThis(this);
+    const bool bQueued = GetAsyncDecryptor().EnqueueBytes(Key, EncryptedBase64, [WeakThis, Callback = MoveTemp(OnComplete)](bool bSuccess, const TArray<uint8> &Decrypted)
+                                                          {
+                                                              if (WeakThis.IsValid() && Callback)
+                                                              {
+                                                                  Callback(bSuccess, Decrypted);
+                                                              } });
+    if (!bQueued)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Async decrypt refused: %d/%d jobs pending"), AsyncDecryptor->GetPendingJobs(), AsyncDecryptor->GetMaxPendingJobs());
+    }
+    return bQueued;
+}
+
+FString UCPP_LoginManagerSubsystem::SignSessionJoinToken(const FSessionJoinToken &Token, bool bUseGlobalKey) const
+{
+    const FHmacSha256Key Key = GetServerHmacKey(bUseGlobalKey);
+    if (!Key.bIsSet)
+    {
+        return FString();
+    }
+
+    // Sign the canonical UTF-8 JSON straight from the stack buffer
+    FJoinTokenJsonCodec::FUtf8Buffer TokenJson;
+    FJoinTokenJsonCodec::WriteUtf8(Token, TokenJson);
+
+    uint8 Signature[FSha256Context::DigestSize];
+    Key.Sign((const uint8 *)TokenJson.GetData(), TokenJson.Num(), Signature);
+    return FSha256Context::DigestToHex(Signature);
+}
+
+bool UCPP_LoginManagerSubsystem::VerifySessionJoinTokenSignature(const FSessionJoinToken &Token, const FString &Signature, bool bUseGlobalKey) const
+{
+    const FHmacSha256Key Key = GetServerHmacKey(bUseGlobalKey);
+    uint8 Expected[FSha256Context::DigestSize];
+    if (!Key.bIsSet || !FSha256Context::HexToDigest(Signature, Expected))
+    {
+        return false;
+    }
+
+    FJoinTokenJsonCodec::FUtf8Buffer TokenJson;
+    FJoinTokenJsonCodec::WriteUtf8(Token, TokenJson);
+
+    uint8 Actual[FSha256Context::DigestSize];
+    Key.Sign((const uint8 *)TokenJson.GetData(), TokenJson.Num(), Actual);
+    return FSha256Context::DigestEquals(Expected, Actual);
+}
+
+bool UCPP_LoginManagerSubsystem::TryAdmitLogin(const FString &Address, FString &OutErrorMessage)
+{
+    if (!AdmissionController.IsValid())
+    {
+        return true;
+    }
+
+    float RetryAfterSeconds = 0.0f;
+    switch (AdmissionController->TryAdmit(Address, FPlatformTime::Seconds(), RetryAfterSeconds))
+    {
+    case EProxyAdmission::ShedPerAddress:
+        LoginsShedPerAddress.Add();
+        OutErrorMessage = FString::Printf(TEXT("Too many login attempts. Please retry in %d seconds."), FMath::Max(1, FMath::CeilToInt(RetryAfterSeconds)));
+        return false; // REJECT
+    case EProxyAdmission::ShedGlobal:
+        LoginsShedGlobal.Add();
+        OutErrorMessage = FString::Printf(TEXT("Server is busy. Please retry in %d seconds."), FMath::Max(1, FMath::CeilToInt(RetryAfterSeconds)));
+        return false; // REJECT
+    default:
+        LoginsAdmitted.Add();
+        return true;
+    }
+}
+
+void UCPP_LoginManagerSubsystem::ReleaseLogin()
+{
+    if (AdmissionController.IsValid())
+    {
+        AdmissionController->Release();
+    }
+}
+
+FAdmissionStats UCPP_LoginManagerSubsystem::GetAdmissionStats() const
+{
+    FAdmissionStats Result;
+    if (AdmissionController.IsValid())
+    {
+        const FProxyAdmissionStats Stats = AdmissionController->GetStats();
+        Result.Admitted = (int64)Stats.Admitted;
+        Result.ShedPerAddress = (int64)Stats.ShedPerAddress;
+        Result.ShedGlobal = (int64)Stats.ShedGlobal;
+        Result.InFlight = Stats.InFlight;
+    }
+    return Result;
+}
+
+void UCPP_LoginManagerSubsystem::ValidatePlayerLoginAsync(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, FProxyLoginPipeline::FOnComplete OnComplete,
+                                                          FProxyLoginPipeline::FStage EngineChecks)
+{
+    check(IsInGameThread());
+
+    FLoginAttemptRef Attempt = MakeShared<FLoginAttempt, ESPMode::ThreadSafe>();
+    Attempt->Options = Options;
+    Attempt->Address = Address;
+    Attempt->UniqueId = UniqueId;
+    Attempt->PlayerId = UniqueId.IsValid() ? UniqueId.ToString() : FString();
+    Attempt->EncryptedToken = UGameplayStatics::ParseOption(Options, TEXT("JoinToken"));
+    Attempt->Signature = UGameplayStatics::ParseOption(Options, TEXT("JoinTokenSignature"));
+    Attempt->bUseGlobalKey = !EnableLocalEncryptionValidation;
+
+    TSharedRef<FProxyLoginPipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FProxyLoginPipeline, ESPMode::ThreadSafe>(Address);
+    const float Timeout = LoginPipeline_StageTimeoutSeconds;
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakThis(this);
+
+    // Lock, key readiness, roles and token expiry. Cheap, and a Blueprint override has to run on the game thread anyway
+    Pipeline->AddStage(TEXT("Policy"), Timeout, [WeakThis, Attempt](FProxyLoginPipeline::FOnStageDone Done)
+                       {
+                           UCPP_LoginManagerSubsystem *This = WeakThis.Get();
+                           if (!This)
+                           {
+                               Done(TEXT("Server is shutting down."));
+                               return;
+                           }
+
+                           FString Error;
+                           if (!ICPP_LoginHandler::Execute_ValidatePlayerLogin(This, Attempt->Options, Attempt->Address, Attempt->UniqueId, Error))
+                           {
+                               Done(Error.IsEmpty() ? FString(TEXT("Login rejected.")) : Error);
+                               return;
+                           }
+                           Done(FString()); }, PolicyStageLatency.Id);
+
+    // RSA private key decryption on the decryptor's worker pool
+    Pipeline->AddStage(TEXT("Decrypt"), Timeout, [WeakThis, Attempt](FProxyLoginPipeline::FOnStageDone Done)
+                       {
+                           UCPP_LoginManagerSubsystem *This = WeakThis.Get();
+                           if (!This)
+                           {
+                               Done(TEXT("Server is shutting down."));
+                               return;
+                           }
+                           if (Attempt->EncryptedToken.IsEmpty())
+                           {
+                               Done(This->LoginPipeline_RequireJoinToken ? FString(TEXT("A join token is required to join this server.")) : FString());
+                               return;
+                           }
+                           if (!This->GetServerPrivateKey(Attempt->bUseGlobalKey).IsValid())
+                           {
+                               Done(TEXT("Server is still starting up. Please retry in a moment."));
+                               return;
+                           }
+
+                           // Binary or JSON plaintext, JSON the codec does not fully understand goes through the reflective converter
+                           const bool bQueued = This->DecryptBytesWithServerPrivateKeyAsync_Cpp(Attempt->EncryptedToken, Attempt->bUseGlobalKey, [Attempt, Done](bool bSuccess, const TArray<uint8> &Decrypted)
+                                                                                               {
+                                                                                                   if (!bSuccess || !FJoinTokenBinaryCodec::DecodeTokenAny(Decrypted.GetData(), Decrypted.Num(), Attempt->Token))
+                                                                                                   {
+                                                                                                       Done(TEXT("Your join token could not be read."));
+                                                                                                       return;
+                                                                                                   }
+                                                                                                   Attempt->bHasToken = true;
+                                                                                                   Done(FString()); });
+                           if (!bQueued)
+                           {
+                               Done(TEXT("Server is busy. Please retry in a moment."));
+                           } }, DecryptStageLatency.Id);
+
+    // HMAC over the canonical token JSON, and the token must be the one the backend issued for this session
+    Pipeline->AddStage(TEXT("Signature"), Timeout, [WeakThis, Attempt](FProxyLoginPipeline::FOnStageDone Done)
+                       {
+                           UCPP_LoginManagerSubsystem *This = WeakThis.Get();
+                           if (!This)
+                           {
+                               Done(TEXT("Server is shutting down."));
+                               return;
+                           }
+                           if (!Attempt->bHasToken)
+                           {
+                               Done(FString());
+                               return;
+                           }
+
+                           const FHmacSha256Key Key = This->GetServerHmacKey(Attempt->bUseGlobalKey);
+                           const FProxySessionEntryPtr Session = This->PlayerID_SessionData_Map.Find(FProxySessionKey::FromNetId(Attempt->UniqueId));
+                           FString Signature = Attempt->Signature;
+                           if (Signature.IsEmpty() && Session.IsValid())
+                           {
+                               Signature = Session->sessionJoinTokenEncryptedFromPlayer.signature;
+                           }
+
+                           const int64 ExpiresAt = This->GetJoinTokenExpiryTime(Attempt->Token);
+                           const bool bRequireSession = This->LoginPipeline_RequireJoinToken;
+                           Async(EAsyncExecution::ThreadPool, [Attempt, Key, Session, Signature, ExpiresAt, bRequireSession, Done]()
+                                 { Done(check_join_token(Attempt->Token, Attempt->PlayerId, Signature, Key, Session, ExpiresAt, bRequireSession)); }); }, SignatureStageLatency.Id);
+
+    // After every local check, so the backend only hears about logins that passed them
+    Pipeline->AddStage(TEXT("Backend"), Timeout, [WeakThis, Attempt](FProxyLoginPipeline::FOnStageDone Done)
+                       {
+                           UCPP_LoginManagerSubsystem *This = WeakThis.Get();
+                           if (!This)
+                           {
+                               Done(TEXT("Server is shutting down."));
+                               return;
+                           }
+                           if (!This->LoginPipeline_BackendConfirm || Attempt->PlayerId.IsEmpty())
+                           {
+                               Done(FString());
+                               return;
+                           }
+
+                           FString Payload;
+                           TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Payload);
+                           Writer->WriteObjectStart();
+                           Writer->WriteValue(TEXT("type"), FString(TEXT("confirmLogin")));
+                           Writer->WriteValue(TEXT("playerId"), Attempt->PlayerId);
+                           Writer->WriteValue(TEXT("nonce"), FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens));
+                           if (Attempt->bHasToken)
+                           {
+                               Writer->WriteValue(TEXT("tokenDigest"), join_token_digest(Attempt->Token));
+                           }
+                           Writer->WriteObjectEnd();
+                           Writer->Close();
+
+                           // Punal Manalan, NOTE: A confirmation is about this login attempt: never answered from the backend cache,
+                           // never shared with another attempt and sent once (the nonce keeps two attempts' payloads apart too)
+                           This->SendBackendRequest_Cpp(Payload, [Done](const FString &Response, const FString &Error)
+                                                        {
+                                                            if (!Error.IsEmpty())
+                                                            {
+                                                                Done(TEXT("Login service is unavailable. Please retry in a moment."));
+                                                                return;
+                                                            }
+                                                            Done(is_negative_backend_response(Response) ? FString(TEXT("Your login was not confirmed by the backend.")) : FString()); }, FString(), false); }, BackendStageLatency.Id);
+
+    if (EngineChecks)
+    {
+        Pipeline->AddStage(TEXT("Engine"), Timeout, MoveTemp(EngineChecks), EngineStageLatency.Id);
+    }
+
+    // Punal Manalan, NOTE: Consumed last, a login refused by any other check (backend and engine included) may retry with the same token
+    Pipeline->AddStage(TEXT("Replay"), Timeout, [WeakThis, Attempt](FProxyLoginPipeline::FOnStageDone Done)
+                       {
+                           UCPP_LoginManagerSubsystem *This = WeakThis.Get();
+                           if (!This)
+                           {
+                               Done(TEXT("Server is shutting down."));
+                               return;
+                           }
+                           if (!Attempt->bHasToken || This->ConsumeSessionJoinToken(Attempt->Token))
+                           {
+                               Done(FString());
+                               return;
+                           }
+                           Done(TEXT("This join token has already been used.")); }, ReplayStageLatency.Id);
+
+    ActiveLoginPipelines.RemoveAll([](const TWeakPtr<FProxyLoginPipeline, ESPMode::ThreadSafe> &WeakPipeline)
+                                   {
+                                       TSharedPtr<FProxyLoginPipeline, ESPMode::ThreadSafe> Active = WeakPipeline.Pin();
+                                       return !Active.IsValid() || Active->IsFinished(); });
+    ActiveLoginPipelines.Add(Pipeline);
+    Pipeline->Run(MoveTemp(OnComplete));
+}
+
+bool UCPP_LoginManagerSubsystem::ValidatePresentedJoinToken(const FString &Options, const FUniqueNetIdRepl &UniqueId, FSessionJoinToken &OutToken, bool &bOutHasToken, FString &OutErrorMessage)
+{
+    bOutHasToken = false;
+    const FString EncryptedToken = UGameplayStatics::ParseOption(Options, TEXT("JoinToken"));
+    if (EncryptedToken.IsEmpty())
+    {
+        if (LoginPipeline_RequireJoinToken)
+        {
+            OutErrorMessage = TEXT("A join token is required to join this server.");
+            return false; // REJECT
+        }
+        return true;
+    }
+
+    const bool bUseGlobalKey = !EnableLocalEncryptionValidation;
+    const FRsaKeyPtr PrivateKey = GetServerPrivateKey(bUseGlobalKey);
+    if (!PrivateKey.IsValid())
+    {
+        OutErrorMessage = TEXT("Server is still starting up. Please retry in a moment.");
+        return false; // REJECT
+    }
+
+    // Binary or JSON plaintext, same as the async Decrypt stage
+    TArray<uint8> Encrypted;
+    TArray<uint8> Decrypted;
+    if (!FBase64::Decode(EncryptedToken, Encrypted) || !PrivateKey->DecryptOaep(Encrypted.GetData(), Encrypted.Num(), Decrypted) ||
+        !FJoinTokenBinaryCodec::DecodeTokenAny(Decrypted.GetData(), Decrypted.Num(), OutToken))
+    {
+        OutErrorMessage = TEXT("Your join token could not be read.");
+        return false; // REJECT
+    }
+
+    const FProxySessionEntryPtr Session = PlayerID_SessionData_Map.Find(FProxySessionKey::FromNetId(UniqueId));
+    FString Signature = UGameplayStatics::ParseOption(Options, TEXT("JoinTokenSignature"));
+    if (Signature.IsEmpty() && Session.IsValid())
+    {
+        Signature = Session->sessionJoinTokenEncryptedFromPlayer.signature;
+    }
+
+    OutErrorMessage = check_join_token(OutToken, UniqueId.IsValid() ? UniqueId.ToString() : FString(), Signature, GetServerHmacKey(bUseGlobalKey), Session,
+                                       GetJoinTokenExpiryTime(OutToken), LoginPipeline_RequireJoinToken);
+    if (!OutErrorMessage.IsEmpty())
+    {
+        return false; // REJECT
+    }
+    bOutHasToken = true;
+    return true;
+}
+
+bool UCPP_LoginManagerSubsystem::ValidatePlayerLogin_Implementation(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, FString &OutErrorMessage)
+{
+    FProxyScopedLatency Latency(ValidatePlayerLoginLatency);
+
+    // Check if server is "locked"
+    if (bIsServerLocked)
+    {
+        OutErrorMessage = TEXT("Server is currently locked by the Admin.");
+        return false; // REJECT
+    }
+
+    // Local Key is still being generated in the background
+    if (EnableLocalEncryptionValidation && !bIsLocalKeyReady)
+    {
+        OutErrorMessage = TEXT("Server is still starting up. Please retry in a moment.");
+        return false; // REJECT
+    }
+
+    // Check if the player is assigned a role that is Valid or Banned
+    const FProxyRolePolicyPtr Policy = GetRolePolicy();
+    if (!Policy.IsValid())
+    {
+        OutErrorMessage = TEXT("This server is not configured to accept the Specific roles of the Player.");
+        return false; // REJECT
+    }
+
+    // Single hashed lookup, the key (and its hash) is built once per login
+    const FProxySessionKey SessionKey = FProxySessionKey::FromNetId(UniqueId);
+    const FProxySessionEntryPtr PlayerData = PlayerID_SessionData_Map.Find(SessionKey);
+    if (PlayerData.IsValid() && IsJoinTokenExpired(*PlayerData, FDateTime::UtcNow().ToUnixTimestamp()))
+    {
+        OutErrorMessage = TEXT("Your join token has expired. Please request a new one.");
+        return false; // REJECT
+    }
+
+    const FProxyRoleMask PlayerRoleMask = PlayerData ? Policy->ComputeMask(PlayerData->roles) : 0;
+
+    switch (Policy->Evaluate(PlayerRoleMask))
+    {
+    case EProxyRoleDecision::Restricted:
+        OutErrorMessage = TEXT("You are restricted from this server.");
+        return false; // REJECT
+    case EProxyRoleDecision::NoAllowedRole:
+        OutErrorMessage = TEXT("This server is not configured to accept the Specific roles of the Player.");
+        return false; // REJECT
+    case EProxyRoleDecision::MissingRequiredRole:
+        OutErrorMessage = TEXT("You are missing a role required by this server.");
         return false; // REJECT
+    default:
+        break;
     }
 
     return true; // ALLOW
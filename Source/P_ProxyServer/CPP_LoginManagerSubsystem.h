@@ -10,8 +10,25 @@
 #include "Subsystems/WorldSubsystem.h"
 #include "CPP_LoginHandler.h"
 #include "CPP_STRUCT__ProxyServer.h"
+#include "Misc/ScopeRWLock.h"
+#include "CPP_AsyncRsaDecryptor.h"
+#include "CPP_RsaKeyPool.h"
+#include "CPP_RolePolicy.h"
+#include "CPP_SessionStore.h"
+#include "CPP_TimingWheel.h"
+#include "CPP_ReplayCache.h"
+#include "CPP_BackendBatcher.h"
+#include "CPP_BackendClient.h"
+#include "CPP_BackendCache.h"
+#include "CPP_SingleFlight.h"
+#include "CPP_BackendPushChannel.h"
+#include "CPP_AdmissionControl.h"
+#include "CPP_LoginPipeline.h"
+#include "Containers/Ticker.h"
 #include "CPP_LoginManagerSubsystem.generated.h"
 
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnAsyncDecryptComplete, bool, bSuccess, const FString &, DecryptedContent);
+
 UCLASS(Config = Game) // Punal Manalan, NOTE: Specifying Unreal Engine to look for this Config in DefaultGame.ini
 class P_PROXYSERVER_API UCPP_LoginManagerSubsystem : public UWorldSubsystem, public ICPP_LoginHandler
 {
@@ -31,6 +48,130 @@ public:
     UPROPERTY(Config)
     int JoinSessionToken_Expiry_Seconds = 360; // Punal Manalan, Default: 6 Minutes
 
+    // Worker pool used for RSA decryption off the game thread
+    UPROPERTY(Config)
+    int32 AsyncDecrypt_WorkerCount = 2;
+
+    UPROPERTY(Config)
+    int32 AsyncDecrypt_MaxPendingJobs = 256; // Beyond this, async decrypt requests are refused (backpressure)
+
+    // Backend client: per attempt timeout, overall deadline, retries with backoff, hedging and circuit breaking.
+    // Punal Manalan, NOTE: Blueprint requests (SendAPIRequestToBackendServer) now fail after Backend_DeadlineSeconds
+    // instead of the HTTP module's own timeout. A request is only retried / hedged when its caller marks it idempotent
+    // (bIdempotent on SendBackendRequest_Cpp, SendPlayerBackendRequest_Cpp and SendPlayerAPIRequestToBackendServer).
+    UPROPERTY(Config)
+    float Backend_TimeoutSeconds = 5.0f;
+
+    UPROPERTY(Config)
+    float Backend_DeadlineSeconds = 15.0f;
+
+    UPROPERTY(Config)
+    int32 Backend_MaxRetries = 2;
+
+    UPROPERTY(Config)
+    float Backend_RetryBaseDelaySeconds = 0.2f;
+
+    UPROPERTY(Config)
+    FString Backend_HedgeURL = ""; // Empty = No hedged requests
+
+    UPROPERTY(Config)
+    int32 Backend_CircuitFailureThreshold = 5;
+
+    UPROPERTY(Config)
+    float Backend_CircuitOpenSeconds = 10.0f;
+
+    // Login admission control in front of ValidatePlayerLogin, per address token buckets plus a global in-flight limit.
+    // Punal Manalan, NOTE: An address seen for the first time starts with a single token, not the full burst, so players
+    // sharing one NAT / CGNAT address and quick retries after a failed login can be shed until the bucket refills.
+    // Raise the rate for such player bases, or set it to 0 (or below) to only keep the global limit.
+    UPROPERTY(Config)
+    float Admission_PerAddressRatePerSecond = 0.5f;
+
+    UPROPERTY(Config)
+    float Admission_PerAddressBurst = 5.0f;
+
+    UPROPERTY(Config)
+    int32 Admission_MaxConcurrentValidations = 64;
+
+    UPROPERTY(Config)
+    int32 Admission_TableSize = 16384; // Address buckets, fixed regardless of how many addresses show up
+
+    // Asynchronous login validation (ValidatePlayerLoginAsync / AServerGameMode::PreLoginAsync)
+    UPROPERTY(Config)
+    float LoginPipeline_StageTimeoutSeconds = 5.0f; // Per stage, a stage that takes longer rejects the login
+
+    UPROPERTY(Config)
+    bool LoginPipeline_RequireJoinToken = false; // Reject logins that do not carry ?JoinToken= in their URL options, or have no session
+
+    UPROPERTY(Config)
+    bool LoginPipeline_BackendConfirm = false; // Ask the backend to confirm every login ({"type":"confirmLogin", "playerId", "nonce", "tokenDigest"})
+
+    // Serves the Prometheus text metrics (see FProxyMetrics) at :<port>/metrics, 0 = no endpoint ("Proxy.Metrics" still works).
+    // Read once by the module at startup (FP_ProxyServer::StartupModule), one endpoint per process whatever the number of worlds.
+    UPROPERTY(Config)
+    int32 Metrics_HttpPort = 0;
+
+    // Backend response cache for per-player lookups, 0 entries disables it
+    UPROPERTY(Config)
+    int32 BackendCache_MaxEntries = 4096;
+
+    UPROPERTY(Config)
+    float BackendCache_TTLSeconds = 60.0f;
+
+    UPROPERTY(Config)
+    float BackendCache_NegativeTTLSeconds = 10.0f; // "not found / banned" answers
+
+    // Incremental session table sync with the backend, 0 = Do not poll (a push "resyncRequired" still triggers one)
+    UPROPERTY(Config)
+    float SessionSync_IntervalSeconds = 0.0f;
+
+    UPROPERTY(Config)
+    int32 SessionSync_MaxDeltaChanges = 5000; // The backend answers with a full snapshot beyond this many changes
+
+    // Persistent event stream from the backend (e.g. ws://localhost:8080/events), Empty = No push channel
+    UPROPERTY(Config)
+    FString BackendPush_URL = "";
+
+    // Concurrent identical backend reads (or requests sharing a DedupKey) share one in-flight POST
+    UPROPERTY(Config)
+    bool BackendDedup_Enabled = true;
+
+    // Backend request batching: requests within the window (or up to MaxSize) go out as one POST. Window <= 0 disables batching.
+    UPROPERTY(Config)
+    float BackendBatch_WindowSeconds = 0.0f;
+
+    UPROPERTY(Config)
+    int32 BackendBatch_MaxSize = 32;
+
+    UPROPERTY(Config)
+    FString BackendBatch_URL = ""; // Empty = Backend_Server_URL
+
+    // Replay protection for Join Tokens, memory is fixed by these two (~4 bytes per expected token + 16 bytes per exact slot)
+    UPROPERTY(Config)
+    int32 ReplayCache_ExpectedTokensPerWindow = 100000; // Tokens consumed per ReplayCache_WindowSeconds
+
+    // Punal Manalan, NOTE: A consumed token is only remembered for this long, it can be replayed once the window has passed.
+    // 0 = JoinSessionToken_Expiry_Seconds, which covers a token's whole life. If both are 0 there is no replay protection.
+    UPROPERTY(Config)
+    int32 ReplayCache_WindowSeconds = 0;
+
+    UPROPERTY(Config)
+    int32 ReplayCache_ExactCapacity = 65536;
+
+    // Local Key Pairs are taken from a background-generated pool (see FProxyRsaKeyPool)
+    UPROPERTY(Config)
+    int32 LocalKey_SizeInBits = 2048;
+
+    UPROPERTY(Config)
+    int32 LocalKeyPool_Size = 2; // Pairs kept ready for subsystem creation / key rotation
+
+    // Punal Manalan, NOTE: Persisted pairs are written as unencrypted private keys, only enable this where the Saved Dir is private to the server
+    UPROPERTY(Config)
+    bool LocalKeyPool_PersistPrivateKeys = false;
+
+    UPROPERTY(Config)
+    FString LocalKeyPool_PersistDirectory = ""; // Relative to the Project Saved Dir, only used with LocalKeyPool_PersistPrivateKeys
+
     // Punal Manalan, NOTE: These are Packaged with the Server Build, as Part of Config File.
     FString Server_Global_PrivateKeyPEM = "";
     FString Server_Global_PublicKeyPEM = "";
@@ -39,6 +180,25 @@ public:
     FString Server_Local_PrivateKeyPEM = "";
     FString Server_Local_PublicKeyPEM = "";
 
+    /*
+     * Punal Manalan, NOTE: Parsed forms of the PEM Keys above, these are what Encrypt/Decrypt/Sign actually use.
+     * HMAC Keys are the precomputed HMAC-SHA256 schedules of the Private Keys (used to Sign/Verify Join Tokens).
+     * Rebuilt by RefreshServerKeys() whenever a PEM changes, guarded by ServerKeyLock so worker threads can take copies.
+     */
+    FRsaKeyPtr Server_Global_PrivateKey;
+    FRsaKeyPtr Server_Global_PublicKey;
+    FRsaKeyPtr Server_Local_PrivateKey;
+    FRsaKeyPtr Server_Local_PublicKey;
+    FHmacSha256Key Server_Global_HmacKey;
+    FHmacSha256Key Server_Local_HmacKey;
+    mutable FRWLock ServerKeyLock;
+
+    TUniquePtr<FProxyAsyncRsaDecryptor> AsyncDecryptor;
+
+    // Set once a Local Key Pair is installed, logins needing the Local Key wait on this
+    bool bIsLocalKeyReady = false;
+    TArray<TFunction<void()>> LocalKeyReadyWaiters;
+
     bool bIsServerLocked = false;
     FString Backend_Server_URL = TEXT("http://localhost:8080/api/");
 
@@ -50,13 +210,129 @@ public:
      */
     TArray<FString> AllowedRole_List = {"Admin", "Moderator", "VIP", "Regular"}; // Roles allowed to join the server.
     TArray<FString> RestrictedRole_List = {"Banned", "TemporaryTimeout"};        // Roles Not allowed to join the server.
-    TMap<FString, FPlayerData> PlayerID_SessionData_Map;                         // Map of PlayerID to PlayerData (could include session info, etc.)
+    TArray<FString> RequiredRole_List;                                           // Roles a player must ALL hold (Empty = no requirement).
+
+    FProxySessionStore PlayerID_SessionData_Map; // Map of PlayerID to PlayerData (could include session info, etc.), hashed lookup by FProxySessionKey
+
+    // Expiry of Join Tokens (JoinSessionToken_Expiry_Seconds), entries are evicted from PlayerID_SessionData_Map once expired
+    FProxyTimingWheel SessionExpiryWheel;
+    FCriticalSection SessionExpiryLock;
+    FTSTicker::FDelegateHandle SessionExpiryTickerHandle;
+
+    TUniquePtr<FProxyReplayCache> ReplayCache;
+    TUniquePtr<FProxyBackendCache> BackendCache;
+    TUniquePtr<FProxyAdmissionController> AdmissionController;
+    TArray<TWeakPtr<FProxyLoginPipeline, ESPMode::ThreadSafe>> ActiveLoginPipelines; // Rejected on Deinitialize
+
+    FProxyBackendTransportPtr BackendTransport;
+    TSharedPtr<FProxyBackendClient, ESPMode::ThreadSafe> BackendClient;
+    TSharedPtr<FProxyBackendBatcher, ESPMode::ThreadSafe> BackendBatcher;
+    TSharedRef<FProxySingleFlight, ESPMode::ThreadSafe> BackendSingleFlight = MakeShared<FProxySingleFlight, ESPMode::ThreadSafe>();
+
+    TSharedPtr<FProxyBackendPushChannel, ESPMode::ThreadSafe> BackendPushChannel;
+    FProxyPushConnectionFactory BackendPushConnectionFactory; // Unset = WebSocket to BackendPush_URL
+
+    // Backend session table version we have applied (and acknowledge with our next sync request)
+    int64 BackendSessionVersion = 0;
+    bool bIsSessionSyncInFlight = false;
+    bool bIsFullSessionSyncPending = false;
+    FTSTicker::FDelegateHandle SessionSyncTickerHandle;
+
+    // False if the payload cannot be applied on top of BackendSessionVersion: a delta that does not line up schedules
+    // a full snapshot, a snapshot older than BackendSessionVersion is dropped
+    bool ApplySessionSync(const FProxySessionSyncPayload &Sync);
+    void FinishBackendSessionSync();
+    bool TickBackendSessionSync(float DeltaTime);
+
+    // (Re)starts the push channel, resuming after the last applied event
+    void StartBackendPushChannel();
+    void KickPlayerById(const FString &PlayerId, const FString &Reason);
+
+    // Below single-flight: batched or straight through the backend client
+    void DispatchBackendRequest(const FString &Payload, FProxyBackendBatcher::FOnResponse OnResponse, bool bIdempotent);
+
+    // Compiled form of the Role Lists above, swapped together with the lists by ApplyRoleLists()
+    FProxyRolePolicyPtr RolePolicy;
+    mutable FRWLock RolePolicyLock;
 
 public:
     virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
 
+    virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+    virtual void Deinitialize() override;
+
     void GenerateNewRSAKeyPair(int32 KeySizeInBits = 2048, bool bIsGlobalKey = false);
 
+    // Take a Local Key Pair from the pre-generated pool, or install the next one generated in the background
+    void AcquireLocalKeyPair();
+    void InstallLocalKeyPair(const FRsaKeyPairPEM &Pair);
+
+    // Runs Callback on the game thread once the Local Key Pair is ready (immediately if it already is)
+    void WhenLocalKeyReady(TFunction<void()> Callback);
+
+    // Unix time (seconds) at which the Player's Join Token expires, 0 = never (no token / expiry disabled)
+    int64 GetJoinTokenExpiryTime(const FPlayerData &Data) const;
+    int64 GetJoinTokenExpiryTime(const FSessionJoinToken &Token) const;
+    bool IsJoinTokenExpired(const FPlayerData &Data, int64 NowUnixSeconds) const;
+
+    void ScheduleSessionExpiry(const FString &PlayerId, const FPlayerData &Data);
+    void RescheduleAllSessionExpiry();
+    bool TickSessionExpiry(float DeltaTime);
+
+    // Backend requests from C++: batched when enabled, OnResponse(Response, Error) runs on the game thread
+    // DedupKey identifies requests that may share one in-flight POST, empty = the payload for idempotent requests, no sharing otherwise
+    // bIdempotent: a read that may be retried / hedged by the backend client, anything else is sent once
+    void SendBackendRequest_Cpp(const FString &Payload, FProxyBackendBatcher::FOnResponse OnResponse, const FString &DedupKey = FString(), bool bIdempotent = false);
+
+    // Created on first use from the Backend_* Config
+    TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> GetBackendClient();
+
+    // Call before validating a login. On true, call ReleaseLogin once validation is done. On false the login is refused.
+    bool TryAdmitLogin(const FString &Address, FString &OutErrorMessage);
+    void ReleaseLogin();
+
+    /**
+     * Non-blocking ValidatePlayerLogin. Stages: ValidatePlayerLogin (policy) -> join token decrypt (RSA worker pool)
+     * -> signature, expiry and session check (thread pool) -> backend confirmation (uncached, sent once) -> EngineChecks (if given, e.g.
+     * AGameModeBase::PreLogin) -> replay check, each with LoginPipeline_StageTimeoutSeconds. The token is only consumed
+     * once everything else passed. The join token comes from the URL options (?JoinToken=<base64>&JoinTokenSignature=<hex>).
+     * OnComplete runs once on the game thread, with an empty string if the login is allowed.
+     */
+    void ValidatePlayerLoginAsync(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, FProxyLoginPipeline::FOnComplete OnComplete,
+                                  FProxyLoginPipeline::FStage EngineChecks = nullptr);
+
+    /**
+     * Blocking join token checks for the synchronous PreLogin: decrypt, signature, expiry and session match, same rules as the async path.
+     * bOutHasToken is set when a valid token was presented, the caller consumes it (ConsumeSessionJoinToken) once every other check passed.
+     */
+    bool ValidatePresentedJoinToken(const FString &Options, const FUniqueNetIdRepl &UniqueId, FSessionJoinToken &OutToken, bool &bOutHasToken, FString &OutErrorMessage);
+
+    // Per-player backend lookup, answered from BackendCache when possible. bIdempotent as for SendBackendRequest_Cpp.
+    void SendPlayerBackendRequest_Cpp(const FString &PlayerId, const FString &Payload, FProxyBackendBatcher::FOnResponse OnResponse, bool bIdempotent = false);
+
+    // Session / role / ban / invalidation events from the backend, in order (see FProxyPushEvent)
+    void ApplyBackendPushEvents(const TArray<FProxyPushEvent> &Events);
+
+    // Where the push channel connects (e.g. FProxyMockPushServer::MakeConnectionFactory), nullptr restores BackendPush_URL
+    void SetBackendPushConnectionFactory(FProxyPushConnectionFactory InFactory);
+
+    // Swap where backend requests go (e.g. FProxyMockBackendTransport for offline testing), nullptr restores HTTP
+    void SetBackendTransport(FProxyBackendTransportPtr InTransport);
+
+    // Compile the Role Lists into a new RolePolicy and swap both in, nothing changes if they cannot be compiled
+    bool ApplyRoleLists(const TArray<FString> &Allowed, const TArray<FString> &Restricted, const TArray<FString> &Required);
+
+    // Thread-safe reference to the current compiled Role Policy
+    FProxyRolePolicyPtr GetRolePolicy() const;
+
+    // Re-parse the PEM strings into key handles and HMAC schedules
+    void RefreshServerKeys();
+
+    // Thread-safe copies of the parsed keys, usable from worker threads
+    FRsaKeyPtr GetServerPrivateKey(bool bUseGlobalKey) const;
+    FRsaKeyPtr GetServerPublicKey(bool bUseGlobalKey) const;
+    FHmacSha256Key GetServerHmacKey(bool bUseGlobalKey) const;
+
     // --- Interface Implementation Start ---
 
     virtual bool InitializeLoginHandler_Implementation() override;
@@ -78,6 +354,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
     bool IsServerLocked() const;
 
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
+    bool IsLocalKeyReady() const;
+
+    // Swap the Local Key Pair for a fresh one from the pre-generated pool
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
+    void RotateLocalKeyPair();
+
     UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
     void SetServerLocked(bool bLocked);
 
@@ -99,12 +382,104 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
     void SetBannedRoleList(const TArray<FString> &NewList);
 
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
+    TArray<FString> GetRequiredRoleList() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
+    void SetRequiredRoleList(const TArray<FString> &NewList);
+
+    // Full copy of the session table, prefer the per-player and delta functions below for polling
     UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
     TMap<FString, FPlayerData> GetPlayerID_SessionData_Map() const;
 
     UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
     void SetPlayerID_SessionData_Map(const TMap<FString, FPlayerData> &NewMap);
 
+    // Per-player access to the session table
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
+    bool GetPlayerSessionData(const FString &PlayerId, FPlayerData &OutData) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
+    void UpsertPlayerSessionData(const FString &PlayerId, const FPlayerData &Data);
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
+    bool RemovePlayerSessionData(const FString &PlayerId);
+
+    UFUNCTION(BlueprintPure, Category = "Punal|Login Manager")
+    int32 GetPlayerSessionCount() const;
+
+    // Change tracking: poll with the Version of the previous delta (0 the first time) to get only what changed
+    UFUNCTION(BlueprintPure, Category = "Punal|Login Manager")
+    int64 GetPlayerSessionVersion() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
+    FPlayerSessionDelta GetPlayerSessionChangesSince(int64 SinceVersion) const;
+
+    // Like SendAPIRequestToBackendServer, but concurrent requests with the same DedupKey share one backend call and
+    // all get its answer (see BackendDedup_Enabled). Only pick a DedupKey for requests where one answer serves every
+    // caller, e.g. "lookup:<PlayerId>". An empty DedupKey sends the request on its own. bIdempotent as below.
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    bool SendDedupedAPIRequestToBackendServer(const FString &Send_Payload, const FString &DedupKey, const FOnSentAPIResponse &ResponseDelegate, bool bIdempotent = false);
+
+    // Like SendAPIRequestToBackendServer, but the answer is cached per player (see BackendCache_* Config).
+    // bIdempotent: only for pure reads, they may then be retried / hedged (see Backend_* Config), anything else is sent once.
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    bool SendPlayerAPIRequestToBackendServer(const FString &PlayerId, const FString &Send_Payload, const FOnSentAPIResponse &ResponseDelegate, bool bIdempotent = false);
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    bool InvalidateBackendCacheForPlayer(const FString &PlayerId);
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    void InvalidateBackendCache();
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    FBackendCacheStats GetBackendCacheStats() const;
+
+    /*
+     * Asks the backend for session table changes since the version we last applied:
+     * {"type": "sessionSync", "sinceVersion": N, "maxChanges": M}, answered with an FProxySessionSyncPayload.
+     * Only the differences are applied. A snapshot is requested instead if the delta does not line up.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    void RequestBackendSessionSync(bool bFullSnapshot);
+
+    // For sync payloads the backend pushes on its own
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    bool ApplyBackendSessionSync(const FString &SyncPayload);
+
+    UFUNCTION(BlueprintPure, Category = "Punal|Login Manager|Backend")
+    int64 GetBackendSessionVersion() const;
+
+    // Snapshots older than GetBackendSessionVersion are ignored. If the backend starts its versions over (e.g. after
+    // losing its state), call this to forget ours and take the next full snapshot whatever its version.
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Backend")
+    void ResetBackendSessionSync();
+
+    UFUNCTION(BlueprintPure, Category = "Punal|Login Manager|Backend")
+    bool IsBackendPushConnected() const;
+
+    // Sequence number of the last applied push event, the channel resumes after it on reconnect
+    UFUNCTION(BlueprintPure, Category = "Punal|Login Manager|Backend")
+    int64 GetBackendPushLastSeq() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager")
+    FAdmissionStats GetAdmissionStats() const;
+
+    // Requests that joined an identical in-flight request instead of sending their own
+    UFUNCTION(BlueprintPure, Category = "Punal|Login Manager|Backend")
+    int64 GetNumCoalescedBackendRequests() const;
+
+    // Replay protection: true the first time a Join Token (playerID, timeStamp, sessionSecret) is presented, false after that.
+    // Always true when replay protection is off (see ReplayCache_WindowSeconds).
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Token")
+    bool ConsumeSessionJoinToken(const FSessionJoinToken &Token);
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Token")
+    FReplayCacheStats GetReplayCacheStats() const;
+
+    // C++ view of the session table (entries are shared, nothing is copied)
+    const FProxySessionStore &GetSessionStore() const { return PlayerID_SessionData_Map; }
+
     // Server key getters/setters
     UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
     FString GetServer_Global_PrivateKeyPEM() const;
@@ -117,4 +492,30 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
     void SetServer_Global_PublicKeyPEM(const FString &NewPublicKeyPEM);
+
+    // RSA with the parsed Server Keys (no PEM parsing per call)
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
+    FString EncryptWithServerPublicKey(const FString &Content, bool bUseGlobalKey) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
+    FString DecryptWithServerPrivateKey(const FString &EncryptedBase64, bool bUseGlobalKey) const;
+
+    // Decrypt on the worker pool, OnComplete fires on the game thread.
+    // Returns false (and never calls OnComplete) if the key is missing or the pool is saturated.
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
+    bool DecryptWithServerPrivateKeyAsync(const FString &EncryptedBase64, bool bUseGlobalKey, const FOnAsyncDecryptComplete &OnComplete);
+
+    bool DecryptWithServerPrivateKeyAsync_Cpp(const FString &EncryptedBase64, bool bUseGlobalKey, FProxyAsyncRsaDecryptor::FOnDecrypted OnComplete);
+
+    // Same, with the raw plaintext bytes (binary join tokens are not UTF-8)
+    bool DecryptBytesWithServerPrivateKeyAsync_Cpp(const FString &EncryptedBase64, bool bUseGlobalKey, FProxyAsyncRsaDecryptor::FOnDecryptedBytes OnComplete);
+
+    FProxyAsyncRsaDecryptor &GetAsyncDecryptor();
+
+    // Join Token signatures: HMAC-SHA256 over the canonical Token JSON (FJoinTokenJsonCodec), keyed with the Global or Local Private Key
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
+    FString SignSessionJoinToken(const FSessionJoinToken &Token, bool bUseGlobalKey) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Punal|Login Manager|Crypto")
+    bool VerifySessionJoinTokenSignature(const FSessionJoinToken &Token, const FString &Signature, bool bUseGlobalKey) const;
 };
@@ -0,0 +1,134 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_LoginPipeline.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "CPP_Metrics.h"
+
+namespace
+{
+    const FProxyHistogram LoginPipelineLatency(TEXT("proxy_login_pipeline_seconds"), TEXT(""), TEXT("Time from the start of login validation to its result"));
+    const FProxyCounter LoginsAllowed(TEXT("proxy_login_pipeline_total"), TEXT("result=\"allowed\""), TEXT("Finished asynchronous login validations"));
+    const FProxyCounter LoginsRejected(TEXT("proxy_login_pipeline_total"), TEXT("result=\"rejected\""), TEXT("Finished asynchronous login validations"));
+    const FProxyCounter StageTimeouts(TEXT("proxy_login_stage_timeouts_total"), TEXT(""), TEXT("Login validation stages that did not answer in time"));
+} // anonymous namespace
+
+FProxyLoginPipeline::FProxyLoginPipeline(const FString &InDescription)
+    : Description(InDescription)
+{
+}
+
+FProxyLoginPipeline::~FProxyLoginPipeline()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TimeoutHandle);
+}
+
+void FProxyLoginPipeline::AddStage(const TCHAR *Name, float TimeoutSeconds, FStage Stage, int32 LatencyHistogramId)
+{
+    check(CurrentStage == INDEX_NONE);
+    Stages.Add({Name, TimeoutSeconds, MoveTemp(Stage), LatencyHistogramId});
+}
+
+void FProxyLoginPipeline::Run(FOnComplete InOnComplete)
+{
+    check(IsInGameThread());
+    check(CurrentStage == INDEX_NONE);
+    OnComplete = MoveTemp(InOnComplete);
+    StartTime = FPlatformTime::Seconds();
+    StartStage(0);
+}
+
+void FProxyLoginPipeline::Cancel(const FString &ErrorMessage)
+{
+    check(IsInGameThread());
+    Finish(ErrorMessage);
+}
+
+void FProxyLoginPipeline::StartStage(int32 Index)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    if (!Stages.IsValidIndex(Index))
+    {
+        Finish(FString());
+        return;
+    }
+
+    CurrentStage = Index;
+    StageStartTime = FPlatformTime::Seconds();
+
+    TSharedRef<FProxyLoginPipeline, ESPMode::ThreadSafe> Self = AsShared();
+    const FStageInfo &Stage = Stages[Index];
+    if (Stage.TimeoutSeconds > 0.0f)
+    {
+        TimeoutHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Self, Index](float)
+                                                                                           {
+                                                                                               Self->TimeoutHandle.Reset();
+                                                                                               StageTimeouts.Add();
+                                                                                               Self->CompleteStage(Index, FString::Printf(TEXT("Login validation timed out (%s). Please retry."), Self->Stages[Index].Name));
+                                                                                               return false; }),
+                                                             Stage.TimeoutSeconds);
+    }
+
+    // Punal Manalan, NOTE: Stages may answer from a worker or an HTTP thread, results are always applied on the game thread
+    Stage.Run([Self, Index](const FString &ErrorMessage)
+              {
+                  if (IsInGameThread())
+                  {
+                      Self->CompleteStage(Index, ErrorMessage);
+                      return;
+                  }
+                  AsyncTask(ENamedThreads::GameThread, [Self, Index, ErrorMessage]()
+                            { Self->CompleteStage(Index, ErrorMessage); }); });
+}
+
+void FProxyLoginPipeline::CompleteStage(int32 Index, const FString &ErrorMessage)
+{
+    // A late answer from a stage that already timed out, or a second answer
+    if (bFinished || Index != CurrentStage)
+    {
+        return;
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TimeoutHandle);
+    TimeoutHandle.Reset();
+
+    const double StageSeconds = FPlatformTime::Seconds() - StageStartTime;
+    FProxyMetrics::Get().RecordSeconds(Stages[Index].LatencyHistogramId, StageSeconds);
+    UE_LOG(LogTemp, Verbose, TEXT("LoginPipeline: %s stage %s took %.2f ms"), *Description, Stages[Index].Name, StageSeconds * 1000.0);
+
+    if (!ErrorMessage.IsEmpty())
+    {
+        UE_LOG(LogTemp, Log, TEXT("LoginPipeline: %s rejected at %s: %s"), *Description, Stages[Index].Name, *ErrorMessage);
+        Finish(ErrorMessage);
+        return;
+    }
+    StartStage(Index + 1);
+}
+
+void FProxyLoginPipeline::Finish(const FString &ErrorMessage)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    bFinished = true;
+
+    LoginPipelineLatency.RecordSeconds(FPlatformTime::Seconds() - StartTime);
+    (ErrorMessage.IsEmpty() ? LoginsAllowed : LoginsRejected).Add();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TimeoutHandle);
+    TimeoutHandle.Reset();
+
+    FOnComplete Callback = MoveTemp(OnComplete);
+    if (Callback)
+    {
+        Callback(ErrorMessage);
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Runs login validation as a chain of stages without blocking the game thread.
+ *  - every stage is started on the game thread and may hand its work to any thread, it reports back through
+ *    its Done callback (callable from any thread, extra calls are ignored)
+ *  - an empty error moves on to the next stage, anything else rejects the login with that message
+ *  - a stage that does not report back within its timeout rejects the login, a late answer is dropped
+ * OnComplete runs exactly once, on the game thread, with an empty string when every stage passed.
+ */
+class P_PROXYSERVER_API FProxyLoginPipeline : public TSharedFromThis<FProxyLoginPipeline, ESPMode::ThreadSafe>
+{
+public:
+    typedef TFunction<void(const FString &)> FOnStageDone;  // ErrorMessage
+    typedef TFunction<void(FOnStageDone)> FStage;
+    typedef TFunction<void(const FString &)> FOnComplete;   // ErrorMessage, empty = allowed
+
+    explicit FProxyLoginPipeline(const FString &InDescription);
+    ~FProxyLoginPipeline();
+
+    // LatencyHistogramId: where the stage's latency goes (e.g. a file scope FProxyHistogram's Id), INDEX_NONE = not recorded
+    void AddStage(const TCHAR *Name, float TimeoutSeconds, FStage Stage, int32 LatencyHistogramId = INDEX_NONE);
+
+    // Game thread only
+    void Run(FOnComplete InOnComplete);
+
+    // Rejects the login now unless it already finished, e.g. when the server shuts down
+    void Cancel(const FString &ErrorMessage);
+
+    bool IsFinished() const { return bFinished; }
+
+private:
+    struct FStageInfo
+    {
+        const TCHAR *Name;
+        float TimeoutSeconds;
+        FStage Run;
+        int32 LatencyHistogramId;
+    };
+
+    void StartStage(int32 Index);
+    void CompleteStage(int32 Index, const FString &ErrorMessage);
+    void Finish(const FString &ErrorMessage);
+
+    FString Description; // For logs, e.g. the address
+    TArray<FStageInfo> Stages;
+    FOnComplete OnComplete;
+
+    int32 CurrentStage = INDEX_NONE;
+    double StartTime = 0.0;
+    double StageStartTime = 0.0;
+    bool bFinished = false;
+    FTSTicker::FDelegateHandle TimeoutHandle;
+};
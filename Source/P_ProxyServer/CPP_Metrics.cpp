@@ -0,0 +1,332 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_Metrics.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/EngineVersionComparison.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "HttpPath.h"
+#include "IHttpRouter.h"
+
+namespace
+{
+    const double Quantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+    // This thread's FProxyMetrics::FThreadBlock, kept at file scope (thread_local cannot sit behind the dll interface)
+    thread_local void *GMetricsThreadBlock = nullptr;
+
+    // The endpoint lives as long as the process, the router types stay out of the header
+    TSharedPtr<IHttpRouter> GMetricsHttpRouter;
+    FHttpRouteHandle GMetricsHttpRouteHandle;
+
+    FString format_labels(const FString &Labels, const FString &Extra = FString())
+    {
+        if (Labels.IsEmpty() && Extra.IsEmpty())
+        {
+            return FString();
+        }
+        if (Labels.IsEmpty() || Extra.IsEmpty())
+        {
+            return FString::Printf(TEXT("{%s}"), Labels.IsEmpty() ? *Extra : *Labels);
+        }
+        return FString::Printf(TEXT("{%s,%s}"), *Labels, *Extra);
+    }
+
+    FAutoConsoleCommandWithOutputDevice GProxyMetricsCommand(
+        TEXT("Proxy.Metrics"),
+        TEXT("Prints the Proxy Server counters and latency percentiles"),
+        FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice &Ar)
+                                                             { FProxyMetrics::Get().Dump(Ar); }));
+} // anonymous namespace
+
+FProxyMetrics &FProxyMetrics::Get()
+{
+    static FProxyMetrics Instance;
+    return Instance;
+}
+
+int32 FProxyMetrics::RegisterCounter(const FString &Name, const FString &Labels, const FString &Help)
+{
+    return Register(CounterInfos, MaxCounters, Name, Labels, Help);
+}
+
+int32 FProxyMetrics::RegisterHistogram(const FString &Name, const FString &Labels, const FString &Help)
+{
+    return Register(HistogramInfos, MaxHistograms, Name, Labels, Help);
+}
+
+int32 FProxyMetrics::Register(TArray<FMetricInfo> &Infos, int32 Max, const FString &Name, const FString &Labels, const FString &Help)
+{
+    FScopeLock ScopeLock(&Lock);
+    for (int32 Index = 0; Index < Infos.Num(); ++Index)
+    {
+        if (Infos[Index].Name == Name && Infos[Index].Labels == Labels)
+        {
+            return Index;
+        }
+    }
+    if (Infos.Num() >= Max)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Metrics: No room left for %s{%s}, it will not be recorded"), *Name, *Labels);
+        return INDEX_NONE;
+    }
+    return Infos.Add({Name, Labels, Help});
+}
+
+FProxyMetrics::FThreadBlock &FProxyMetrics::GetThreadBlock()
+{
+    if (!GMetricsThreadBlock)
+    {
+        // Cache line aligned so two threads never write to the same line
+        void *Memory = FMemory::Malloc(sizeof(FThreadBlock), PLATFORM_CACHE_LINE_SIZE);
+        FMemory::Memzero(Memory, sizeof(FThreadBlock));
+        FThreadBlock *Block = new (Memory) FThreadBlock;
+
+        FScopeLock ScopeLock(&Lock);
+        Blocks.Add(Block);
+        GMetricsThreadBlock = Block;
+    }
+    return *(FThreadBlock *)GMetricsThreadBlock;
+}
+
+void FProxyMetrics::Add(int32 CounterId, uint64 Delta)
+{
+    if (CounterId < 0)
+    {
+        return;
+    }
+    // Punal Manalan, NOTE: Only this thread writes its block, a plain load + store is enough (no locked instruction)
+    std::atomic<uint64> &Slot = GetThreadBlock().Counters[CounterId];
+    Slot.store(Slot.load(std::memory_order_relaxed) + Delta, std::memory_order_relaxed);
+}
+
+void FProxyMetrics::RecordCycles(int32 HistogramId, uint64 Cycles)
+{
+    if (HistogramId < 0)
+    {
+        return;
+    }
+    FThreadBlock &Block = GetThreadBlock();
+    std::atomic<uint64> &Bucket = Block.Buckets[HistogramId][BucketIndex(Cycles)];
+    Bucket.store(Bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic<uint64> &Sum = Block.SumCycles[HistogramId];
+    Sum.store(Sum.load(std::memory_order_relaxed) + Cycles, std::memory_order_relaxed);
+}
+
+void FProxyMetrics::RecordSeconds(int32 HistogramId, double Seconds)
+{
+    RecordCycles(HistogramId, (uint64)FMath::Max(0.0, Seconds / FPlatformTime::GetSecondsPerCycle64()));
+}
+
+int32 FProxyMetrics::BucketIndex(uint64 Cycles)
+{
+    if (Cycles < (1ull << MinExponent))
+    {
+        return 0;
+    }
+    const int32 Exponent = (int32)FMath::FloorLog2_64(Cycles);
+    const int32 SubBucket = (int32)(Cycles >> (Exponent - SubBucketBits)) & ((1 << SubBucketBits) - 1);
+    return FMath::Min(NumBuckets - 1, 1 + ((Exponent - MinExponent) << SubBucketBits) + SubBucket);
+}
+
+uint64 FProxyMetrics::BucketUpperBound(int32 Index)
+{
+    if (Index <= 0)
+    {
+        return 1ull << MinExponent;
+    }
+    const int32 Exponent = MinExponent + ((Index - 1) >> SubBucketBits);
+    const uint64 SubBucket = (uint64)((Index - 1) & ((1 << SubBucketBits) - 1));
+    return (((1ull << SubBucketBits) + SubBucket + 1) << (Exponent - SubBucketBits));
+}
+
+uint64 FProxyMetrics::SumCounter(int32 CounterId) const
+{
+    uint64 Total = 0;
+    for (const FThreadBlock *Block : Blocks)
+    {
+        Total += Block->Counters[CounterId].load(std::memory_order_relaxed);
+    }
+    return Total;
+}
+
+void FProxyMetrics::SnapshotHistogram(int32 HistogramId, FHistogramSnapshot &Out) const
+{
+    FMemory::Memzero(Out.Buckets, sizeof(Out.Buckets));
+    Out.Count = 0;
+    Out.SumCycles = 0;
+    for (const FThreadBlock *Block : Blocks)
+    {
+        for (int32 Index = 0; Index < NumBuckets; ++Index)
+        {
+            const uint64 Value = Block->Buckets[HistogramId][Index].load(std::memory_order_relaxed);
+            Out.Buckets[Index] += Value;
+            Out.Count += Value;
+        }
+        Out.SumCycles += Block->SumCycles[HistogramId].load(std::memory_order_relaxed);
+    }
+}
+
+uint64 FProxyMetrics::QuantileCycles(const uint64 *Buckets, uint64 Count, double Quantile)
+{
+    if (Count == 0)
+    {
+        return 0;
+    }
+
+    // Upper bound of the bucket holding the rank, never under-reports
+    const uint64 Rank = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(Quantile * (double)Count));
+    uint64 Seen = 0;
+    for (int32 Index = 0; Index < NumBuckets; ++Index)
+    {
+        Seen += Buckets[Index];
+        if (Seen >= Rank)
+        {
+            return BucketUpperBound(Index);
+        }
+    }
+    return BucketUpperBound(NumBuckets - 1);
+}
+
+double FProxyMetrics::FHistogramSnapshot::QuantileSeconds(double Quantile) const
+{
+    return (double)QuantileCycles(Buckets, Count, Quantile) * FPlatformTime::GetSecondsPerCycle64();
+}
+
+FString FProxyMetrics::ExportPrometheus() const
+{
+    FScopeLock ScopeLock(&Lock);
+    const double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+
+    FString Out;
+    Out.Reserve(8192);
+
+    // HELP / TYPE once per metric name, label sets of one name are registered next to each other in practice
+    // but are grouped here anyway
+    TSet<FString> Emitted;
+    for (const FMetricInfo &Info : CounterInfos)
+    {
+        if (Emitted.Contains(Info.Name))
+        {
+            continue;
+        }
+        Emitted.Add(Info.Name);
+        Out += FString::Printf(TEXT("# HELP %s %s\n# TYPE %s counter\n"), *Info.Name, *Info.Help, *Info.Name);
+        for (int32 Id = 0; Id < CounterInfos.Num(); ++Id)
+        {
+            if (CounterInfos[Id].Name == Info.Name)
+            {
+                Out += FString::Printf(TEXT("%s%s %llu\n"), *Info.Name, *format_labels(CounterInfos[Id].Labels), SumCounter(Id));
+            }
+        }
+    }
+
+    FHistogramSnapshot Snapshot;
+    for (const FMetricInfo &Info : HistogramInfos)
+    {
+        if (Emitted.Contains(Info.Name))
+        {
+            continue;
+        }
+        Emitted.Add(Info.Name);
+        Out += FString::Printf(TEXT("# HELP %s %s\n# TYPE %s summary\n"), *Info.Name, *Info.Help, *Info.Name);
+        for (int32 Id = 0; Id < HistogramInfos.Num(); ++Id)
+        {
+            if (HistogramInfos[Id].Name != Info.Name)
+            {
+                continue;
+            }
+            const FString &Labels = HistogramInfos[Id].Labels;
+            SnapshotHistogram(Id, Snapshot);
+            for (double Quantile : Quantiles)
+            {
+                Out += FString::Printf(TEXT("%s%s %.9g\n"), *Info.Name, *format_labels(Labels, FString::Printf(TEXT("quantile=\"%g\""), Quantile)), Snapshot.QuantileSeconds(Quantile));
+            }
+            Out += FString::Printf(TEXT("%s_sum%s %.9g\n"), *Info.Name, *format_labels(Labels), (double)Snapshot.SumCycles * SecondsPerCycle);
+            Out += FString::Printf(TEXT("%s_count%s %llu\n"), *Info.Name, *format_labels(Labels), Snapshot.Count);
+        }
+    }
+    return Out;
+}
+
+void FProxyMetrics::Dump(FOutputDevice &Ar) const
+{
+    FScopeLock ScopeLock(&Lock);
+    const double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+
+    for (int32 Id = 0; Id < CounterInfos.Num(); ++Id)
+    {
+        Ar.Logf(TEXT("%s%s = %llu"), *CounterInfos[Id].Name, *format_labels(CounterInfos[Id].Labels), SumCounter(Id));
+    }
+
+    FHistogramSnapshot Snapshot;
+    for (int32 Id = 0; Id < HistogramInfos.Num(); ++Id)
+    {
+        SnapshotHistogram(Id, Snapshot);
+        const double MeanSeconds = Snapshot.Count > 0 ? (double)Snapshot.SumCycles * SecondsPerCycle / (double)Snapshot.Count : 0.0;
+        Ar.Logf(TEXT("%s%s n=%llu mean=%.1fus p50=%.1fus p90=%.1fus p99=%.1fus p99.9=%.1fus"),
+                *HistogramInfos[Id].Name, *format_labels(HistogramInfos[Id].Labels), Snapshot.Count, MeanSeconds * 1e6,
+                Snapshot.QuantileSeconds(0.5) * 1e6, Snapshot.QuantileSeconds(0.9) * 1e6, Snapshot.QuantileSeconds(0.99) * 1e6, Snapshot.QuantileSeconds(0.999) * 1e6);
+    }
+}
+
+bool FProxyMetrics::StartHttpEndpoint(uint32 Port)
+{
+    check(IsInGameThread());
+    if (HttpEndpointUsers++ > 0)
+    {
+        return true;
+    }
+
+    // Punal Manalan, NOTE: The listen address comes from [HTTPServer.Listeners] DefaultBindAddress, keep it off public interfaces
+    TSharedPtr<IHttpRouter> Router = FHttpServerModule::Get().GetHttpRouter(Port);
+    if (!Router.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Metrics: Could not get an HTTP router on port %u"), Port);
+        --HttpEndpointUsers;
+        return false;
+    }
+
+    auto Handler = [](const FHttpServerRequest &Request, const FHttpResultCallback &OnComplete)
+    {
+        OnComplete(FHttpServerResponse::Create(FProxyMetrics::Get().ExportPrometheus(), TEXT("text/plain; version=0.0.4; charset=utf-8")));
+        return true;
+    };
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+    GMetricsHttpRouteHandle = Router->BindRoute(FHttpPath(TEXT("/metrics")), EHttpServerRequestVerbs::VERB_GET, Handler);
+#else
+    GMetricsHttpRouteHandle = Router->BindRoute(FHttpPath(TEXT("/metrics")), EHttpServerRequestVerbs::VERB_GET, FHttpRequestHandler::CreateLambda(Handler));
+#endif
+    if (!GMetricsHttpRouteHandle.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Metrics: /metrics is already bound on port %u"), Port);
+        --HttpEndpointUsers;
+        return false;
+    }
+
+    GMetricsHttpRouter = Router;
+    FHttpServerModule::Get().StartAllListeners();
+    UE_LOG(LogTemp, Log, TEXT("Metrics: Serving Prometheus metrics on port %u at /metrics"), Port);
+    return true;
+}
+
+void FProxyMetrics::StopHttpEndpoint()
+{
+    check(IsInGameThread());
+    if (HttpEndpointUsers <= 0 || --HttpEndpointUsers > 0)
+    {
+        return;
+    }
+
+    if (GMetricsHttpRouter.IsValid() && GMetricsHttpRouteHandle.IsValid())
+    {
+        GMetricsHttpRouter->UnbindRoute(GMetricsHttpRouteHandle);
+    }
+    GMetricsHttpRouteHandle.Reset();
+    GMetricsHttpRouter.Reset();
+}
@@ -0,0 +1,137 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+/**
+ * Process wide counters and latency histograms, cheap enough to stay on in production.
+ *  - every thread records into its own block (single writer, relaxed loads/stores, no lock and no shared
+ *    cache line), readers sum the blocks when exporting
+ *  - histograms are log-linear (HDR style): 8 sub-buckets per power of two, quantiles report the bucket's upper
+ *    bound and so over-report by at most 12.5%. Recorded in CPU cycles and converted to seconds only on export.
+ * Metrics are registered once (e.g. from a file scope FProxyCounter / FProxyHistogram) and addressed by id.
+ * Exported in Prometheus text format (histograms as summaries with quantiles) through ExportPrometheus,
+ * the optional HTTP endpoint and the "Proxy.Metrics" console command.
+ */
+class P_PROXYSERVER_API FProxyMetrics
+{
+public:
+    static constexpr int32 MaxCounters = 64;
+    static constexpr int32 MaxHistograms = 32;
+    static constexpr int32 SubBucketBits = 3;
+    static constexpr int32 MinExponent = 6; // Anything below 64 cycles lands in bucket 0
+    static constexpr int32 NumBuckets = 256; // Up to about 2^38 cycles (a minute at 4 GHz), the last bucket takes anything longer
+
+    static FProxyMetrics &Get();
+
+    // Same (Name, Labels) returns the same id. Labels are Prometheus label pairs without braces, e.g. op="decrypt".
+    // INDEX_NONE when the table is full, recording to INDEX_NONE does nothing.
+    int32 RegisterCounter(const FString &Name, const FString &Labels, const FString &Help);
+    int32 RegisterHistogram(const FString &Name, const FString &Labels, const FString &Help);
+
+    void Add(int32 CounterId, uint64 Delta = 1);
+    void RecordCycles(int32 HistogramId, uint64 Cycles);
+    void RecordSeconds(int32 HistogramId, double Seconds);
+
+    FString ExportPrometheus() const;
+    void Dump(FOutputDevice &Ar) const;
+
+    // Serves ExportPrometheus at http://<bind address>:Port/metrics. Reference counted, game thread only.
+    bool StartHttpEndpoint(uint32 Port);
+    void StopHttpEndpoint();
+
+    static int32 BucketIndex(uint64 Cycles);
+    static uint64 BucketUpperBound(int32 Index); // In cycles
+
+    // Upper bound (in cycles) of the bucket holding the Quantile rank of Count samples spread over Buckets[NumBuckets], 0 when empty
+    static uint64 QuantileCycles(const uint64 *Buckets, uint64 Count, double Quantile);
+
+private:
+    struct FThreadBlock
+    {
+        std::atomic<uint64> Counters[MaxCounters];
+        std::atomic<uint64> Buckets[MaxHistograms][NumBuckets];
+        std::atomic<uint64> SumCycles[MaxHistograms];
+    };
+
+    struct FMetricInfo
+    {
+        FString Name;
+        FString Labels;
+        FString Help;
+    };
+
+    struct FHistogramSnapshot
+    {
+        uint64 Buckets[NumBuckets];
+        uint64 Count = 0;
+        uint64 SumCycles = 0;
+
+        double QuantileSeconds(double Quantile) const;
+    };
+
+    FProxyMetrics() = default;
+
+    FThreadBlock &GetThreadBlock();
+    int32 Register(TArray<FMetricInfo> &Infos, int32 Max, const FString &Name, const FString &Labels, const FString &Help);
+    uint64 SumCounter(int32 CounterId) const;
+    void SnapshotHistogram(int32 HistogramId, FHistogramSnapshot &Out) const;
+
+    mutable FCriticalSection Lock;
+    TArray<FThreadBlock *> Blocks; // Never freed, a finished thread's counts are still part of the totals
+    TArray<FMetricInfo> CounterInfos;
+    TArray<FMetricInfo> HistogramInfos;
+    int32 HttpEndpointUsers = 0;
+};
+
+// File scope handles, registered during static initialization
+struct P_PROXYSERVER_API FProxyCounter
+{
+    FProxyCounter(const TCHAR *Name, const TCHAR *Labels, const TCHAR *Help)
+        : Id(FProxyMetrics::Get().RegisterCounter(Name, Labels, Help))
+    {
+    }
+
+    void Add(uint64 Delta = 1) const { FProxyMetrics::Get().Add(Id, Delta); }
+
+    const int32 Id;
+};
+
+struct P_PROXYSERVER_API FProxyHistogram
+{
+    FProxyHistogram(const TCHAR *Name, const TCHAR *Labels, const TCHAR *Help)
+        : Id(FProxyMetrics::Get().RegisterHistogram(Name, Labels, Help))
+    {
+    }
+
+    void RecordCycles(uint64 Cycles) const { FProxyMetrics::Get().RecordCycles(Id, Cycles); }
+    void RecordSeconds(double Seconds) const { FProxyMetrics::Get().RecordSeconds(Id, Seconds); }
+
+    const int32 Id;
+};
+
+// Records the lifetime of the scope into a histogram
+class FProxyScopedLatency
+{
+public:
+    explicit FProxyScopedLatency(const FProxyHistogram &InHistogram)
+        : Histogram(InHistogram), StartCycles(FPlatformTime::Cycles64())
+    {
+    }
+
+    ~FProxyScopedLatency()
+    {
+        Histogram.RecordCycles(FPlatformTime::Cycles64() - StartCycles);
+    }
+
+private:
+    const FProxyHistogram &Histogram;
+    uint64 StartCycles;
+};
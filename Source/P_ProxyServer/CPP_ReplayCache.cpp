@@ -0,0 +1,225 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ReplayCache.h"
+#include "CPP_Sha256.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    // Bloom sizing: 24 bits per token with 12 probes per block (BloomProbes), ~0.0015% false positives per full bucket
+    static constexpr int32 BloomBitsPerToken = 24;
+    static constexpr int32 ExactProbeWindow = 8;
+
+    static uint64 load_u64(const uint8 *Bytes)
+    {
+        uint64 Value = 0;
+        for (int32 Index = 0; Index < 8; ++Index)
+        {
+            Value = (Value << 8) | Bytes[Index];
+        }
+        return Value;
+    }
+} // anonymous namespace
+
+FProxyReplayCache::FProxyReplayCache(int32 InWindowSeconds, int32 ExpectedTokensPerWindow, int32 ExactCapacity)
+{
+    WindowSeconds = FMath::Max(1, InWindowSeconds);
+    BucketSeconds = FMath::DivideAndRoundUp(WindowSeconds, NumBuckets - 1);
+
+    const int64 TokensPerBucket = FMath::DivideAndRoundUp<int64>(FMath::Max(1, ExpectedTokensPerWindow), NumBuckets - 1);
+    BlocksPerBucket = (int32)FMath::Max<int64>(1, FMath::DivideAndRoundUp<int64>(TokensPerBucket * BloomBitsPerToken, WordsPerBlock * 64));
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        FilterWords[Bucket].SetNumZeroed(BlocksPerBucket * WordsPerBlock);
+        BucketEpoch[Bucket] = INDEX_NONE;
+        BucketInserts[Bucket] = 0;
+    }
+
+    const uint32 SlotCount = FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(ExactCapacity, ExactProbeWindow));
+    ExactSlots.SetNum(SlotCount);
+    ExactMask = SlotCount - 1;
+}
+
+FProxyReplayCache::FFingerprint FProxyReplayCache::MakeFingerprint(const FString &PlayerId, int64 TimeStamp, const FString &SessionSecret)
+{
+    // Length-prefix the strings so field boundaries cannot be shifted
+    FSha256Context Context;
+    const int32 IdLength = PlayerId.Len();
+    const int32 SecretLength = SessionSecret.Len();
+    Context.Update((const uint8 *)&IdLength, sizeof(IdLength));
+    Context.UpdateString(PlayerId);
+    Context.Update((const uint8 *)&TimeStamp, sizeof(TimeStamp));
+    Context.Update((const uint8 *)&SecretLength, sizeof(SecretLength));
+    Context.UpdateString(SessionSecret);
+
+    uint8 Digest[FSha256Context::DigestSize];
+    Context.Final(Digest);
+
+    FFingerprint Fingerprint;
+    Fingerprint.Id = load_u64(Digest) | 1; // 0 marks an empty exact slot
+    Fingerprint.Block = Fingerprint.Id * 0x9E3779B97F4A7C15ull; // Independent enough of the exact-set index (low bits of Id)
+    for (int32 Probe = 0; Probe < BloomProbes; ++Probe)
+    {
+        // 9 bits per probe (512-bit block), taken from the last 24 bytes of the digest
+        Fingerprint.Bits[Probe] = (uint16)(((Digest[8 + Probe * 2] << 8) | Digest[9 + Probe * 2]) & 511);
+    }
+    return Fingerprint;
+}
+
+void FProxyReplayCache::RotateBuckets(int64 NowUnixSeconds)
+{
+    // Buckets whose epoch fell out of the window are wiped before reuse
+    const int64 CurrentEpoch = NowUnixSeconds / BucketSeconds;
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        if (BucketEpoch[Bucket] != INDEX_NONE && CurrentEpoch - BucketEpoch[Bucket] >= NumBuckets)
+        {
+            FMemory::Memzero(FilterWords[Bucket].GetData(), FilterWords[Bucket].Num() * sizeof(uint64));
+            BucketEpoch[Bucket] = INDEX_NONE;
+            BucketInserts[Bucket] = 0;
+        }
+    }
+
+    const int32 CurrentBucket = (int32)(CurrentEpoch % NumBuckets);
+    if (BucketEpoch[CurrentBucket] != CurrentEpoch)
+    {
+        FMemory::Memzero(FilterWords[CurrentBucket].GetData(), FilterWords[CurrentBucket].Num() * sizeof(uint64));
+        BucketEpoch[CurrentBucket] = CurrentEpoch;
+        BucketInserts[CurrentBucket] = 0;
+    }
+}
+
+bool FProxyReplayCache::ExactContains(uint64 Id, int64 NowUnixSeconds) const
+{
+    for (int32 Probe = 0; Probe < ExactProbeWindow; ++Probe)
+    {
+        const FExactSlot &Slot = ExactSlots[(uint32)((Id >> 1) + Probe) & ExactMask];
+        if (Slot.Id == Id && NowUnixSeconds - Slot.InsertedAt < WindowSeconds)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FProxyReplayCache::ExactInsert(uint64 Id, int64 NowUnixSeconds)
+{
+    // Take an empty / expired slot in the probe window, else evict the oldest one (the Bloom filters still cover it)
+    FExactSlot *Target = nullptr;
+    for (int32 Probe = 0; Probe < ExactProbeWindow; ++Probe)
+    {
+        FExactSlot &Slot = ExactSlots[(uint32)((Id >> 1) + Probe) & ExactMask];
+        if (Slot.Id == 0 || NowUnixSeconds - Slot.InsertedAt >= WindowSeconds)
+        {
+            Target = &Slot;
+            break;
+        }
+        if (!Target || Slot.InsertedAt < Target->InsertedAt)
+        {
+            Target = &Slot;
+        }
+    }
+    Target->Id = Id;
+    Target->InsertedAt = NowUnixSeconds;
+}
+
+bool FProxyReplayCache::FilterContains(const FFingerprint &Fingerprint) const
+{
+    const int32 BlockStart = (int32)((Fingerprint.Block >> 32) % (uint64)BlocksPerBucket) * WordsPerBlock;
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        if (BucketEpoch[Bucket] == INDEX_NONE)
+        {
+            continue;
+        }
+
+        const uint64 *Block = FilterWords[Bucket].GetData() + BlockStart;
+        bool bAllSet = true;
+        for (int32 Probe = 0; Probe < BloomProbes && bAllSet; ++Probe)
+        {
+            const uint16 Bit = Fingerprint.Bits[Probe];
+            bAllSet = (Block[Bit >> 6] >> (Bit & 63)) & 1;
+        }
+        if (bAllSet)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FProxyReplayCache::FilterInsert(const FFingerprint &Fingerprint)
+{
+    // RotateBuckets has made sure the current bucket is live
+    int32 CurrentBucket = 0;
+    for (int32 Bucket = 1; Bucket < NumBuckets; ++Bucket)
+    {
+        if (BucketEpoch[Bucket] > BucketEpoch[CurrentBucket])
+        {
+            CurrentBucket = Bucket;
+        }
+    }
+
+    uint64 *Block = FilterWords[CurrentBucket].GetData() + (int32)((Fingerprint.Block >> 32) % (uint64)BlocksPerBucket) * WordsPerBlock;
+    for (int32 Probe = 0; Probe < BloomProbes; ++Probe)
+    {
+        const uint16 Bit = Fingerprint.Bits[Probe];
+        Block[Bit >> 6] |= uint64(1) << (Bit & 63);
+    }
+    ++BucketInserts[CurrentBucket];
+}
+
+bool FProxyReplayCache::CheckAndInsert(const FString &PlayerId, int64 TimeStamp, const FString &SessionSecret, int64 NowUnixSeconds)
+{
+    // Hash outside the lock
+    const FFingerprint Fingerprint = MakeFingerprint(PlayerId, TimeStamp, SessionSecret);
+
+    FScopeLock ScopeLock(&Lock);
+    ++Stats.Checks;
+    RotateBuckets(NowUnixSeconds);
+
+    if (ExactContains(Fingerprint.Id, NowUnixSeconds))
+    {
+        ++Stats.ExactReplays;
+        return false;
+    }
+    if (FilterContains(Fingerprint))
+    {
+        ++Stats.FilterReplays;
+        return false;
+    }
+
+    ExactInsert(Fingerprint.Id, NowUnixSeconds);
+    FilterInsert(Fingerprint);
+    ++Stats.Accepted;
+    return true;
+}
+
+double FProxyReplayCache::EstimateFalsePositiveRate() const
+{
+    // Per bucket: (1 - e^(-k n / m))^k with m = bits per block, n = inserts per block. A lookup checks every live bucket.
+    double PassProbability = 1.0;
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        if (BucketEpoch[Bucket] == INDEX_NONE || BucketInserts[Bucket] == 0)
+        {
+            continue;
+        }
+        const double InsertsPerBlock = (double)BucketInserts[Bucket] / BlocksPerBucket;
+        const double BucketRate = FMath::Pow(1.0 - FMath::Exp(-BloomProbes * InsertsPerBlock / (WordsPerBlock * 64)), (double)BloomProbes);
+        PassProbability *= 1.0 - BucketRate;
+    }
+    return 1.0 - PassProbability;
+}
+
+FProxyReplayCacheStats FProxyReplayCache::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    FProxyReplayCacheStats Result = Stats;
+    Result.EstimatedFalsePositiveRate = EstimateFalsePositiveRate();
+    return Result;
+}
@@ -0,0 +1,83 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FProxyReplayCacheStats
+{
+    uint64 Checks = 0;
+    uint64 Accepted = 0;
+    uint64 ExactReplays = 0;  // Found in the exact recent-set, certainly a replay
+    uint64 FilterReplays = 0; // Only the Bloom filters matched: an older replay or a false positive
+    double EstimatedFalsePositiveRate = 0.0; // Of the Bloom filters at their current fill
+};
+
+/**
+ * Remembers consumed join tokens (playerID, timeStamp, sessionSecret) for WindowSeconds, in constant memory.
+ *
+ *  - Exact recent-set: open-addressed table of 64-bit token fingerprints with their insert time. It answers
+ *    most replays exactly, stale slots are reused and a full probe window evicts its oldest slot.
+ *  - Time-bucketed blocked Bloom filters: NumBuckets filters, each covering WindowSeconds / (NumBuckets - 1).
+ *    They remember everything inside the window that the exact set had to evict. The oldest bucket is
+ *    cleared as time moves on. A lookup touches one cache line per bucket.
+ * A token is accepted (and recorded) only if neither structure has seen it. Thread-safe.
+ */
+class P_PROXYSERVER_API FProxyReplayCache
+{
+public:
+    static constexpr int32 NumBuckets = 4;
+
+    FProxyReplayCache(int32 InWindowSeconds, int32 ExpectedTokensPerWindow, int32 ExactCapacity);
+
+    // True (and the token is recorded) on first use, false for a replay
+    bool CheckAndInsert(const FString &PlayerId, int64 TimeStamp, const FString &SessionSecret, int64 NowUnixSeconds);
+
+    FProxyReplayCacheStats GetStats() const;
+
+private:
+    static constexpr int32 BloomProbes = 12;
+
+    struct FFingerprint
+    {
+        uint64 Id;      // Exact-set key (never 0)
+        uint64 Block;   // Bloom block selector
+        uint16 Bits[BloomProbes]; // Bloom bit positions inside the block
+    };
+
+    struct FExactSlot
+    {
+        uint64 Id = 0;
+        int64 InsertedAt = 0;
+    };
+
+    static FFingerprint MakeFingerprint(const FString &PlayerId, int64 TimeStamp, const FString &SessionSecret);
+
+    void RotateBuckets(int64 NowUnixSeconds);
+    bool ExactContains(uint64 Id, int64 NowUnixSeconds) const;
+    void ExactInsert(uint64 Id, int64 NowUnixSeconds);
+    bool FilterContains(const FFingerprint &Fingerprint) const;
+    void FilterInsert(const FFingerprint &Fingerprint);
+    double EstimateFalsePositiveRate() const;
+
+    mutable FCriticalSection Lock;
+
+    int32 WindowSeconds;
+    int32 BucketSeconds;
+
+    // Bloom filters, 512-bit blocks (one cache line)
+    static constexpr int32 WordsPerBlock = 8;
+    int32 BlocksPerBucket;
+    TArray<uint64> FilterWords[NumBuckets];
+    int64 BucketEpoch[NumBuckets];
+    uint64 BucketInserts[NumBuckets];
+
+    TArray<FExactSlot> ExactSlots;
+    uint32 ExactMask;
+
+    FProxyReplayCacheStats Stats;
+};
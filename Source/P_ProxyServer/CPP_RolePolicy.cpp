@@ -0,0 +1,85 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_RolePolicy.h"
+
+FProxyRolePolicyPtr FProxyRolePolicy::Compile(const TArray<FString> &RequiresAnyOf, const TArray<FString> &RestrictedRoles,
+                                              const TArray<FString> &RequiresAllOf, FString &OutError)
+{
+    TSharedPtr<FProxyRolePolicy, ESPMode::ThreadSafe> Policy = MakeShareable(new FProxyRolePolicy());
+
+    bool bOk = true;
+    for (const FString &Role : RequiresAnyOf)
+    {
+        bOk &= Policy->Intern(Role, Policy->AnyOfMask);
+    }
+    for (const FString &Role : RestrictedRoles)
+    {
+        bOk &= Policy->Intern(Role, Policy->RestrictedMask);
+    }
+    for (const FString &Role : RequiresAllOf)
+    {
+        bOk &= Policy->Intern(Role, Policy->AllOfMask);
+    }
+
+    if (!bOk)
+    {
+        OutError = FString::Printf(TEXT("Role policy names more than %d distinct roles"), MaxRoles);
+        return nullptr;
+    }
+    return Policy;
+}
+
+bool FProxyRolePolicy::Intern(const FString &Role, FProxyRoleMask &InOutMask)
+{
+    int32 Bit;
+    if (const int32 *Found = RoleBits.Find(Role))
+    {
+        Bit = *Found;
+    }
+    else
+    {
+        if (RoleBits.Num() >= MaxRoles)
+        {
+            return false;
+        }
+        Bit = RoleBits.Num();
+        RoleBits.Add(Role, Bit);
+    }
+
+    InOutMask |= FProxyRoleMask(1) << Bit;
+    return true;
+}
+
+FProxyRoleMask FProxyRolePolicy::ComputeMask(const TArray<FString> &Roles) const
+{
+    FProxyRoleMask Mask = 0;
+    for (const FString &Role : Roles)
+    {
+        if (const int32 *Bit = RoleBits.Find(Role))
+        {
+            Mask |= FProxyRoleMask(1) << *Bit;
+        }
+    }
+    return Mask;
+}
+
+EProxyRoleDecision FProxyRolePolicy::Evaluate(FProxyRoleMask PlayerMask) const
+{
+    if (PlayerMask & RestrictedMask)
+    {
+        return EProxyRoleDecision::Restricted;
+    }
+    if (!(PlayerMask & AnyOfMask))
+    {
+        return EProxyRoleDecision::NoAllowedRole;
+    }
+    if ((PlayerMask & AllOfMask) != AllOfMask)
+    {
+        return EProxyRoleDecision::MissingRequiredRole;
+    }
+    return EProxyRoleDecision::Allowed;
+}
@@ -0,0 +1,60 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FProxyRolePolicy;
+typedef TSharedPtr<const FProxyRolePolicy, ESPMode::ThreadSafe> FProxyRolePolicyPtr;
+
+// One bit per interned role
+typedef uint64 FProxyRoleMask;
+
+enum class EProxyRoleDecision : uint8
+{
+    Allowed,
+    Restricted,         // Holds a role from the deny list
+    NoAllowedRole,      // Holds none of the "requires any of" roles
+    MissingRequiredRole // Lacks one of the "requires all of" roles
+};
+
+/**
+ * Role lists compiled into bitmasks. Every role named by the policy is interned to a bit, a player's
+ * roles are turned into a mask with one hash lookup per role, and the decision is then a few AND / compare ops.
+ * Roles the policy does not mention map to no bit and cannot affect the decision.
+ *
+ * Role names compare case-insensitively, same as the TArray<FString>::Contains checks this replaces.
+ * A compiled policy is immutable, so it can be shared across threads and swapped atomically.
+ */
+class P_PROXYSERVER_API FProxyRolePolicy
+{
+public:
+    static constexpr int32 MaxRoles = 64;
+
+    // Returns null (with OutError set) if the lists name more than MaxRoles distinct roles
+    static FProxyRolePolicyPtr Compile(const TArray<FString> &RequiresAnyOf, const TArray<FString> &RestrictedRoles,
+                                       const TArray<FString> &RequiresAllOf, FString &OutError);
+
+    FProxyRoleMask ComputeMask(const TArray<FString> &Roles) const;
+
+    // An empty "requires any of" list admits nobody, matching the original AllowedRole_List behaviour
+    EProxyRoleDecision Evaluate(FProxyRoleMask PlayerMask) const;
+
+    EProxyRoleDecision Evaluate(const TArray<FString> &Roles) const { return Evaluate(ComputeMask(Roles)); }
+
+    int32 GetNumRoles() const { return RoleBits.Num(); }
+
+private:
+    FProxyRolePolicy() = default;
+
+    bool Intern(const FString &Role, FProxyRoleMask &InOutMask);
+
+    TMap<FString, int32> RoleBits;
+    FProxyRoleMask AnyOfMask = 0;
+    FProxyRoleMask RestrictedMask = 0;
+    FProxyRoleMask AllOfMask = 0;
+};
@@ -0,0 +1,418 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_RsaKey.h"
+#include "CPP_Sha256.h"
+#include "CPP_Metrics.h"
+#include "Containers/LruCache.h"
+#include "Misc/Base64.h"
+#include "Misc/ScopeLock.h"
+
+// OpenSSL Includes
+#define UI UI_STUB
+#include "openssl/rsa.h"
+#include "openssl/pem.h"
+#include "openssl/err.h"
+#include "openssl/bio.h"
+#include "openssl/evp.h"
+#include "openssl/rand.h"
+#include "openssl/crypto.h"
+#undef UI
+
+namespace
+{
+    const FProxyHistogram RsaEncryptLatency(TEXT("proxy_rsa_seconds"), TEXT("op=\"encrypt\""), TEXT("RSA-OAEP operation latency"));
+    const FProxyHistogram RsaDecryptLatency(TEXT("proxy_rsa_seconds"), TEXT("op=\"decrypt\""), TEXT("RSA-OAEP operation latency"));
+
+    // Punal Manalan, NOTE: Servers only ever hold a handful of keys (Global + Local, plus a rotation or two)
+    static constexpr int32 RsaKeyCacheSize = 16;
+
+    // Envelope layout, see FRsaKey::SealEnvelope
+    static constexpr int32 EnvelopeKeySize = 32;
+    static constexpr int32 EnvelopeIvSize = 12;
+    static constexpr int32 EnvelopeTagSize = 16;
+    static constexpr int32 EnvelopeHeaderSize = 3;
+
+    // One-shot AES-256-GCM, EVP picks AES-NI / ARMv8 AES when available
+    static bool aes_gcm_crypt(bool bEncrypt, const uint8 *Key, const uint8 *Iv, const uint8 *Aad, int32 AadLength,
+                              const uint8 *In, int32 InLength, uint8 *Out, uint8 *Tag)
+    {
+        EVP_CIPHER_CTX *Ctx = EVP_CIPHER_CTX_new();
+        if (!Ctx)
+        {
+            return false;
+        }
+
+        // Separate lengths: the AAD update reports the AAD length, which is not an offset into Out
+        int AadOutLength = 0;
+        int OutLength = 0;
+        int FinalLength = 0;
+        bool bOk = EVP_CipherInit_ex(Ctx, EVP_aes_256_gcm(), NULL, NULL, NULL, bEncrypt ? 1 : 0) == 1 &&
+                   EVP_CIPHER_CTX_ctrl(Ctx, EVP_CTRL_GCM_SET_IVLEN, EnvelopeIvSize, NULL) == 1 &&
+                   EVP_CipherInit_ex(Ctx, NULL, NULL, Key, Iv, -1) == 1 &&
+                   EVP_CipherUpdate(Ctx, NULL, &AadOutLength, Aad, AadLength) == 1 &&
+                   (InLength == 0 || EVP_CipherUpdate(Ctx, Out, &OutLength, In, InLength) == 1);
+
+        if (bOk && !bEncrypt)
+        {
+            // Expected tag must be set before finalising, Final then fails on mismatch
+            bOk = EVP_CIPHER_CTX_ctrl(Ctx, EVP_CTRL_GCM_SET_TAG, EnvelopeTagSize, Tag) == 1;
+        }
+        bOk = bOk && EVP_CipherFinal_ex(Ctx, Out + OutLength, &FinalLength) == 1;
+        if (bOk && bEncrypt)
+        {
+            bOk = EVP_CIPHER_CTX_ctrl(Ctx, EVP_CTRL_GCM_GET_TAG, EnvelopeTagSize, Tag) == 1;
+        }
+
+        EVP_CIPHER_CTX_free(Ctx);
+        if (!bOk)
+        {
+            ERR_clear_error();
+        }
+        return bOk;
+    }
+
+    struct FRsaKeyCache
+    {
+        FCriticalSection Lock;
+        TLruCache<FString, FRsaKeyPtr> PublicKeys{RsaKeyCacheSize};
+        TLruCache<FString, FRsaKeyPtr> PrivateKeys{RsaKeyCacheSize};
+    };
+
+    static FRsaKeyCache &rsa_key_cache()
+    {
+        static FRsaKeyCache Cache;
+        return Cache;
+    }
+
+    static FRsaKeyPtr find_or_load(const FString &PEM, bool bPrivate)
+    {
+        if (PEM.IsEmpty())
+        {
+            return nullptr;
+        }
+
+        // Key by the PEM's hash rather than the PEM itself, FString map keys compare case-insensitively
+        uint8 Digest[FSha256Context::DigestSize];
+        FSha256Context Context;
+        Context.UpdateString(PEM);
+        Context.Final(Digest);
+        const FString CacheKey = FSha256Context::DigestToHex(Digest);
+
+        FRsaKeyCache &Cache = rsa_key_cache();
+        TLruCache<FString, FRsaKeyPtr> &Keys = bPrivate ? Cache.PrivateKeys : Cache.PublicKeys;
+        {
+            FScopeLock ScopeLock(&Cache.Lock);
+            if (const FRsaKeyPtr *Found = Keys.FindAndTouch(CacheKey))
+            {
+                return *Found;
+            }
+        }
+
+        // Parse outside the lock, a racing thread parsing the same PEM just produces an identical key
+        FRsaKeyPtr Loaded = bPrivate ? FRsaKey::LoadPrivateKey(PEM) : FRsaKey::LoadPublicKey(PEM);
+        if (Loaded.IsValid())
+        {
+            FScopeLock ScopeLock(&Cache.Lock);
+            Keys.Add(CacheKey, Loaded);
+        }
+        return Loaded;
+    }
+} // anonymous namespace
+
+FRsaKey::FRsaKey(rsa_st *InRsa, bool bInIsPrivate)
+    : Rsa(InRsa), bIsPrivate(bInIsPrivate)
+{
+}
+
+FRsaKey::~FRsaKey()
+{
+    if (Rsa)
+    {
+        RSA_free(Rsa);
+        Rsa = nullptr;
+    }
+}
+
+FRsaKeyPtr FRsaKey::LoadPublicKey(const FString &PublicKeyPEM)
+{
+    if (PublicKeyPEM.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // Convert PEM string to BIO
+    FTCHARToUTF8 KeyConverter(*PublicKeyPEM);
+    BIO *KeyBio = BIO_new_mem_buf((void *)KeyConverter.Get(), KeyConverter.Length());
+    if (!KeyBio)
+    {
+        return nullptr;
+    }
+
+    // Read Public Key
+    RSA *RsaKey = PEM_read_bio_RSA_PUBKEY(KeyBio, NULL, NULL, NULL);
+    if (!RsaKey)
+    {
+        // Try reading as RSAPublicKey (PKCS#1) if PUBKEY (SubjectPublicKeyInfo) fails
+        BIO_reset(KeyBio);
+        RsaKey = PEM_read_bio_RSAPublicKey(KeyBio, NULL, NULL, NULL);
+    }
+
+    BIO_free(KeyBio);
+
+    if (!RsaKey)
+    {
+        ERR_clear_error();
+        return nullptr;
+    }
+    return FRsaKeyPtr(new FRsaKey(RsaKey, false));
+}
+
+FRsaKeyPtr FRsaKey::LoadPrivateKey(const FString &PrivateKeyPEM)
+{
+    if (PrivateKeyPEM.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // Convert PEM string to BIO
+    FTCHARToUTF8 KeyConverter(*PrivateKeyPEM);
+    BIO *KeyBio = BIO_new_mem_buf((void *)KeyConverter.Get(), KeyConverter.Length());
+    if (!KeyBio)
+    {
+        return nullptr;
+    }
+
+    // Read Private Key
+    RSA *RsaKey = PEM_read_bio_RSAPrivateKey(KeyBio, NULL, NULL, NULL);
+    BIO_free(KeyBio);
+
+    if (!RsaKey)
+    {
+        ERR_clear_error();
+        return nullptr;
+    }
+    return FRsaKeyPtr(new FRsaKey(RsaKey, true));
+}
+
+FRsaKeyPtr FRsaKey::FindOrLoadPublicKey(const FString &PublicKeyPEM)
+{
+    return find_or_load(PublicKeyPEM, false);
+}
+
+FRsaKeyPtr FRsaKey::FindOrLoadPrivateKey(const FString &PrivateKeyPEM)
+{
+    return find_or_load(PrivateKeyPEM, true);
+}
+
+int32 FRsaKey::GetSize() const
+{
+    return Rsa ? RSA_size(Rsa) : 0;
+}
+
+bool FRsaKey::EncryptOaep(const uint8 *Data, int32 Length, TArray<uint8> &OutEncrypted) const
+{
+    FProxyScopedLatency Latency(RsaEncryptLatency);
+    OutEncrypted.Reset();
+    if (!Rsa || Length > GetMaxOaepPlaintextSize())
+    {
+        // Data too large for RSA key
+        return false;
+    }
+
+    OutEncrypted.SetNumUninitialized(RSA_size(Rsa));
+    const int32 EncryptedLength = RSA_public_encrypt(Length, Data, OutEncrypted.GetData(), Rsa, RSA_PKCS1_OAEP_PADDING);
+    if (EncryptedLength == -1)
+    {
+        ERR_clear_error();
+        OutEncrypted.Reset();
+        return false;
+    }
+
+    OutEncrypted.SetNum(EncryptedLength);
+    return true;
+}
+
+bool FRsaKey::DecryptOaep(const uint8 *Data, int32 Length, TArray<uint8> &OutDecrypted) const
+{
+    FProxyScopedLatency Latency(RsaDecryptLatency);
+    OutDecrypted.Reset();
+    if (!Rsa || !bIsPrivate)
+    {
+        return false;
+    }
+
+    OutDecrypted.SetNumUninitialized(RSA_size(Rsa));
+    const int32 DecryptedLength = RSA_private_decrypt(Length, Data, OutDecrypted.GetData(), Rsa, RSA_PKCS1_OAEP_PADDING);
+    if (DecryptedLength == -1)
+    {
+        ERR_clear_error();
+        OutDecrypted.Reset();
+        return false;
+    }
+
+    OutDecrypted.SetNum(DecryptedLength);
+    return true;
+}
+
+FString FRsaKey::EncryptString(const FString &Content) const
+{
+    if (Content.IsEmpty())
+    {
+        return FString();
+    }
+
+    FTCHARToUTF8 DataConverter(*Content);
+    TArray<uint8> EncryptedData;
+    if (!EncryptOaep((const uint8 *)DataConverter.Get(), DataConverter.Length(), EncryptedData))
+    {
+        return FString();
+    }
+
+    // Encode to Base64
+    return FBase64::Encode(EncryptedData.GetData(), EncryptedData.Num());
+}
+
+FString FRsaKey::DecryptString(const FString &EncryptedBase64) const
+{
+    if (EncryptedBase64.IsEmpty())
+    {
+        return FString();
+    }
+
+    TArray<uint8> EncryptedData;
+    if (!FBase64::Decode(EncryptedBase64, EncryptedData))
+    {
+        return FString();
+    }
+
+    TArray<uint8> DecryptedData;
+    if (!DecryptOaep(EncryptedData.GetData(), EncryptedData.Num(), DecryptedData))
+    {
+        return FString();
+    }
+
+    // Convert result to FString (UTF8)
+    return FString(FUTF8ToTCHAR((const ANSICHAR *)DecryptedData.GetData(), DecryptedData.Num()));
+}
+
+bool FRsaKey::SealEnvelope(const uint8 *Data, int32 Length, TArray<uint8> &OutEnvelope) const
+{
+    OutEnvelope.Reset();
+    if (!Rsa || Length < 0)
+    {
+        return false;
+    }
+
+    uint8 SessionKey[EnvelopeKeySize];
+    uint8 Iv[EnvelopeIvSize];
+    if (RAND_bytes(SessionKey, EnvelopeKeySize) != 1 || RAND_bytes(Iv, EnvelopeIvSize) != 1)
+    {
+        ERR_clear_error();
+        return false;
+    }
+
+    TArray<uint8> WrappedKey;
+    if (!EncryptOaep(SessionKey, EnvelopeKeySize, WrappedKey))
+    {
+        OPENSSL_cleanse(SessionKey, EnvelopeKeySize);
+        return false;
+    }
+
+    const int32 WrappedKeyLength = WrappedKey.Num();
+    OutEnvelope.SetNumUninitialized(EnvelopeHeaderSize + WrappedKeyLength + EnvelopeIvSize + Length + EnvelopeTagSize);
+    uint8 *Out = OutEnvelope.GetData();
+    Out[0] = EnvelopeVersion;
+    Out[1] = (uint8)(WrappedKeyLength >> 8);
+    Out[2] = (uint8)(WrappedKeyLength & 0xFF);
+    FMemory::Memcpy(Out + EnvelopeHeaderSize, WrappedKey.GetData(), WrappedKeyLength);
+
+    uint8 *IvOut = Out + EnvelopeHeaderSize + WrappedKeyLength;
+    FMemory::Memcpy(IvOut, Iv, EnvelopeIvSize);
+    uint8 *CipherOut = IvOut + EnvelopeIvSize;
+
+    const bool bOk = aes_gcm_crypt(true, SessionKey, Iv, Out, EnvelopeHeaderSize, Data, Length, CipherOut, CipherOut + Length);
+    OPENSSL_cleanse(SessionKey, EnvelopeKeySize);
+    if (!bOk)
+    {
+        OutEnvelope.Reset();
+    }
+    return bOk;
+}
+
+bool FRsaKey::OpenEnvelope(const uint8 *Envelope, int32 Length, TArray<uint8> &OutData) const
+{
+    OutData.Reset();
+    if (!Rsa || !bIsPrivate || Length < EnvelopeHeaderSize || Envelope[0] != EnvelopeVersion)
+    {
+        return false;
+    }
+
+    const int32 WrappedKeyLength = ((int32)Envelope[1] << 8) | Envelope[2];
+    const int32 CipherLength = Length - EnvelopeHeaderSize - WrappedKeyLength - EnvelopeIvSize - EnvelopeTagSize;
+    if (WrappedKeyLength != GetSize() || CipherLength < 0)
+    {
+        return false;
+    }
+
+    TArray<uint8> SessionKey;
+    if (!DecryptOaep(Envelope + EnvelopeHeaderSize, WrappedKeyLength, SessionKey) || SessionKey.Num() != EnvelopeKeySize)
+    {
+        return false;
+    }
+
+    const uint8 *Iv = Envelope + EnvelopeHeaderSize + WrappedKeyLength;
+    const uint8 *Cipher = Iv + EnvelopeIvSize;
+    uint8 Tag[EnvelopeTagSize];
+    FMemory::Memcpy(Tag, Cipher + CipherLength, EnvelopeTagSize);
+
+    OutData.SetNumUninitialized(CipherLength);
+    const bool bOk = aes_gcm_crypt(false, SessionKey.GetData(), Iv, Envelope, EnvelopeHeaderSize, Cipher, CipherLength, OutData.GetData(), Tag);
+    OPENSSL_cleanse(SessionKey.GetData(), SessionKey.Num());
+    if (!bOk)
+    {
+        // Never hand out plaintext that failed authentication
+        OutData.Reset();
+    }
+    return bOk;
+}
+
+FString FRsaKey::SealString(const FString &Content) const
+{
+    if (Content.IsEmpty())
+    {
+        return FString();
+    }
+
+    FTCHARToUTF8 DataConverter(*Content);
+    TArray<uint8> Envelope;
+    if (!SealEnvelope((const uint8 *)DataConverter.Get(), DataConverter.Length(), Envelope))
+    {
+        return FString();
+    }
+    return FBase64::Encode(Envelope.GetData(), Envelope.Num());
+}
+
+FString FRsaKey::OpenString(const FString &EnvelopeBase64) const
+{
+    if (EnvelopeBase64.IsEmpty())
+    {
+        return FString();
+    }
+
+    TArray<uint8> Envelope;
+    if (!FBase64::Decode(EnvelopeBase64, Envelope))
+    {
+        return FString();
+    }
+
+    TArray<uint8> Data;
+    if (!OpenEnvelope(Envelope.GetData(), Envelope.Num(), Data))
+    {
+        return FString();
+    }
+    return FString(FUTF8ToTCHAR((const ANSICHAR *)Data.GetData(), Data.Num()));
+}
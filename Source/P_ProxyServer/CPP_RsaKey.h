@@ -0,0 +1,74 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// OpenSSL's RSA type, forward declared so this header does not pull in OpenSSL
+struct rsa_st;
+
+class FRsaKey;
+typedef TSharedPtr<const FRsaKey, ESPMode::ThreadSafe> FRsaKeyPtr;
+
+/**
+ * RSA key parsed once from PEM and then reused for every encrypt / decrypt (OAEP padding).
+ *
+ * Thread safety: an FRsaKey is immutable after loading. OpenSSL 1.1+ serialises its lazily built
+ * blinding and Montgomery state internally, so the same key may be used from any number of threads
+ * at once. Hold it through FRsaKeyPtr; the key is freed when the last reference goes away.
+ */
+class P_PROXYSERVER_API FRsaKey
+{
+public:
+    ~FRsaKey();
+
+    // Accepts SubjectPublicKeyInfo ("BEGIN PUBLIC KEY") or PKCS#1 ("BEGIN RSA PUBLIC KEY")
+    static FRsaKeyPtr LoadPublicKey(const FString &PublicKeyPEM);
+    static FRsaKeyPtr LoadPrivateKey(const FString &PrivateKeyPEM);
+
+    // Same as Load*, but parsed keys are shared through a small process-wide cache keyed by the PEM's SHA-256
+    static FRsaKeyPtr FindOrLoadPublicKey(const FString &PublicKeyPEM);
+    static FRsaKeyPtr FindOrLoadPrivateKey(const FString &PrivateKeyPEM);
+
+    bool IsPrivate() const { return bIsPrivate; }
+
+    // Modulus size in bytes
+    int32 GetSize() const;
+
+    // Largest plaintext a single OAEP block can carry
+    int32 GetMaxOaepPlaintextSize() const { return GetSize() - 42; }
+
+    // Raw OAEP operations. Decrypt requires a private key.
+    bool EncryptOaep(const uint8 *Data, int32 Length, TArray<uint8> &OutEncrypted) const;
+    bool DecryptOaep(const uint8 *Data, int32 Length, TArray<uint8> &OutDecrypted) const;
+
+    // String helpers: UTF-8 in, Base64 out (and back). Return an empty string on failure.
+    FString EncryptString(const FString &Content) const;
+    FString DecryptString(const FString &EncryptedBase64) const;
+
+    /**
+     * Hybrid envelope for payloads of any size: a fresh AES-256-GCM key per message, wrapped with RSA-OAEP.
+     * Wire format (all integers big endian):
+     *   [1] Version (EnvelopeVersion) | [2] Wrapped Key Length | [N] Wrapped Key | [12] IV | [..] Ciphertext | [16] GCM Tag
+     * The header bytes are authenticated as GCM AAD. Open requires a private key and fails on any tampering.
+     */
+    static constexpr uint8 EnvelopeVersion = 1;
+    bool SealEnvelope(const uint8 *Data, int32 Length, TArray<uint8> &OutEnvelope) const;
+    bool OpenEnvelope(const uint8 *Envelope, int32 Length, TArray<uint8> &OutData) const;
+
+    // String helpers for the envelope: UTF-8 in, Base64 out (and back). Return an empty string on failure.
+    FString SealString(const FString &Content) const;
+    FString OpenString(const FString &EnvelopeBase64) const;
+
+    rsa_st *GetNativeKey() const { return Rsa; }
+
+private:
+    FRsaKey(rsa_st *InRsa, bool bInIsPrivate);
+
+    rsa_st *Rsa;
+    bool bIsPrivate;
+};
@@ -0,0 +1,355 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_RsaKeyPool.h"
+#include "CPP_BPL__ProxyServer.h"
+#include "CPP_RsaKey.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    static const TCHAR *PublicKeyMarker = TEXT("-----BEGIN PUBLIC KEY-----");
+
+    // Owner-only directory, so other local users cannot list or read the key files
+    static bool make_private_directory(const FString &Directory)
+    {
+        if (!IFileManager::Get().MakeDirectory(*Directory, true))
+        {
+            return false;
+        }
+#if PLATFORM_UNIX || PLATFORM_MAC
+        return chmod(TCHAR_TO_UTF8(*Directory), S_IRWXU) == 0;
+#else
+        return true;
+#endif
+    }
+
+    // The file is created owner read/write only before any key byte is written to it
+    static bool write_private_file(const FString &FullPath, const FString &Content)
+    {
+#if PLATFORM_UNIX || PLATFORM_MAC
+        const int File = open(TCHAR_TO_UTF8(*FullPath), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if (File < 0)
+        {
+            return false;
+        }
+
+        const FTCHARToUTF8 Utf8(*Content);
+        const char *Data = Utf8.Get();
+        int64 Remaining = Utf8.Length();
+        while (Remaining > 0)
+        {
+            const ssize_t Written = write(File, Data, Remaining);
+            if (Written <= 0)
+            {
+                close(File);
+                unlink(TCHAR_TO_UTF8(*FullPath));
+                return false;
+            }
+            Data += Written;
+            Remaining -= Written;
+        }
+        return close(File) == 0;
+#else
+        // Punal Manalan, NOTE: Other platforms inherit the directory ACL, keep the Saved Dir private to the server account
+        return FFileHelper::SaveStringToFile(Content, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+#endif
+    }
+} // anonymous namespace
+
+FProxyRsaKeyPool &FProxyRsaKeyPool::Get()
+{
+    static TSharedRef<FProxyRsaKeyPool, ESPMode::ThreadSafe> Instance = MakeShared<FProxyRsaKeyPool, ESPMode::ThreadSafe>();
+    return *Instance;
+}
+
+void FProxyRsaKeyPool::Configure(int32 InKeySizeInBits, int32 InTargetSize, const FString &InPersistDirectory)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        const bool bDirectoryChanged = PersistDirectory != InPersistDirectory;
+
+        KeySizeInBits = InKeySizeInBits;
+        TargetSize = FMath::Max(0, InTargetSize);
+        PersistDirectory = InPersistDirectory;
+
+        if (bDirectoryChanged && !PersistDirectory.IsEmpty())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("RsaKeyPool: ******** Persisting UNENCRYPTED RSA private keys to %s ********"), *PersistDirectory);
+            UE_LOG(LogTemp, Warning, TEXT("RsaKeyPool: Anyone who can read that directory can decrypt join tokens sent to this server"));
+            if (make_private_directory(PersistDirectory))
+            {
+                LoadPersistedPairs();
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("RsaKeyPool: Could not create or restrict %s, keys stay in memory only"), *PersistDirectory);
+                PersistDirectory.Empty();
+            }
+        }
+        DiscardMismatchedPairsLocked();
+    }
+
+    bShuttingDown = false;
+    KickRefill();
+}
+
+bool FProxyRsaKeyPool::TryTake(FRsaKeyPairPEM &OutPair)
+{
+    FString File;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (Ready.Num() == 0)
+        {
+            return false;
+        }
+        OutPair = Ready.Pop();
+        File = ReadyFiles.Pop();
+    }
+
+    if (!File.IsEmpty())
+    {
+        IFileManager::Get().Delete(*File, false, false, true);
+    }
+    KickRefill();
+    return true;
+}
+
+void FProxyRsaKeyPool::TakeAsync(FOnKeyPairReady OnReady)
+{
+    FRsaKeyPairPEM Pair;
+    if (TryTake(Pair))
+    {
+        AsyncTask(ENamedThreads::GameThread, [Callback = MoveTemp(OnReady), Pair]()
+                  { Callback(Pair); });
+        return;
+    }
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        Waiters.Add(MoveTemp(OnReady));
+    }
+    KickRefill();
+}
+
+int32 FProxyRsaKeyPool::GetNumReady() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Ready.Num();
+}
+
+void FProxyRsaKeyPool::Shutdown()
+{
+    bShuttingDown = true;
+}
+
+bool FProxyRsaKeyPool::NeedsRefill() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Waiters.Num() > 0 || Ready.Num() < TargetSize;
+}
+
+void FProxyRsaKeyPool::KickRefill()
+{
+    if (bShuttingDown || !NeedsRefill())
+    {
+        return;
+    }
+
+    bool bExpected = false;
+    if (!bRefillRunning.compare_exchange_strong(bExpected, true))
+    {
+        // A worker is already generating, it re-checks the pool after every key
+        return;
+    }
+
+    Async(EAsyncExecution::ThreadPool, [Self = AsShared()]()
+          { Self->RefillWorker(); });
+}
+
+void FProxyRsaKeyPool::RefillWorker()
+{
+    int32 FailedAttempts = 0;
+    while (!bShuttingDown && NeedsRefill())
+    {
+        int32 Bits;
+        {
+            FScopeLock ScopeLock(&Lock);
+            Bits = KeySizeInBits;
+        }
+
+        FRsaKeyPairPEM Pair;
+        Pair.KeySizeInBits = Bits;
+        UCPP_BPL__ProxyServer::GenerateRsaKeyPair_Cpp(Bits, Pair.PublicKeyPEM, Pair.PrivateKeyPEM);
+        if (!Pair.IsValid())
+        {
+            ++FailedAttempts;
+            UE_LOG(LogTemp, Error, TEXT("RsaKeyPool: Failed to generate a %d bit key pair (attempt %d of %d)"), Bits, FailedAttempts, MaxGenerationAttempts);
+            if (FailedAttempts >= MaxGenerationAttempts)
+            {
+                // Punal Manalan, NOTE: Nobody may wait forever on a key that will not come, the next Take starts over
+                FailWaiters();
+                break;
+            }
+            FPlatformProcess::Sleep(FirstRetryDelaySeconds * (1 << (FailedAttempts - 1)));
+            continue;
+        }
+        FailedAttempts = 0;
+
+        FOnKeyPairReady Waiter;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (Pair.KeySizeInBits != KeySizeInBits)
+            {
+                // Reconfigured to another size while this one was being generated
+                continue;
+            }
+            if (Waiters.Num() > 0)
+            {
+                Waiter = MoveTemp(Waiters[0]);
+                Waiters.RemoveAt(0);
+            }
+        }
+
+        if (Waiter)
+        {
+            AsyncTask(ENamedThreads::GameThread, [Callback = MoveTemp(Waiter), Pair]()
+                      { Callback(Pair); });
+            continue;
+        }
+
+        const FString File = PersistPair(Pair);
+        FScopeLock ScopeLock(&Lock);
+        Ready.Add(MoveTemp(Pair));
+        ReadyFiles.Add(File);
+    }
+
+    const bool bGaveUp = FailedAttempts >= MaxGenerationAttempts;
+    bRefillRunning = false;
+
+    // Someone may have taken a key between our last check and clearing the flag.
+    // After giving up only a caller that arrived meanwhile restarts generation.
+    bool bHasWaiters;
+    {
+        FScopeLock ScopeLock(&Lock);
+        bHasWaiters = Waiters.Num() > 0;
+    }
+    if (!bGaveUp || bHasWaiters)
+    {
+        KickRefill();
+    }
+}
+
+void FProxyRsaKeyPool::FailWaiters()
+{
+    TArray<FOnKeyPairReady> Failed;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Failed = MoveTemp(Waiters);
+        Waiters.Reset();
+    }
+
+    for (FOnKeyPairReady &Waiter : Failed)
+    {
+        AsyncTask(ENamedThreads::GameThread, [Callback = MoveTemp(Waiter)]()
+                  { Callback(FRsaKeyPairPEM()); });
+    }
+}
+
+void FProxyRsaKeyPool::DiscardMismatchedPairsLocked()
+{
+    for (int32 Index = Ready.Num() - 1; Index >= 0; --Index)
+    {
+        if (Ready[Index].KeySizeInBits == KeySizeInBits)
+        {
+            continue;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("RsaKeyPool: Discarding a %d bit key pair, the pool now hands out %d bit keys"), Ready[Index].KeySizeInBits, KeySizeInBits);
+        if (!ReadyFiles[Index].IsEmpty())
+        {
+            IFileManager::Get().Delete(*ReadyFiles[Index], false, false, true);
+        }
+        Ready.RemoveAt(Index);
+        ReadyFiles.RemoveAt(Index);
+    }
+}
+
+void FProxyRsaKeyPool::LoadPersistedPairs()
+{
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *FPaths::Combine(PersistDirectory, TEXT("*.pem")), true, false);
+
+    for (const FString &FileName : Files)
+    {
+        const FString FullPath = FPaths::Combine(PersistDirectory, FileName);
+        FString Content;
+        if (!FFileHelper::LoadFileToString(Content, *FullPath))
+        {
+            continue;
+        }
+
+        // File layout: Private Key PEM followed by Public Key PEM
+        const int32 PublicStart = Content.Find(PublicKeyMarker, ESearchCase::CaseSensitive);
+        if (PublicStart == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("RsaKeyPool: Ignoring malformed key file %s"), *FullPath);
+            continue;
+        }
+
+        FRsaKeyPairPEM Pair;
+        Pair.PrivateKeyPEM = Content.Left(PublicStart).TrimStartAndEnd();
+        Pair.PublicKeyPEM = Content.Mid(PublicStart).TrimStartAndEnd();
+
+        const FRsaKeyPtr PublicKey = FRsaKey::LoadPublicKey(Pair.PublicKeyPEM);
+        if (!PublicKey.IsValid())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("RsaKeyPool: Ignoring unreadable key file %s"), *FullPath);
+            continue;
+        }
+        Pair.KeySizeInBits = PublicKey->GetSize() * 8;
+        Ready.Add(MoveTemp(Pair));
+        ReadyFiles.Add(FullPath);
+    }
+
+    if (Files.Num() > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("RsaKeyPool: Loaded %d persisted key pairs from %s"), Ready.Num(), *PersistDirectory);
+    }
+}
+
+FString FProxyRsaKeyPool::PersistPair(const FRsaKeyPairPEM &Pair) const
+{
+    FString Directory;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Directory = PersistDirectory;
+    }
+    if (Directory.IsEmpty())
+    {
+        return FString();
+    }
+
+    const FString FullPath = FPaths::Combine(Directory, FGuid::NewGuid().ToString() + TEXT(".pem"));
+    if (!write_private_file(FullPath, Pair.PrivateKeyPEM + TEXT("\n") + Pair.PublicKeyPEM))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RsaKeyPool: Failed to persist key pair to %s"), *FullPath);
+        return FString();
+    }
+    return FullPath;
+}
@@ -0,0 +1,80 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+struct FRsaKeyPairPEM
+{
+    FString PublicKeyPEM;
+    FString PrivateKeyPEM;
+    int32 KeySizeInBits = 0;
+
+    // Both PEMs empty = key generation failed
+    bool IsValid() const { return !PublicKeyPEM.IsEmpty() && !PrivateKeyPEM.IsEmpty(); }
+};
+
+/**
+ * Process-wide pool of pre-generated RSA key pairs for the Local server keys.
+ * RSA prime generation runs on a background worker and keeps up to TargetSize pairs ready, so
+ * subsystem creation and key rotation can take a key instantly instead of generating one inline.
+ *
+ * Optionally the ready pairs are persisted (one file each) so a restarted server starts with a full pool.
+ * The files hold unencrypted private keys: the directory and files are owner-only where the platform allows it,
+ * and a pair is handed out once, its file is deleted when it is taken.
+ * Only pairs of the configured key size are handed out, pairs of another size are discarded.
+ *
+ * A failed generation is retried with backoff, after MaxGenerationAttempts failures in a row the pending
+ * TakeAsync callers are answered with an empty pair (see FRsaKeyPairPEM::IsValid).
+ */
+class P_PROXYSERVER_API FProxyRsaKeyPool : public TSharedFromThis<FProxyRsaKeyPool, ESPMode::ThreadSafe>
+{
+public:
+    typedef TFunction<void(const FRsaKeyPairPEM &)> FOnKeyPairReady;
+
+    static FProxyRsaKeyPool &Get();
+
+    // PersistDirectory empty = keep keys in memory only. Also kicks off background generation.
+    void Configure(int32 InKeySizeInBits, int32 InTargetSize, const FString &InPersistDirectory);
+
+    // Non-blocking, false if no pair is ready yet
+    bool TryTake(FRsaKeyPairPEM &OutPair);
+
+    // Hands out a ready pair immediately, or the next one generated. OnReady runs on the game thread.
+    // The pair is empty if generation kept failing.
+    void TakeAsync(FOnKeyPairReady OnReady);
+
+    int32 GetNumReady() const;
+
+    // Stops background generation after the key currently being generated
+    void Shutdown();
+
+private:
+    void KickRefill();
+    void RefillWorker();
+    bool NeedsRefill() const;
+    void DiscardMismatchedPairsLocked();
+    void FailWaiters();
+    void LoadPersistedPairs();
+    FString PersistPair(const FRsaKeyPairPEM &Pair) const;
+
+    mutable FCriticalSection Lock;
+    TArray<FRsaKeyPairPEM> Ready;
+    TArray<FString> ReadyFiles; // Parallel to Ready, empty entry when not persisted
+    TArray<FOnKeyPairReady> Waiters;
+
+    int32 KeySizeInBits = 2048;
+    int32 TargetSize = 2;
+    FString PersistDirectory;
+
+    static constexpr int32 MaxGenerationAttempts = 4;
+    static constexpr float FirstRetryDelaySeconds = 0.5f;
+
+    std::atomic<bool> bRefillRunning{false};
+    std::atomic<bool> bShuttingDown{false};
+};
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CPP_Sha256.h"
+#include "CPP_RsaKey.h"
 #include "CPP_STRUCT__ProxyServer.generated.h"
 
 // Punal Manalan, NOTE: This is Received from the Server Backend when a Player Requests to Join the Server
@@ -42,7 +44,7 @@ struct P_PROXYSERVER_API FSessionJoinTokenEncrypted
     FString signature = "";
 
     /* Punal Manalan, NOTE: The actual Encrypted Session Secret.
-     * this is the Encrypted version of FSessionJoinToken JSON
+     * this is the Encrypted version of FSessionJoinToken JSON (or its binary form, see FJoinTokenBinaryCodec)
      * that is Received from the Player After After Pre Login(Mainly after Post Login, with Timeout).
      */
     UPROPERTY(BlueprintReadWrite, Category = "Punal|Token")
@@ -72,4 +74,142 @@ struct P_PROXYSERVER_API FPlayerData
 
     UPROPERTY(BlueprintReadWrite, Category = "Punal|Player")
     TArray<FString> roles;
-};
\ No newline at end of file
+};
+
+// Blueprint wrapper around the incremental SHA-256 state (see UCPP_BPL__ProxyServer::Sha256_*)
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FSha256StreamContext
+{
+    GENERATED_BODY()
+
+    FSha256Context Context;
+};
+
+// One (Data, Key, ExpectedSignature) tuple for UCPP_BPL__ProxyServer::HmacSha256VerifyBatch
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FHmacSha256VerifyRequest
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite, Category = "Punal|Crypto")
+    FString Data;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Punal|Crypto")
+    FString Key;
+
+    // Lowercase or uppercase hex, as produced by HmacSha256String
+    UPROPERTY(BlueprintReadWrite, Category = "Punal|Crypto")
+    FString ExpectedSignature;
+};
+
+// Blueprint wrapper around a precomputed HMAC-SHA256 key (see UCPP_BPL__ProxyServer::PrepareHmacSha256Key)
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FHmacSha256PreparedKey
+{
+    GENERATED_BODY()
+
+    FHmacSha256Key Key;
+};
+
+// Blueprint handle to a parsed RSA key (see UCPP_BPL__ProxyServer::LoadRsaPublicKey / LoadRsaPrivateKey)
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FRsaKeyHandle
+{
+    GENERATED_BODY()
+
+    FRsaKeyPtr Key;
+};
+// Session table changes since a version (see UCPP_LoginManagerSubsystem::GetPlayerSessionChangesSince)
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FPlayerSessionDelta
+{
+    GENERATED_BODY()
+
+    // Version the caller passes back next time
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    int64 Version = 0;
+
+    // True when the requested version was too old: Upserted then holds the whole table and the caller should drop its copy first
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    bool bIsFullSnapshot = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    TMap<FString, FPlayerData> Upserted;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    TArray<FString> Removed;
+};
+
+// Login admission control metrics (see UCPP_LoginManagerSubsystem::GetAdmissionStats)
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FAdmissionStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    int64 Admitted = 0;
+
+    // Rejected because the address exceeded its login rate
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    int64 ShedPerAddress = 0;
+
+    // Rejected because too many validations were already running
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    int64 ShedGlobal = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Player")
+    int32 InFlight = 0;
+};
+
+// Backend response cache metrics (see UCPP_LoginManagerSubsystem::GetBackendCacheStats)
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FBackendCacheStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Backend")
+    int64 Hits = 0;
+
+    // Hits on a cached "not found / banned" answer
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Backend")
+    int64 NegativeHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Backend")
+    int64 Misses = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Backend")
+    int64 Evictions = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Backend")
+    int64 Invalidations = 0;
+
+    // Answers not cached because the player was invalidated while the request was in flight
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Backend")
+    int64 StalePuts = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Backend")
+    int32 Num = 0;
+};
+
+// Join token replay cache metrics (see UCPP_LoginManagerSubsystem::GetReplayCacheStats)
+USTRUCT(BlueprintType)
+struct P_PROXYSERVER_API FReplayCacheStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Token")
+    int64 Checks = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Token")
+    int64 Accepted = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Token")
+    int64 ExactReplays = 0;
+
+    // Rejected on the Bloom filters alone: older replays plus false positives
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Token")
+    int64 FilterReplays = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Punal|Token")
+    float EstimatedFalsePositiveRate = 0.0f;
+};
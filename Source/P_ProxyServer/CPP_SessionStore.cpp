@@ -0,0 +1,414 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_SessionStore.h"
+#include "Dom/JsonObject.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "HAL/PlatformProcess.h"
+#include "JsonObjectConverter.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FProxySessionKey::FProxySessionKey(const FString &InPlayerId)
+    : PlayerId(InPlayerId), Hash(GetTypeHash(InPlayerId))
+{
+}
+
+FProxySessionKey::FProxySessionKey(FString &&InPlayerId)
+    : PlayerId(MoveTemp(InPlayerId))
+{
+    Hash = GetTypeHash(PlayerId);
+}
+
+FProxySessionKey FProxySessionKey::FromNetId(const FUniqueNetIdRepl &UniqueId)
+{
+    // Punal Manalan, NOTE: Backend Ids are strings, so the Net Id is stringified once here and only here
+    return FProxySessionKey(UniqueId.ToString());
+}
+
+FProxySessionStore::FReadScope::FReadScope(const FShard &InShard)
+    : Shard(InShard)
+{
+    // Announce before loading the pointer: a writer that swapped the pointer after this load
+    // is guaranteed to see the announcement and wait for it
+    Slot = Shard.Epoch.load() & 1;
+    Shard.Readers[Slot].fetch_add(1);
+    Map = Shard.Current.load();
+}
+
+FProxySessionStore::FReadScope::~FReadScope()
+{
+    Shard.Readers[Slot].fetch_sub(1);
+}
+
+FProxySessionStore::FProxySessionStore()
+{
+    for (FShard &Shard : Shards)
+    {
+        Shard.Readers[0] = 0;
+        Shard.Readers[1] = 0;
+        Shard.Current = new FShardMap();
+    }
+    ChangeLog.SetNum(ChangeLogCapacity);
+}
+
+FProxySessionStore::~FProxySessionStore()
+{
+    for (FShard &Shard : Shards)
+    {
+        delete Shard.Current.exchange(nullptr);
+    }
+}
+
+void FProxySessionStore::Publish(FShard &Shard, const FShardMap *NewMap)
+{
+    const FShardMap *OldMap = Shard.Current.exchange(NewMap);
+
+    // Grace period: flip the reader slot twice, draining each slot after it stops receiving new readers.
+    // Every reader that could have loaded OldMap announced itself on one of the two slots before loading it.
+    for (int32 Flip = 0; Flip < 2; ++Flip)
+    {
+        const uint32 DrainSlot = Shard.Epoch.fetch_add(1) & 1;
+        while (Shard.Readers[DrainSlot].load() != 0)
+        {
+            FPlatformProcess::Yield();
+        }
+    }
+
+    delete OldMap;
+}
+
+FProxySessionEntryPtr FProxySessionStore::Find(const FProxySessionKey &Key) const
+{
+    FReadScope Scope(GetShard(Key.Hash));
+    const FProxySessionEntryPtr *Entry = Scope.Get().Find(Key);
+    return Entry ? *Entry : FProxySessionEntryPtr();
+}
+
+void FProxySessionStore::Upsert(const FString &PlayerId, const FPlayerData &Data)
+{
+    FProxySessionKey Key(PlayerId);
+    FProxySessionEntryPtr Entry = MakeShared<const FPlayerData, ESPMode::ThreadSafe>(Data);
+
+    FShard &Shard = GetShard(Key.Hash);
+    FScopeLock ScopeLock(&Shard.WriteLock);
+    FShardMap *NewMap = new FShardMap(*Shard.Current.load());
+    NewMap->Add(MoveTemp(Key), MoveTemp(Entry));
+    Publish(Shard, NewMap);
+    RecordChange(PlayerId);
+}
+
+bool FProxySessionStore::Remove(const FString &PlayerId)
+{
+    return RemoveIf(PlayerId, [](const FPlayerData &)
+                    { return true; });
+}
+
+bool FProxySessionStore::RemoveIf(const FString &PlayerId, TFunctionRef<bool(const FPlayerData &)> Predicate)
+{
+    const FProxySessionKey Key(PlayerId);
+
+    FShard &Shard = GetShard(Key.Hash);
+    FScopeLock ScopeLock(&Shard.WriteLock);
+    const FShardMap *CurrentMap = Shard.Current.load();
+    const FProxySessionEntryPtr *Entry = CurrentMap->Find(Key);
+    if (!Entry || !Predicate(**Entry))
+    {
+        return false;
+    }
+
+    FShardMap *NewMap = new FShardMap(*CurrentMap);
+    NewMap->Remove(Key);
+    Publish(Shard, NewMap);
+    RecordChange(PlayerId);
+    return true;
+}
+
+void FProxySessionStore::ReplaceAll(const TMap<FString, FPlayerData> &NewMap)
+{
+    // Build every shard up front, then publish them one by one
+    FShardMap *NewShards[NumShards];
+    for (int32 Index = 0; Index < NumShards; ++Index)
+    {
+        NewShards[Index] = new FShardMap();
+    }
+    for (const TPair<FString, FPlayerData> &Pair : NewMap)
+    {
+        FProxySessionKey Key(Pair.Key);
+        NewShards[Key.Hash & (NumShards - 1)]->Add(MoveTemp(Key), MakeShared<const FPlayerData, ESPMode::ThreadSafe>(Pair.Value));
+    }
+
+    for (int32 Index = 0; Index < NumShards; ++Index)
+    {
+        FScopeLock ScopeLock(&Shards[Index].WriteLock);
+        Publish(Shards[Index], NewShards[Index]);
+    }
+    RecordReset();
+}
+
+int32 FProxySessionStore::ApplyChanges(const TArray<TPair<FString, FPlayerData>> &Upserts, const TArray<FString> &Removes, TArray<FString> *OutChanged)
+{
+    // Group by shard first so each shard is copied and published at most once
+    TArray<int32> ShardUpserts[NumShards];
+    TArray<int32> ShardRemoves[NumShards];
+    TArray<FProxySessionKey> UpsertKeys;
+    TArray<FProxySessionKey> RemoveKeys;
+    UpsertKeys.Reserve(Upserts.Num());
+    RemoveKeys.Reserve(Removes.Num());
+    for (int32 Index = 0; Index < Upserts.Num(); ++Index)
+    {
+        const FProxySessionKey &Key = UpsertKeys.Emplace_GetRef(Upserts[Index].Key);
+        ShardUpserts[Key.Hash & (NumShards - 1)].Add(Index);
+    }
+    for (int32 Index = 0; Index < Removes.Num(); ++Index)
+    {
+        const FProxySessionKey &Key = RemoveKeys.Emplace_GetRef(Removes[Index]);
+        ShardRemoves[Key.Hash & (NumShards - 1)].Add(Index);
+    }
+
+    UScriptStruct *PlayerDataStruct = FPlayerData::StaticStruct();
+    int32 NumChanged = 0;
+    TArray<FString> Changed;
+    for (int32 ShardIndex = 0; ShardIndex < NumShards; ++ShardIndex)
+    {
+        if (ShardUpserts[ShardIndex].Num() == 0 && ShardRemoves[ShardIndex].Num() == 0)
+        {
+            continue;
+        }
+
+        FShard &Shard = Shards[ShardIndex];
+        FScopeLock ScopeLock(&Shard.WriteLock);
+        FShardMap *NewMap = new FShardMap(*Shard.Current.load());
+        Changed.Reset();
+
+        for (const int32 Index : ShardUpserts[ShardIndex])
+        {
+            const FPlayerData &Data = Upserts[Index].Value;
+            const FProxySessionEntryPtr *Existing = NewMap->Find(UpsertKeys[Index]);
+            if (Existing && PlayerDataStruct->CompareScriptStruct(Existing->Get(), &Data, PPF_None))
+            {
+                continue;
+            }
+            NewMap->Add(UpsertKeys[Index], MakeShared<const FPlayerData, ESPMode::ThreadSafe>(Data));
+            Changed.Add(Upserts[Index].Key);
+        }
+        for (const int32 Index : ShardRemoves[ShardIndex])
+        {
+            if (NewMap->Remove(RemoveKeys[Index]) > 0)
+            {
+                Changed.Add(Removes[Index]);
+            }
+        }
+
+        if (Changed.Num() == 0)
+        {
+            delete NewMap;
+            continue;
+        }
+
+        Publish(Shard, NewMap);
+        for (const FString &PlayerId : Changed)
+        {
+            RecordChange(PlayerId);
+        }
+        NumChanged += Changed.Num();
+        if (OutChanged)
+        {
+            OutChanged->Append(Changed);
+        }
+    }
+    return NumChanged;
+}
+
+int32 FProxySessionStore::SyncTo(const TMap<FString, FPlayerData> &NewMap, TArray<FString> *OutChanged)
+{
+    TArray<TPair<FString, FPlayerData>> Upserts;
+    Upserts.Reserve(NewMap.Num());
+    TSet<FProxySessionKey> Keep;
+    Keep.Reserve(NewMap.Num());
+    for (const TPair<FString, FPlayerData> &Pair : NewMap)
+    {
+        Upserts.Emplace(Pair.Key, Pair.Value);
+        Keep.Add(FProxySessionKey(Pair.Key));
+    }
+
+    TArray<FString> Removes;
+    ForEach([&Keep, &Removes](const FProxySessionKey &Key, const FProxySessionEntryPtr &)
+            {
+                if (!Keep.Contains(Key))
+                {
+                    Removes.Add(Key.PlayerId);
+                } });
+
+    return ApplyChanges(Upserts, Removes, OutChanged);
+}
+
+void FProxySessionStore::ForEach(TFunctionRef<void(const FProxySessionKey &, const FProxySessionEntryPtr &)> Visitor) const
+{
+    for (const FShard &Shard : Shards)
+    {
+        FReadScope Scope(Shard);
+        for (const TPair<FProxySessionKey, FProxySessionEntryPtr> &Pair : Scope.Get())
+        {
+            Visitor(Pair.Key, Pair.Value);
+        }
+    }
+}
+
+void FProxySessionStore::RecordChange(const FString &PlayerId)
+{
+    // Recorded after the shard is published, so whoever sees this version also sees the change
+    FScopeLock ScopeLock(&ChangeLogLock);
+    const uint64 NewVersion = Version.load() + 1;
+
+    FChangeRecord &Record = ChangeLog[ChangeLogNext];
+    if (ChangeLogCount == ChangeLogCapacity)
+    {
+        TruncatedThrough = Record.Version;
+    }
+    else
+    {
+        ++ChangeLogCount;
+    }
+    Record.Version = NewVersion;
+    Record.PlayerId = PlayerId;
+    ChangeLogNext = (ChangeLogNext + 1) % ChangeLogCapacity;
+
+    Version.store(NewVersion);
+}
+
+void FProxySessionStore::RecordReset()
+{
+    // A wholesale replacement is not expressible as a delta, everyone resyncs from the full table
+    FScopeLock ScopeLock(&ChangeLogLock);
+    const uint64 NewVersion = Version.load() + 1;
+    ChangeLogCount = 0;
+    TruncatedThrough = NewVersion;
+    Version.store(NewVersion);
+}
+
+bool FProxySessionStore::GetChangesSince(uint64 SinceVersion, TArray<TPair<FString, FProxySessionEntryPtr>> &OutUpserted, TArray<FString> &OutRemoved, uint64 &OutVersion) const
+{
+    OutUpserted.Reset();
+    OutRemoved.Reset();
+
+    TArray<FString, TInlineAllocator<64>> ChangedIds;
+    {
+        FScopeLock ScopeLock(&ChangeLogLock);
+        OutVersion = Version.load();
+        if (SinceVersion < TruncatedThrough || SinceVersion > OutVersion)
+        {
+            return false;
+        }
+
+        // Walk newest to oldest until we reach what the caller already has
+        for (int32 Offset = 1; Offset <= ChangeLogCount; ++Offset)
+        {
+            const FChangeRecord &Record = ChangeLog[(ChangeLogNext - Offset + ChangeLogCapacity) % ChangeLogCapacity];
+            if (Record.Version <= SinceVersion)
+            {
+                break;
+            }
+            ChangedIds.Add(Record.PlayerId);
+        }
+    }
+
+    // A player changed several times is reported once, with its current state
+    TSet<FString> Seen;
+    Seen.Reserve(ChangedIds.Num());
+    for (const FString &PlayerId : ChangedIds)
+    {
+        bool bAlreadySeen = false;
+        Seen.Add(PlayerId, &bAlreadySeen);
+        if (bAlreadySeen)
+        {
+            continue;
+        }
+
+        if (FProxySessionEntryPtr Entry = Find(PlayerId))
+        {
+            OutUpserted.Emplace(PlayerId, MoveTemp(Entry));
+        }
+        else
+        {
+            OutRemoved.Add(PlayerId);
+        }
+    }
+    return true;
+}
+
+TMap<FString, FPlayerData> FProxySessionStore::ToMap() const
+{
+    TMap<FString, FPlayerData> Result;
+    for (const FShard &Shard : Shards)
+    {
+        FReadScope Scope(Shard);
+        for (const TPair<FProxySessionKey, FProxySessionEntryPtr> &Pair : Scope.Get())
+        {
+            Result.Add(Pair.Key.PlayerId, *Pair.Value);
+        }
+    }
+    return Result;
+}
+
+int32 FProxySessionStore::Num() const
+{
+    int32 Total = 0;
+    for (const FShard &Shard : Shards)
+    {
+        FReadScope Scope(Shard);
+        Total += Scope.Get().Num();
+    }
+    return Total;
+}
+
+bool FProxySessionSyncPayload::Parse(const FString &Json, FProxySessionSyncPayload &Out)
+{
+    Out = FProxySessionSyncPayload();
+
+    TSharedPtr<FJsonObject> Object;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+    if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid() || !Object->TryGetNumberField(TEXT("version"), Out.Version))
+    {
+        return false;
+    }
+    Object->TryGetNumberField(TEXT("baseVersion"), Out.BaseVersion);
+    Object->TryGetBoolField(TEXT("full"), Out.bIsFullSnapshot);
+    Object->TryGetStringArrayField(TEXT("removed"), Out.Removed);
+
+    const TSharedPtr<FJsonObject> *Upserted = nullptr;
+    if (Object->TryGetObjectField(TEXT("upserted"), Upserted))
+    {
+        Out.Upserted.Reserve((*Upserted)->Values.Num());
+        for (const TPair<FString, TSharedPtr<FJsonValue>> &Pair : (*Upserted)->Values)
+        {
+            const TSharedPtr<FJsonObject> *DataObject = nullptr;
+            FPlayerData Data;
+            if (!Pair.Value.IsValid() || !Pair.Value->TryGetObject(DataObject) || !FJsonObjectConverter::JsonObjectToUStruct(DataObject->ToSharedRef(), &Data))
+            {
+                // A half-applied delta would silently diverge from the backend
+                return false;
+            }
+            if (Data.playerID.IsEmpty())
+            {
+                Data.playerID = Pair.Key;
+            }
+            Out.Upserted.Emplace(Pair.Key, MoveTemp(Data));
+        }
+    }
+    return true;
+}
+
+EProxySessionSyncCheck FProxySessionSyncPayload::Check(int64 CurrentVersion) const
+{
+    if (bIsFullSnapshot)
+    {
+        // The same version again is harmless, SyncTo changes nothing
+        return Version < CurrentVersion ? EProxySessionSyncCheck::Stale : EProxySessionSyncCheck::Apply;
+    }
+    return BaseVersion == CurrentVersion ? EProxySessionSyncCheck::Apply : EProxySessionSyncCheck::NeedFullSnapshot;
+}
@@ -0,0 +1,183 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "CPP_STRUCT__ProxyServer.h"
+
+struct FUniqueNetIdRepl;
+
+/**
+ * Player Id with its hash computed once. Build it once per login and reuse it for every lookup,
+ * instead of re-hashing (or re-stringifying the FUniqueNetIdRepl) at each stage.
+ * Matching is case-insensitive, same as the FString keys it replaces.
+ */
+struct P_PROXYSERVER_API FProxySessionKey
+{
+    FString PlayerId;
+    uint32 Hash = 0;
+
+    FProxySessionKey() = default;
+    explicit FProxySessionKey(const FString &InPlayerId);
+    explicit FProxySessionKey(FString &&InPlayerId);
+
+    static FProxySessionKey FromNetId(const FUniqueNetIdRepl &UniqueId);
+
+    bool operator==(const FProxySessionKey &Other) const
+    {
+        return Hash == Other.Hash && PlayerId == Other.PlayerId;
+    }
+
+    friend uint32 GetTypeHash(const FProxySessionKey &Key) { return Key.Hash; }
+};
+
+// What to do with a FProxySessionSyncPayload, given the backend version the table is at
+enum class EProxySessionSyncCheck : uint8
+{
+    Apply,
+    NeedFullSnapshot, // A delta from another base version, only a full snapshot can bring the table back in line
+    Stale             // A snapshot older than what was already applied (e.g. a late answer), applying it would go back
+};
+
+/**
+ * Session table update from the backend, either a delta since BaseVersion or a full snapshot:
+ *   {"version": 12, "baseVersion": 10, "full": false, "upserted": {"<PlayerId>": {FPlayerData}}, "removed": ["<PlayerId>"]}
+ * Versions are the backend's own, unrelated to FProxySessionStore::GetVersion.
+ */
+struct P_PROXYSERVER_API FProxySessionSyncPayload
+{
+    int64 Version = 0;
+    int64 BaseVersion = -1; // -1 = not given, which only a full snapshot may do
+    bool bIsFullSnapshot = false;
+    TArray<TPair<FString, FPlayerData>> Upserted;
+    TArray<FString> Removed;
+
+    // Safe to call off the game thread
+    static bool Parse(const FString &Json, FProxySessionSyncPayload &Out);
+
+    EProxySessionSyncCheck Check(int64 CurrentVersion) const;
+};
+
+// Immutable session entry, an upsert publishes a new entry instead of modifying this one
+typedef TSharedPtr<const FPlayerData, ESPMode::ThreadSafe> FProxySessionEntryPtr;
+
+/**
+ * Session / reservation table: Player Id -> FPlayerData, safe to use from any thread.
+ *
+ * The table is split into shards by key hash. Each shard publishes an immutable map snapshot (RCU style):
+ *  - Readers never lock: they announce themselves on a per-shard counter, load the snapshot pointer and probe it.
+ *    Entries are shared pointers, so a reader can keep an entry after the lookup without copying it.
+ *  - Writers serialise per shard, copy the shard's map (entry pointers only), publish the copy and then wait
+ *    for a grace period (readers of the old snapshot to finish) before freeing it.
+ * Lookups are therefore never blocked by backend updates, and updates to different shards do not contend.
+ */
+class P_PROXYSERVER_API FProxySessionStore
+{
+public:
+    static constexpr int32 NumShards = 16;
+
+    FProxySessionStore();
+    ~FProxySessionStore();
+
+    FProxySessionStore(const FProxySessionStore &) = delete;
+    FProxySessionStore &operator=(const FProxySessionStore &) = delete;
+
+    FProxySessionEntryPtr Find(const FProxySessionKey &Key) const;
+    FProxySessionEntryPtr Find(const FString &PlayerId) const { return Find(FProxySessionKey(PlayerId)); }
+
+    void Upsert(const FString &PlayerId, const FPlayerData &Data);
+    bool Remove(const FString &PlayerId);
+
+    // Removes the entry only if Predicate still holds for it, checked under the shard's write lock
+    bool RemoveIf(const FString &PlayerId, TFunctionRef<bool(const FPlayerData &)> Predicate);
+
+    /**
+     * Zero-copy iteration, one shard snapshot at a time.
+     * Visitor must not modify the store: a writer waits for the visit to finish, so that would deadlock.
+     */
+    void ForEach(TFunctionRef<void(const FProxySessionKey &, const FProxySessionEntryPtr &)> Visitor) const;
+
+    // Bumped by every Upsert / Remove / ReplaceAll
+    uint64 GetVersion() const { return Version.load(); }
+
+    /**
+     * Entries changed since SinceVersion: current entries of upserted players, and ids of removed ones.
+     * The result reflects the table at OutVersion or later (a change racing with the call may show up again next time).
+     * Returns false if the change log no longer reaches back to SinceVersion, the caller should then resync with ToMap().
+     */
+    bool GetChangesSince(uint64 SinceVersion, TArray<TPair<FString, FProxySessionEntryPtr>> &OutUpserted, TArray<FString> &OutRemoved, uint64 &OutVersion) const;
+
+    /**
+     * Many changes at once, with one publish per shard touched. Upserts equal to the current entry are skipped,
+     * so the entry (and any reader holding it) is kept and nothing is recorded for it.
+     * Returns the number of entries that actually changed, their ids go to OutChanged if given.
+     */
+    int32 ApplyChanges(const TArray<TPair<FString, FPlayerData>> &Upserts, const TArray<FString> &Removes, TArray<FString> *OutChanged = nullptr);
+
+    // Makes the table equal to NewMap through ApplyChanges: a snapshot that mostly matches costs next to nothing
+    int32 SyncTo(const TMap<FString, FPlayerData> &NewMap, TArray<FString> *OutChanged = nullptr);
+
+    // Wholesale replacement / export, for the Blueprint TMap getters and setters.
+    // ReplaceAll publishes shard by shard, a concurrent reader may briefly see old and new shards side by side.
+    void ReplaceAll(const TMap<FString, FPlayerData> &NewMap);
+    TMap<FString, FPlayerData> ToMap() const;
+
+    int32 Num() const;
+
+private:
+    typedef TMap<FProxySessionKey, FProxySessionEntryPtr> FShardMap;
+
+    struct FShard
+    {
+        FCriticalSection WriteLock;
+        std::atomic<const FShardMap *> Current{nullptr};
+        std::atomic<uint32> Epoch{0};
+        mutable std::atomic<int32> Readers[2];
+    };
+
+    // Pins a shard's current snapshot for the lifetime of the scope
+    class FReadScope
+    {
+    public:
+        explicit FReadScope(const FShard &InShard);
+        ~FReadScope();
+        const FShardMap &Get() const { return *Map; }
+
+    private:
+        const FShard &Shard;
+        uint32 Slot;
+        const FShardMap *Map;
+    };
+
+    FShard &GetShard(uint32 Hash) { return Shards[Hash & (NumShards - 1)]; }
+    const FShard &GetShard(uint32 Hash) const { return Shards[Hash & (NumShards - 1)]; }
+
+    // Bounded change log backing GetChangesSince, oldest records are overwritten
+    static constexpr int32 ChangeLogCapacity = 4096;
+
+    struct FChangeRecord
+    {
+        uint64 Version = 0;
+        FString PlayerId;
+    };
+
+    void RecordChange(const FString &PlayerId);
+    void RecordReset();
+
+    // WriteLock must be held. Takes ownership of NewMap, frees the old snapshot after the grace period.
+    static void Publish(FShard &Shard, const FShardMap *NewMap);
+
+    FShard Shards[NumShards];
+
+    mutable FCriticalSection ChangeLogLock;
+    TArray<FChangeRecord> ChangeLog; // Ring buffer of ChangeLogCapacity records
+    int32 ChangeLogNext = 0;
+    int32 ChangeLogCount = 0;
+    uint64 TruncatedThrough = 0; // Changes up to this version are no longer in the log
+    std::atomic<uint64> Version{0};
+};
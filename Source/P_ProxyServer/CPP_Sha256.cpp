@@ -0,0 +1,1096 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_Sha256.h"
+#include "CPP_Metrics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include <stdint.h>
+#include <string.h>
+
+// Accelerated compression backends, each one is only used when the CPU reports support at runtime
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_64BITS
+#define PROXY_SHA256_WITH_SHANI 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define PROXY_SHA256_WITH_SHANI 0
+#endif
+
+// Multi-buffer kernels (AVX2 x8, AVX-512 x16 lanes), independent of SHA-NI. The build can turn either off,
+// e.g. -DPROXY_SHA256_WITH_AVX512=0 for a toolchain without AVX-512 intrinsics.
+#ifndef PROXY_SHA256_WITH_AVX2
+#define PROXY_SHA256_WITH_AVX2 (PLATFORM_CPU_X86_FAMILY && PLATFORM_64BITS)
+#endif
+#ifndef PROXY_SHA256_WITH_AVX512
+#define PROXY_SHA256_WITH_AVX512 (PLATFORM_CPU_X86_FAMILY && PLATFORM_64BITS)
+#endif
+
+#define PROXY_SHA256_WITH_X86_FEATURES (PROXY_SHA256_WITH_SHANI || PROXY_SHA256_WITH_AVX2 || PROXY_SHA256_WITH_AVX512)
+
+#if PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS && (defined(_MSC_VER) || defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2) || (defined(__clang__) && __clang_major__ >= 16))
+#define PROXY_SHA256_WITH_ARMV8 1
+#include <arm_neon.h>
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#elif PLATFORM_LINUX || PLATFORM_ANDROID
+#include <sys/auxv.h>
+#endif
+#else
+#define PROXY_SHA256_WITH_ARMV8 0
+#endif
+
+#if defined(__clang__) || defined(__GNUC__)
+#define PROXY_SHA256_TARGET_SHANI __attribute__((target("sha,sse4.1,ssse3")))
+#define PROXY_SHA256_TARGET_AVX2 __attribute__((target("avx2")))
+#define PROXY_SHA256_TARGET_AVX512 __attribute__((target("avx512f")))
+#if defined(__clang__)
+#define PROXY_SHA256_TARGET_ARMV8 __attribute__((target("crypto")))
+#else
+// GCC wants the feature as an extension of the base architecture
+#define PROXY_SHA256_TARGET_ARMV8 __attribute__((target("+crypto")))
+#endif
+#else
+#define PROXY_SHA256_TARGET_SHANI
+#define PROXY_SHA256_TARGET_AVX2
+#define PROXY_SHA256_TARGET_AVX512
+#define PROXY_SHA256_TARGET_ARMV8
+#endif
+
+// Minimal public-domain SHA256 implementation (adapted for plugin use)
+namespace
+{
+    const FProxyHistogram HmacSignLatency(TEXT("proxy_hmac_sign_seconds"), TEXT(""), TEXT("HMAC-SHA256 signature latency (prepared key)"));
+
+    // rotate right
+    inline uint32_t rotr(uint32_t x, uint32_t n) { return (x >> n) | (x << (32 - n)); }
+
+    static const uint32_t K256[64] = {
+        0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+        0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+        0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+        0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+        0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+        0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+        0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+        0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u};
+
+    static const uint32_t H256[8] = {
+        0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au, 0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u};
+
+    // Portable scalar compression over NumBlocks consecutive 64-byte blocks, always available as the fallback
+    static void sha256_blocks_scalar(uint32_t state[8], const uint8_t *data, size_t NumBlocks)
+    {
+        uint32_t h0 = state[0];
+        uint32_t h1 = state[1];
+        uint32_t h2 = state[2];
+        uint32_t h3 = state[3];
+        uint32_t h4 = state[4];
+        uint32_t h5 = state[5];
+        uint32_t h6 = state[6];
+        uint32_t h7 = state[7];
+
+        for (size_t c = 0; c < NumBlocks; ++c)
+        {
+            const uint8_t *chunk = data + (c * 64u);
+            uint32_t w[64];
+            for (int t = 0; t < 16; ++t)
+            {
+                w[t] = (uint32_t)chunk[t * 4] << 24 | (uint32_t)chunk[t * 4 + 1] << 16 | (uint32_t)chunk[t * 4 + 2] << 8 | (uint32_t)chunk[t * 4 + 3];
+            }
+            for (int t = 16; t < 64; ++t)
+            {
+                uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+                uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+                w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+            }
+
+            uint32_t a = h0;
+            uint32_t b = h1;
+            uint32_t c2 = h2;
+            uint32_t d = h3;
+            uint32_t e = h4;
+            uint32_t f = h5;
+            uint32_t g = h6;
+            uint32_t h = h7;
+
+            for (int t = 0; t < 64; ++t)
+            {
+                uint32_t S1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+                uint32_t ch = (e & f) ^ ((~e) & g);
+                uint32_t temp1 = h + S1 + ch + K256[t] + w[t];
+                uint32_t S0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+                uint32_t maj = (a & b) ^ (a & c2) ^ (b & c2);
+                uint32_t temp2 = S0 + maj;
+
+                h = g;
+                g = f;
+                f = e;
+                e = d + temp1;
+                d = c2;
+                c2 = b;
+                b = a;
+                a = temp1 + temp2;
+            }
+
+            h0 += a;
+            h1 += b;
+            h2 += c2;
+            h3 += d;
+            h4 += e;
+            h5 += f;
+            h6 += g;
+            h7 += h;
+        }
+
+        state[0] = h0;
+        state[1] = h1;
+        state[2] = h2;
+        state[3] = h3;
+        state[4] = h4;
+        state[5] = h5;
+        state[6] = h6;
+        state[7] = h7;
+    }
+
+#if PROXY_SHA256_WITH_SHANI
+    // x86-64 SHA extensions (SHA-NI). The state is kept in the ABEF/CDGH layout the sha256rnds2 instruction expects.
+    PROXY_SHA256_TARGET_SHANI static void sha256_blocks_shani(uint32_t state[8], const uint8_t *data, size_t NumBlocks)
+    {
+        const __m128i ByteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        __m128i Tmp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0]));
+        __m128i State1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[4]));
+        Tmp = _mm_shuffle_epi32(Tmp, 0xB1);             // CDAB
+        State1 = _mm_shuffle_epi32(State1, 0x1B);       // EFGH
+        __m128i State0 = _mm_alignr_epi8(Tmp, State1, 8); // ABEF
+        State1 = _mm_blend_epi16(State1, Tmp, 0xF0);    // CDGH
+
+        for (size_t c = 0; c < NumBlocks; ++c, data += 64)
+        {
+            const __m128i SaveAbef = State0;
+            const __m128i SaveCdgh = State1;
+
+            __m128i Msg[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                Msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16)), ByteSwapMask);
+            }
+
+            // 16 groups of 4 rounds, the message schedule runs 4 words ahead in a ring of 4 registers
+            for (int i = 0; i < 16; ++i)
+            {
+                __m128i Wk = _mm_add_epi32(Msg[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i *>(&K256[i * 4])));
+                State1 = _mm_sha256rnds2_epu32(State1, State0, Wk);
+                Wk = _mm_shuffle_epi32(Wk, 0x0E);
+                State0 = _mm_sha256rnds2_epu32(State0, State1, Wk);
+
+                if (i < 12)
+                {
+                    const __m128i Mixed = _mm_add_epi32(_mm_sha256msg1_epu32(Msg[i & 3], Msg[(i + 1) & 3]), _mm_alignr_epi8(Msg[(i + 3) & 3], Msg[(i + 2) & 3], 4));
+                    Msg[i & 3] = _mm_sha256msg2_epu32(Mixed, Msg[(i + 3) & 3]);
+                }
+            }
+
+            State0 = _mm_add_epi32(State0, SaveAbef);
+            State1 = _mm_add_epi32(State1, SaveCdgh);
+        }
+
+        Tmp = _mm_shuffle_epi32(State0, 0x1B);       // FEBA
+        State1 = _mm_shuffle_epi32(State1, 0xB1);    // DCHG
+        State0 = _mm_blend_epi16(Tmp, State1, 0xF0); // DCBA
+        State1 = _mm_alignr_epi8(State1, Tmp, 8);    // ABEF
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), State0);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[4]), State1);
+    }
+#endif // PROXY_SHA256_WITH_SHANI
+
+#if PROXY_SHA256_WITH_X86_FEATURES
+    struct FX86Features
+    {
+        bool bSHANI = false;
+        bool bAVX2 = false;
+        bool bAVX512 = false;
+    };
+
+    static FX86Features detect_x86_features()
+    {
+        int Regs1[4] = {0};
+        int Regs7[4] = {0};
+#if defined(_MSC_VER)
+        __cpuidex(Regs1, 1, 0);
+        __cpuidex(Regs7, 7, 0);
+#else
+        unsigned int a, b, c2, d;
+        if (__get_cpuid_max(0, nullptr) < 7)
+        {
+            return FX86Features();
+        }
+        __cpuid_count(1, 0, a, b, c2, d);
+        Regs1[2] = (int)c2;
+        __cpuid_count(7, 0, a, b, c2, d);
+        Regs7[1] = (int)b;
+#endif
+        FX86Features Features;
+
+        const bool bSSSE3 = (Regs1[2] & (1 << 9)) != 0;
+        const bool bSSE41 = (Regs1[2] & (1 << 19)) != 0;
+        const bool bSHA = (Regs7[1] & (1 << 29)) != 0;
+        Features.bSHANI = bSSSE3 && bSSE41 && bSHA;
+
+        // YMM / ZMM registers are only usable if the OS saves them on context switch (XCR0)
+        const bool bOSXSAVE = (Regs1[2] & (1 << 27)) != 0;
+        uint64_t XCR0 = 0;
+        if (bOSXSAVE)
+        {
+#if defined(_MSC_VER)
+            XCR0 = _xgetbv(0);
+#else
+            unsigned int Lo, Hi;
+            __asm__ volatile("xgetbv" : "=a"(Lo), "=d"(Hi) : "c"(0));
+            XCR0 = ((uint64_t)Hi << 32) | Lo;
+#endif
+        }
+        const bool bOSSavesYMM = (XCR0 & 0x06) == 0x06;
+        const bool bOSSavesZMM = (XCR0 & 0xE6) == 0xE6;
+        Features.bAVX2 = bOSSavesYMM && (Regs7[1] & (1 << 5)) != 0;
+        Features.bAVX512 = bOSSavesZMM && (Regs7[1] & (1 << 16)) != 0;
+        return Features;
+    }
+
+    static const FX86Features &x86_features()
+    {
+        static const FX86Features Features = detect_x86_features();
+        return Features;
+    }
+#endif // PROXY_SHA256_WITH_X86_FEATURES
+
+#if PROXY_SHA256_WITH_SHANI
+    static bool cpu_has_shani()
+    {
+        return x86_features().bSHANI;
+    }
+#endif // PROXY_SHA256_WITH_SHANI
+
+#if PROXY_SHA256_WITH_ARMV8
+    // ARMv8 cryptography extensions (SHA256H / SHA256H2 / SHA256SU0 / SHA256SU1)
+    PROXY_SHA256_TARGET_ARMV8 static void sha256_blocks_armv8(uint32_t state[8], const uint8_t *data, size_t NumBlocks)
+    {
+        uint32x4_t State0 = vld1q_u32(&state[0]);
+        uint32x4_t State1 = vld1q_u32(&state[4]);
+
+        for (size_t c = 0; c < NumBlocks; ++c, data += 64)
+        {
+            const uint32x4_t SaveAbcd = State0;
+            const uint32x4_t SaveEfgh = State1;
+
+            uint32x4_t Msg[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                Msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+            }
+
+            for (int i = 0; i < 16; ++i)
+            {
+                const uint32x4_t Wk = vaddq_u32(Msg[i & 3], vld1q_u32(&K256[i * 4]));
+                if (i < 12)
+                {
+                    Msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(Msg[i & 3], Msg[(i + 1) & 3]), Msg[(i + 2) & 3], Msg[(i + 3) & 3]);
+                }
+
+                const uint32x4_t Abcd = State0;
+                State0 = vsha256hq_u32(State0, State1, Wk);
+                State1 = vsha256h2q_u32(State1, Abcd, Wk);
+            }
+
+            State0 = vaddq_u32(State0, SaveAbcd);
+            State1 = vaddq_u32(State1, SaveEfgh);
+        }
+
+        vst1q_u32(&state[0], State0);
+        vst1q_u32(&state[4], State1);
+    }
+
+    static bool cpu_has_armv8_sha2()
+    {
+#if PLATFORM_WINDOWS
+        return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif PLATFORM_LINUX || PLATFORM_ANDROID
+        // HWCAP_SHA2 (bit 6) on AArch64
+        return (getauxval(AT_HWCAP) & (1ul << 6)) != 0;
+#elif PLATFORM_APPLE
+        // Every Apple arm64 core implements the crypto extensions
+        return true;
+#else
+        return false;
+#endif
+    }
+#endif // PROXY_SHA256_WITH_ARMV8
+
+    typedef void (*FSha256BlocksFunction)(uint32_t state[8], const uint8_t *data, size_t NumBlocks);
+
+    // Runs a backend over the shared test vectors and compares against the known digests
+    static bool sha256_backend_passes_vectors(FSha256BlocksFunction Blocks)
+    {
+        struct FVector
+        {
+            const char *Message;
+            int32 Repeat;
+            uint8_t Digest[32];
+        };
+
+        static const FVector Vectors[] = {
+            {"", 1, {0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55}},
+            {"abc", 1, {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad}},
+            {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1, {0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1}},
+            {"a", 1000, {0x41, 0xed, 0xec, 0xe4, 0x2d, 0x63, 0xe8, 0xd9, 0xbf, 0x51, 0x5a, 0x9b, 0xa6, 0x93, 0x2e, 0x1c, 0x20, 0xcb, 0xc9, 0xf5, 0xa5, 0xd1, 0x34, 0x64, 0x5a, 0xdb, 0x5d, 0xb1, 0xb9, 0x73, 0x7e, 0xa3}},
+        };
+
+        for (const FVector &Vector : Vectors)
+        {
+            // Pad by hand so this check does not depend on FSha256Context's own dispatch
+            uint8_t Padded[1024 + 128];
+            const size_t Len = strlen(Vector.Message) * (size_t)Vector.Repeat;
+            for (int32 r = 0; r < Vector.Repeat; ++r)
+            {
+                FMemory::Memcpy(Padded + r * strlen(Vector.Message), Vector.Message, strlen(Vector.Message));
+            }
+            const size_t PaddedLen = ((Len + 8) / 64 + 1) * 64;
+            Padded[Len] = 0x80;
+            FMemory::Memzero(Padded + Len + 1, PaddedLen - Len - 1);
+            const uint64_t BitLength = (uint64_t)Len * 8u;
+            for (int i = 0; i < 8; ++i)
+            {
+                Padded[PaddedLen - 8 + i] = (uint8_t)((BitLength >> ((7 - i) * 8)) & 0xFFu);
+            }
+
+            uint32_t State[8];
+            FMemory::Memcpy(State, H256, sizeof(State));
+            Blocks(State, Padded, PaddedLen / 64);
+
+            for (int i = 0; i < 8; ++i)
+            {
+                const uint32_t Expected = (uint32_t)Vector.Digest[i * 4] << 24 | (uint32_t)Vector.Digest[i * 4 + 1] << 16 | (uint32_t)Vector.Digest[i * 4 + 2] << 8 | (uint32_t)Vector.Digest[i * 4 + 3];
+                if (State[i] != Expected)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    struct FSha256Backend
+    {
+        FSha256BlocksFunction Blocks = &sha256_blocks_scalar;
+        const TCHAR *Name = TEXT("Scalar");
+
+        FSha256Backend()
+        {
+            // Punal Manalan, NOTE: "-NoSha256Accel" on the command line forces the portable path (useful for A/B checks)
+            if (FParse::Param(FCommandLine::Get(), TEXT("NoSha256Accel")))
+            {
+                return;
+            }
+
+#if PROXY_SHA256_WITH_SHANI
+            TrySelect(cpu_has_shani(), &sha256_blocks_shani, TEXT("SHA-NI"));
+#endif
+#if PROXY_SHA256_WITH_ARMV8
+            TrySelect(cpu_has_armv8_sha2(), &sha256_blocks_armv8, TEXT("ARMv8-SHA2"));
+#endif
+            UE_LOG(LogTemp, Log, TEXT("SHA256: using %s backend"), Name);
+        }
+
+        void TrySelect(bool bSupported, FSha256BlocksFunction Candidate, const TCHAR *CandidateName)
+        {
+            if (!bSupported)
+            {
+                return;
+            }
+            if (!sha256_backend_passes_vectors(Candidate))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SHA256: %s backend failed its self-test, staying on %s"), CandidateName, Name);
+                return;
+            }
+            Blocks = Candidate;
+            Name = CandidateName;
+        }
+    };
+
+    static const FSha256Backend &sha256_backend()
+    {
+        static const FSha256Backend Backend;
+        return Backend;
+    }
+
+    static void sha256_blocks(uint32_t state[8], const uint8_t *data, size_t NumBlocks)
+    {
+        sha256_backend().Blocks(state, data, NumBlocks);
+    }
+    /*
+     * Multi-buffer SHA-256: one independent message per SIMD lane (8 with AVX2, 16 with AVX-512).
+     * State is laid out word-major, State[Word * Lanes + Lane], Words holds the 16 big-endian
+     * message words of each lane's current block in the same layout.
+     */
+    typedef void (*FSha256LanesFunction)(uint32_t *State, const uint32_t *Words);
+
+#if PROXY_SHA256_WITH_AVX2
+#define PROXY_SHA256_ROTR256(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+    PROXY_SHA256_TARGET_AVX2 static void sha256_lanes_avx2(uint32_t *State, const uint32_t *Words)
+    {
+        __m256i W[16];
+        for (int t = 0; t < 16; ++t)
+        {
+            W[t] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Words + t * 8));
+        }
+
+        __m256i V[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            V[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(State + i * 8));
+        }
+        __m256i a = V[0], b = V[1], c2 = V[2], d = V[3], e = V[4], f = V[5], g = V[6], h = V[7];
+
+        for (int t = 0; t < 64; ++t)
+        {
+            if (t >= 16)
+            {
+                const __m256i W15 = W[(t - 15) & 15];
+                const __m256i W2 = W[(t - 2) & 15];
+                const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(PROXY_SHA256_ROTR256(W15, 7), PROXY_SHA256_ROTR256(W15, 18)), _mm256_srli_epi32(W15, 3));
+                const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(PROXY_SHA256_ROTR256(W2, 17), PROXY_SHA256_ROTR256(W2, 19)), _mm256_srli_epi32(W2, 10));
+                W[t & 15] = _mm256_add_epi32(_mm256_add_epi32(W[t & 15], s0), _mm256_add_epi32(W[(t - 7) & 15], s1));
+            }
+
+            const __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(PROXY_SHA256_ROTR256(e, 6), PROXY_SHA256_ROTR256(e, 11)), PROXY_SHA256_ROTR256(e, 25));
+            const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            const __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, S1), _mm256_add_epi32(ch, _mm256_set1_epi32((int)K256[t]))), W[t & 15]);
+            const __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(PROXY_SHA256_ROTR256(a, 2), PROXY_SHA256_ROTR256(a, 13)), PROXY_SHA256_ROTR256(a, 22));
+            const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c2, _mm256_or_si256(a, b)));
+            const __m256i temp2 = _mm256_add_epi32(S0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, temp1);
+            d = c2;
+            c2 = b;
+            b = a;
+            a = _mm256_add_epi32(temp1, temp2);
+        }
+
+        const __m256i Out[8] = {a, b, c2, d, e, f, g, h};
+        for (int i = 0; i < 8; ++i)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(State + i * 8), _mm256_add_epi32(V[i], Out[i]));
+        }
+    }
+
+#undef PROXY_SHA256_ROTR256
+#endif // PROXY_SHA256_WITH_AVX2
+
+#if PROXY_SHA256_WITH_AVX512
+    PROXY_SHA256_TARGET_AVX512 static void sha256_lanes_avx512(uint32_t *State, const uint32_t *Words)
+    {
+        __m512i W[16];
+        for (int t = 0; t < 16; ++t)
+        {
+            W[t] = _mm512_loadu_si512(Words + t * 16);
+        }
+
+        __m512i V[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            V[i] = _mm512_loadu_si512(State + i * 16);
+        }
+        __m512i a = V[0], b = V[1], c2 = V[2], d = V[3], e = V[4], f = V[5], g = V[6], h = V[7];
+
+        // ternarylogic immediates: 0x96 = x ^ y ^ z, 0xCA = ch(x, y, z), 0xE8 = maj(x, y, z)
+        for (int t = 0; t < 64; ++t)
+        {
+            if (t >= 16)
+            {
+                const __m512i W15 = W[(t - 15) & 15];
+                const __m512i W2 = W[(t - 2) & 15];
+                const __m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W15, 7), _mm512_ror_epi32(W15, 18), _mm512_srli_epi32(W15, 3), 0x96);
+                const __m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W2, 17), _mm512_ror_epi32(W2, 19), _mm512_srli_epi32(W2, 10), 0x96);
+                W[t & 15] = _mm512_add_epi32(_mm512_add_epi32(W[t & 15], s0), _mm512_add_epi32(W[(t - 7) & 15], s1));
+            }
+
+            const __m512i S1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96);
+            const __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+            const __m512i temp1 = _mm512_add_epi32(_mm512_add_epi32(_mm512_add_epi32(h, S1), _mm512_add_epi32(ch, _mm512_set1_epi32((int)K256[t]))), W[t & 15]);
+            const __m512i S0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96);
+            const __m512i maj = _mm512_ternarylogic_epi32(a, b, c2, 0xE8);
+            const __m512i temp2 = _mm512_add_epi32(S0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = _mm512_add_epi32(d, temp1);
+            d = c2;
+            c2 = b;
+            b = a;
+            a = _mm512_add_epi32(temp1, temp2);
+        }
+
+        const __m512i Out[8] = {a, b, c2, d, e, f, g, h};
+        for (int i = 0; i < 8; ++i)
+        {
+            _mm512_storeu_si512(State + i * 16, _mm512_add_epi32(V[i], Out[i]));
+        }
+    }
+#endif // PROXY_SHA256_WITH_AVX512
+
+    static constexpr int32 MaxLanes = 16;
+
+    // Per-lane cursor over one job: whole blocks straight from the caller's buffer, then 1-2 padded tail blocks
+    struct FMultiBufferLane
+    {
+        int32 Job = INDEX_NONE;
+        const uint8_t *Data = nullptr;
+        int64 FullBlocksLeft = 0;
+        int32 TailBlocks = 0;
+        int32 TailIndex = 0;
+        uint8_t Tail[128];
+
+        void Start(int32 JobIndex, const FSha256MultiBufferJob &InJob)
+        {
+            Job = JobIndex;
+            Data = InJob.Data;
+            FullBlocksLeft = InJob.Length / 64;
+
+            const int32 Rem = (int32)(InJob.Length % 64);
+            if (Rem > 0)
+            {
+                FMemory::Memcpy(Tail, InJob.Data + (InJob.Length - Rem), Rem);
+            }
+            Tail[Rem] = 0x80;
+            TailBlocks = (Rem + 1 + 8 > 64) ? 2 : 1;
+            TailIndex = 0;
+            FMemory::Memzero(Tail + Rem + 1, TailBlocks * 64 - 8 - (Rem + 1));
+
+            const uint64_t BitLength = (InJob.StartLength + (uint64_t)InJob.Length) * 8u;
+            uint8_t *LengthOut = Tail + TailBlocks * 64 - 8;
+            for (int i = 0; i < 8; ++i)
+            {
+                LengthOut[i] = (uint8_t)((BitLength >> ((7 - i) * 8)) & 0xFFu);
+            }
+        }
+
+        const uint8_t *NextBlock()
+        {
+            if (FullBlocksLeft > 0)
+            {
+                const uint8_t *Block = Data;
+                Data += 64;
+                --FullBlocksLeft;
+                return Block;
+            }
+            if (TailIndex < TailBlocks)
+            {
+                return Tail + 64 * TailIndex++;
+            }
+            return nullptr;
+        }
+    };
+
+    // Keeps every lane busy: as soon as a lane finishes its message it is refilled with the next job
+    static void sha256_multibuffer(const FSha256MultiBufferJob *Jobs, int32 Num, uint8 *OutDigests, int32 Lanes, FSha256LanesFunction Kernel)
+    {
+        static const uint8_t ZeroBlock[64] = {0};
+
+        FMultiBufferLane LaneCursors[MaxLanes];
+        uint32_t State[8 * MaxLanes];
+        uint32_t Words[16 * MaxLanes];
+        int32 NextJob = 0;
+
+        for (;;)
+        {
+            int32 ActiveLanes = 0;
+            const uint8_t *Blocks[MaxLanes];
+
+            for (int32 l = 0; l < Lanes; ++l)
+            {
+                FMultiBufferLane &Lane = LaneCursors[l];
+                const uint8_t *Block = (Lane.Job != INDEX_NONE) ? Lane.NextBlock() : nullptr;
+
+                if (!Block)
+                {
+                    if (Lane.Job != INDEX_NONE)
+                    {
+                        // Lane finished its last block on the previous pass, store big-endian
+                        uint8 *Out = OutDigests + (SIZE_T)Lane.Job * 32u;
+                        for (int i = 0; i < 8; ++i)
+                        {
+                            const uint32_t Word = State[i * Lanes + l];
+                            Out[i * 4 + 0] = (uint8)((Word >> 24) & 0xFFu);
+                            Out[i * 4 + 1] = (uint8)((Word >> 16) & 0xFFu);
+                            Out[i * 4 + 2] = (uint8)((Word >> 8) & 0xFFu);
+                            Out[i * 4 + 3] = (uint8)(Word & 0xFFu);
+                        }
+                        Lane.Job = INDEX_NONE;
+                    }
+
+                    if (NextJob < Num)
+                    {
+                        const FSha256MultiBufferJob &Job = Jobs[NextJob];
+                        const uint32 *Start = Job.StartState ? Job.StartState : H256;
+                        for (int i = 0; i < 8; ++i)
+                        {
+                            State[i * Lanes + l] = Start[i];
+                        }
+                        Lane.Start(NextJob++, Job);
+                        Block = Lane.NextBlock();
+                    }
+                }
+
+                if (Block)
+                {
+                    ++ActiveLanes;
+                }
+                Blocks[l] = Block ? Block : ZeroBlock;
+            }
+
+            if (ActiveLanes == 0)
+            {
+                break;
+            }
+
+            for (int t = 0; t < 16; ++t)
+            {
+                for (int32 l = 0; l < Lanes; ++l)
+                {
+                    const uint8_t *p = Blocks[l] + t * 4;
+                    Words[t * Lanes + l] = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+                }
+            }
+            Kernel(State, Words);
+        }
+    }
+
+    // Hashes each job one at a time through FSha256Context (which itself uses SHA-NI / ARMv8 when available)
+    static void sha256_multibuffer_serial(const FSha256MultiBufferJob *Jobs, int32 Num, uint8 *OutDigests)
+    {
+        for (int32 i = 0; i < Num; ++i)
+        {
+            FSha256Context Context;
+            if (Jobs[i].StartState)
+            {
+                Context.InitFromMidstate(Jobs[i].StartState, Jobs[i].StartLength);
+            }
+            Context.Update(Jobs[i].Data, Jobs[i].Length);
+            Context.Final(OutDigests + (SIZE_T)i * 32u);
+        }
+    }
+
+    struct FSha256MultiBufferBackend
+    {
+        FSha256LanesFunction Kernel = nullptr;
+        int32 Lanes = 1;
+        const TCHAR *Name = TEXT("Serial");
+
+        FSha256MultiBufferBackend()
+        {
+            if (FParse::Param(FCommandLine::Get(), TEXT("NoSha256Accel")))
+            {
+                return;
+            }
+
+#if PROXY_SHA256_WITH_AVX512
+            if (x86_features().bAVX512)
+            {
+                TrySelect(&sha256_lanes_avx512, 16, TEXT("AVX-512 x16"));
+            }
+#endif
+#if PROXY_SHA256_WITH_AVX2
+            // Punal Manalan, NOTE: 8 scalar-round lanes lose to single-stream SHA-NI, so AVX2 is only worth it on CPUs without SHA-NI
+            if (!Kernel && x86_features().bAVX2 && !x86_features().bSHANI)
+            {
+                TrySelect(&sha256_lanes_avx2, 8, TEXT("AVX2 x8"));
+            }
+#endif
+            UE_LOG(LogTemp, Log, TEXT("SHA256: using %s multi-buffer backend"), Name);
+        }
+
+        void TrySelect(FSha256LanesFunction Candidate, int32 CandidateLanes, const TCHAR *CandidateName)
+        {
+            // Cross-check against the single-stream path on messages of every tail shape, with and without a midstate
+            uint8_t Message[300];
+            for (int32 i = 0; i < (int32)sizeof(Message); ++i)
+            {
+                Message[i] = (uint8_t)(i * 131 + 7);
+            }
+            uint32_t MidState[8];
+            FMemory::Memcpy(MidState, H256, sizeof(MidState));
+            sha256_blocks_scalar(MidState, Message, 1);
+
+            static constexpr int32 NumJobs = 40;
+            FSha256MultiBufferJob Jobs[NumJobs];
+            for (int32 i = 0; i < NumJobs; ++i)
+            {
+                Jobs[i].Data = Message + i;
+                Jobs[i].Length = (i * 37) % 200;
+                if (i & 1)
+                {
+                    Jobs[i].StartState = MidState;
+                    Jobs[i].StartLength = 64;
+                }
+            }
+
+            uint8 Expected[NumJobs * 32];
+            uint8 Actual[NumJobs * 32];
+            sha256_multibuffer_serial(Jobs, NumJobs, Expected);
+            sha256_multibuffer(Jobs, NumJobs, Actual, CandidateLanes, Candidate);
+            if (FMemory::Memcmp(Expected, Actual, sizeof(Expected)) != 0)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SHA256: %s multi-buffer backend failed its self-test, hashing batches serially"), CandidateName);
+                return;
+            }
+
+            Kernel = Candidate;
+            Lanes = CandidateLanes;
+            Name = CandidateName;
+        }
+    };
+
+    static const FSha256MultiBufferBackend &sha256_multibuffer_backend()
+    {
+        static const FSha256MultiBufferBackend Backend;
+        return Backend;
+    }
+} // anonymous namespace
+
+void FSha256Context::Init()
+{
+    FMemory::Memcpy(State, H256, sizeof(State));
+    TotalLength = 0;
+    BufferLength = 0;
+}
+
+void FSha256Context::InitFromMidstate(const uint32 InState[8], uint64 AbsorbedLength)
+{
+    FMemory::Memcpy(State, InState, sizeof(State));
+    TotalLength = AbsorbedLength;
+    BufferLength = 0;
+}
+
+void FSha256Context::Update(const uint8 *Data, int64 Length)
+{
+    if (!Data || Length <= 0)
+    {
+        return;
+    }
+
+    TotalLength += (uint64)Length;
+
+    // Top up a partially filled block first
+    if (BufferLength > 0)
+    {
+        const int32 Take = (int32)FMath::Min<int64>(BlockSize - BufferLength, Length);
+        FMemory::Memcpy(Buffer + BufferLength, Data, Take);
+        BufferLength += Take;
+        Data += Take;
+        Length -= Take;
+
+        if (BufferLength < BlockSize)
+        {
+            return;
+        }
+        sha256_blocks(State, Buffer, 1);
+        BufferLength = 0;
+    }
+
+    // Whole blocks are compressed directly from the caller's buffer
+    const int64 NumBlocks = Length / BlockSize;
+    if (NumBlocks > 0)
+    {
+        sha256_blocks(State, Data, (size_t)NumBlocks);
+        Data += NumBlocks * BlockSize;
+        Length -= NumBlocks * BlockSize;
+    }
+
+    if (Length > 0)
+    {
+        FMemory::Memcpy(Buffer, Data, (SIZE_T)Length);
+        BufferLength = (int32)Length;
+    }
+}
+
+void FSha256Context::UpdateString(const FString &Input)
+{
+    const TCHAR *Src = *Input;
+    int32 Remaining = Input.Len();
+
+    // Worst case is 4 UTF-8 bytes per TCHAR
+    constexpr int32 ChunkChars = 128;
+    UTF8CHAR Utf8[ChunkChars * 4];
+
+    while (Remaining > 0)
+    {
+        int32 Count = FMath::Min(Remaining, ChunkChars);
+        // Never split a surrogate pair across two chunks
+        if (Count < Remaining && StringConv::IsHighSurrogate(Src[Count - 1]))
+        {
+            --Count;
+        }
+
+        const int32 Utf8Len = FPlatformString::ConvertedLength<UTF8CHAR>(Src, Count);
+        FPlatformString::Convert(Utf8, UE_ARRAY_COUNT(Utf8), Src, Count);
+        Update(reinterpret_cast<const uint8 *>(Utf8), Utf8Len);
+
+        Src += Count;
+        Remaining -= Count;
+    }
+}
+
+void FSha256Context::Final(uint8 OutDigest[DigestSize])
+{
+    const uint64 BitLength = TotalLength * 8u;
+
+    Buffer[BufferLength++] = 0x80;
+    if (BufferLength > BlockSize - 8)
+    {
+        FMemory::Memzero(Buffer + BufferLength, BlockSize - BufferLength);
+        sha256_blocks(State, Buffer, 1);
+        BufferLength = 0;
+    }
+    FMemory::Memzero(Buffer + BufferLength, (BlockSize - 8) - BufferLength);
+
+    // write big-endian bit length at end
+    for (int32 i = 0; i < 8; ++i)
+    {
+        Buffer[BlockSize - 8 + i] = (uint8)((BitLength >> ((7 - i) * 8)) & 0xFFu);
+    }
+    sha256_blocks(State, Buffer, 1);
+    BufferLength = 0;
+
+    // store big-endian
+    for (int32 i = 0; i < 8; ++i)
+    {
+        OutDigest[i * 4 + 0] = (uint8)((State[i] >> 24) & 0xFFu);
+        OutDigest[i * 4 + 1] = (uint8)((State[i] >> 16) & 0xFFu);
+        OutDigest[i * 4 + 2] = (uint8)((State[i] >> 8) & 0xFFu);
+        OutDigest[i * 4 + 3] = (uint8)(State[i] & 0xFFu);
+    }
+}
+
+void FSha256Context::HashBuffer(const uint8 *Data, int64 Length, uint8 OutDigest[DigestSize])
+{
+    FSha256Context Context;
+    Context.Update(Data, Length);
+    Context.Final(OutDigest);
+}
+
+bool FSha256Context::HexToDigest(const FString &Hex, uint8 OutDigest[DigestSize])
+{
+    if (Hex.Len() != DigestSize * 2)
+    {
+        return false;
+    }
+    for (int32 i = 0; i < DigestSize; ++i)
+    {
+        const TCHAR Hi = Hex[i * 2];
+        const TCHAR Lo = Hex[i * 2 + 1];
+        if (!FChar::IsHexDigit(Hi) || !FChar::IsHexDigit(Lo))
+        {
+            return false;
+        }
+        OutDigest[i] = (uint8)((FParse::HexDigit(Hi) << 4) | FParse::HexDigit(Lo));
+    }
+    return true;
+}
+
+bool FSha256Context::DigestEquals(const uint8 A[DigestSize], const uint8 B[DigestSize])
+{
+    uint8 Diff = 0;
+    for (int32 i = 0; i < DigestSize; ++i)
+    {
+        Diff |= A[i] ^ B[i];
+    }
+    return Diff == 0;
+}
+
+const TCHAR *FSha256Context::GetBackendName()
+{
+    return sha256_backend().Name;
+}
+
+bool FSha256Context::SelfTestAllBackends()
+{
+    bool bAllPassed = sha256_backend_passes_vectors(&sha256_blocks_scalar);
+#if PROXY_SHA256_WITH_SHANI
+    if (cpu_has_shani())
+    {
+        bAllPassed &= sha256_backend_passes_vectors(&sha256_blocks_shani);
+    }
+#endif
+#if PROXY_SHA256_WITH_ARMV8
+    if (cpu_has_armv8_sha2())
+    {
+        bAllPassed &= sha256_backend_passes_vectors(&sha256_blocks_armv8);
+    }
+#endif
+    return bAllPassed;
+}
+
+FString FSha256Context::DigestToHex(const uint8 Digest[DigestSize])
+{
+    static const TCHAR HexChars[] = TEXT("0123456789abcdef");
+
+    // Convert to lowercase hex
+    FString Out;
+    Out.Reserve(DigestSize * 2);
+    for (int32 i = 0; i < DigestSize; ++i)
+    {
+        Out.AppendChar(HexChars[Digest[i] >> 4]);
+        Out.AppendChar(HexChars[Digest[i] & 0x0F]);
+    }
+    return Out;
+}
+
+void FHmacSha256Key::SetKey(const FString &Key)
+{
+    const int32 BlockSize = FSha256Context::BlockSize;
+    const int32 KeyLen = FPlatformString::ConvertedLength<UTF8CHAR>(*Key, Key.Len());
+    if (KeyLen > BlockSize)
+    {
+        // If key is longer than block size, hash it
+        uint8 KeyHash[FSha256Context::DigestSize];
+        FSha256Context KeyContext;
+        KeyContext.UpdateString(Key);
+        KeyContext.Final(KeyHash);
+        SetKey(KeyHash, FSha256Context::DigestSize);
+    }
+    else
+    {
+        uint8 KeyBytes[BlockSize];
+        FPlatformString::Convert(reinterpret_cast<UTF8CHAR *>(KeyBytes), BlockSize, *Key, Key.Len());
+        SetKey(KeyBytes, KeyLen);
+    }
+}
+
+void FHmacSha256Key::SetKey(const uint8 *Key, int64 KeyLength)
+{
+    const int32 BlockSize = FSha256Context::BlockSize;
+    uint8 KeyPad[BlockSize];
+    FMemory::Memzero(KeyPad, BlockSize);
+
+    if (KeyLength > BlockSize)
+    {
+        FSha256Context::HashBuffer(Key, KeyLength, KeyPad);
+    }
+    else if (KeyLength > 0)
+    {
+        FMemory::Memcpy(KeyPad, Key, (SIZE_T)KeyLength);
+    }
+
+    uint8 Pad[BlockSize];
+    FSha256Context Context;
+
+    for (int32 i = 0; i < BlockSize; ++i)
+    {
+        Pad[i] = KeyPad[i] ^ 0x36;
+    }
+    Context.Update(Pad, BlockSize);
+    FMemory::Memcpy(InnerState, Context.State, sizeof(InnerState));
+
+    Context.Init();
+    for (int32 i = 0; i < BlockSize; ++i)
+    {
+        Pad[i] = KeyPad[i] ^ 0x5c;
+    }
+    Context.Update(Pad, BlockSize);
+    FMemory::Memcpy(OuterState, Context.State, sizeof(OuterState));
+
+    bIsSet = true;
+}
+
+void FHmacSha256Key::Sign(const uint8 *Data, int64 Length, uint8 OutDigest[FSha256Context::DigestSize]) const
+{
+    FProxyScopedLatency Latency(HmacSignLatency);
+
+    // Inner Hash: SHA256(IPad || Data)
+    uint8 InnerHash[FSha256Context::DigestSize];
+    FSha256Context Context;
+    Context.InitFromMidstate(InnerState, FSha256Context::BlockSize);
+    Context.Update(Data, Length);
+    Context.Final(InnerHash);
+
+    // Outer Hash: SHA256(OPad || InnerHash)
+    Context.InitFromMidstate(OuterState, FSha256Context::BlockSize);
+    Context.Update(InnerHash, FSha256Context::DigestSize);
+    Context.Final(OutDigest);
+}
+
+void FHmacSha256Key::SignString(const FString &Data, uint8 OutDigest[FSha256Context::DigestSize]) const
+{
+    FProxyScopedLatency Latency(HmacSignLatency);
+
+    uint8 InnerHash[FSha256Context::DigestSize];
+    FSha256Context Context;
+    Context.InitFromMidstate(InnerState, FSha256Context::BlockSize);
+    Context.UpdateString(Data);
+    Context.Final(InnerHash);
+
+    Context.InitFromMidstate(OuterState, FSha256Context::BlockSize);
+    Context.Update(InnerHash, FSha256Context::DigestSize);
+    Context.Final(OutDigest);
+}
+
+FString FHmacSha256Key::SignStringToHex(const FString &Data) const
+{
+    uint8 Digest[FSha256Context::DigestSize];
+    SignString(Data, Digest);
+    return FSha256Context::DigestToHex(Digest);
+}
+
+bool FHmacSha256Key::VerifyString(const FString &Data, const FString &ExpectedHexSignature) const
+{
+    uint8 Expected[FSha256Context::DigestSize];
+    if (!bIsSet || !FSha256Context::HexToDigest(ExpectedHexSignature, Expected))
+    {
+        return false;
+    }
+
+    uint8 Actual[FSha256Context::DigestSize];
+    SignString(Data, Actual);
+    return FSha256Context::DigestEquals(Expected, Actual);
+}
+
+void FSha256MultiBuffer::Hash(const FSha256MultiBufferJob *Jobs, int32 Num, uint8 *OutDigests)
+{
+    if (!Jobs || Num <= 0)
+    {
+        return;
+    }
+
+    const FSha256MultiBufferBackend &Backend = sha256_multibuffer_backend();
+    // With only a couple of messages most lanes would idle, so the single-stream path is faster
+    if (!Backend.Kernel || Num < Backend.Lanes / 2)
+    {
+        sha256_multibuffer_serial(Jobs, Num, OutDigests);
+        return;
+    }
+    sha256_multibuffer(Jobs, Num, OutDigests, Backend.Lanes, Backend.Kernel);
+}
+
+int32 FSha256MultiBuffer::GetLaneCount()
+{
+    return sha256_multibuffer_backend().Lanes;
+}
+
+const TCHAR *FSha256MultiBuffer::GetBackendName()
+{
+    return sha256_multibuffer_backend().Name;
+}
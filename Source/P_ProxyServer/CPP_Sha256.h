@@ -0,0 +1,111 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Incremental SHA-256 context (Init / Update / Final).
+ * Hashes straight from the caller's buffers, only a single partial block is kept internally,
+ * so hashing never touches the heap.
+ * Block compression is dispatched once at startup to SHA-NI (x86-64) or the ARMv8 crypto extensions
+ * when the CPU supports them and they pass the known-answer vectors, otherwise the portable scalar code.
+ */
+struct P_PROXYSERVER_API FSha256Context
+{
+    static constexpr int32 BlockSize = 64;
+    static constexpr int32 DigestSize = 32;
+
+    uint32 State[8];
+    uint64 TotalLength;
+    uint8 Buffer[BlockSize];
+    int32 BufferLength;
+
+    FSha256Context() { Init(); }
+
+    // Reset to the SHA-256 initial hash values
+    void Init();
+
+    // Resume from a saved midstate, AbsorbedLength is the number of bytes (multiple of 64) already compressed into InState
+    void InitFromMidstate(const uint32 InState[8], uint64 AbsorbedLength);
+
+    // Feed raw bytes
+    void Update(const uint8 *Data, int64 Length);
+
+    // Feed an FString as UTF-8, converted through a stack buffer in fixed-size chunks
+    void UpdateString(const FString &Input);
+
+    // Apply padding and write the digest. The context must be Init()'ed again before reuse.
+    void Final(uint8 OutDigest[DigestSize]);
+
+    // One-shot helpers
+    static void HashBuffer(const uint8 *Data, int64 Length, uint8 OutDigest[DigestSize]);
+    static FString DigestToHex(const uint8 Digest[DigestSize]);
+    static bool HexToDigest(const FString &Hex, uint8 OutDigest[DigestSize]);
+
+    // Compare without an early exit so timing does not leak how many leading bytes matched
+    static bool DigestEquals(const uint8 A[DigestSize], const uint8 B[DigestSize]);
+
+    // Name of the compression backend picked by runtime CPU detection ("SHA-NI", "ARMv8-SHA2" or "Scalar")
+    static const TCHAR *GetBackendName();
+
+    // Runs every backend the CPU supports against the same known-answer vectors
+    static bool SelfTestAllBackends();
+};
+
+/**
+ * HMAC-SHA256 key with its schedule precomputed: the SHA-256 midstates after absorbing (Key ^ ipad)
+ * and (Key ^ opad). Signing then only costs the message blocks plus one outer block.
+ * Immutable once set, so one instance can be shared between threads.
+ */
+struct P_PROXYSERVER_API FHmacSha256Key
+{
+    uint32 InnerState[8];
+    uint32 OuterState[8];
+    bool bIsSet = false;
+
+    FHmacSha256Key() = default;
+    explicit FHmacSha256Key(const FString &Key) { SetKey(Key); }
+
+    // Key is used as UTF-8, same as HmacSha256String
+    void SetKey(const FString &Key);
+    void SetKey(const uint8 *Key, int64 KeyLength);
+    void Reset() { bIsSet = false; }
+
+    void Sign(const uint8 *Data, int64 Length, uint8 OutDigest[FSha256Context::DigestSize]) const;
+    void SignString(const FString &Data, uint8 OutDigest[FSha256Context::DigestSize]) const;
+    FString SignStringToHex(const FString &Data) const;
+
+    // Constant-time compare of the signature of Data against a hex signature (either case)
+    bool VerifyString(const FString &Data, const FString &ExpectedHexSignature) const;
+};
+
+// One message for FSha256MultiBuffer::Hash
+struct FSha256MultiBufferJob
+{
+    const uint8 *Data = nullptr;
+    int64 Length = 0;
+
+    // Optional midstate to start from (e.g. HMAC ipad/opad), nullptr means the SHA-256 initial values
+    const uint32 *StartState = nullptr;
+    // Bytes already absorbed into StartState, needed for the final length encoding
+    uint64 StartLength = 0;
+};
+
+/**
+ * Hashes many independent messages at once, one message per SIMD lane (AVX-512 x16 or AVX2 x8).
+ * Lanes are refilled as soon as their message finishes, so mixed lengths keep the core saturated.
+ * Falls back to hashing each job through FSha256Context when no multi-buffer backend is available.
+ */
+struct P_PROXYSERVER_API FSha256MultiBuffer
+{
+    // OutDigests must hold Num * 32 bytes, digest i belongs to Jobs[i]
+    static void Hash(const FSha256MultiBufferJob *Jobs, int32 Num, uint8 *OutDigests);
+
+    static int32 GetLaneCount();
+    static const TCHAR *GetBackendName();
+};
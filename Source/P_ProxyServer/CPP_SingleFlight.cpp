@@ -0,0 +1,49 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_SingleFlight.h"
+#include "Misc/ScopeLock.h"
+
+bool FProxySingleFlight::Join(const FString &Key, FOnResult OnResult)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (TArray<FOnResult> *Waiters = InFlight.Find(Key))
+    {
+        Waiters->Add(MoveTemp(OnResult));
+        ++NumCoalesced;
+        return false;
+    }
+
+    InFlight.Add(Key).Add(MoveTemp(OnResult));
+    return true;
+}
+
+void FProxySingleFlight::Complete(const FString &Key, const FString &Response, const FString &Error)
+{
+    TArray<FOnResult> Waiters;
+    {
+        FScopeLock ScopeLock(&Lock);
+        InFlight.RemoveAndCopyValue(Key, Waiters);
+    }
+
+    // Outside the lock, a waiter may well start the next request for the same key
+    for (FOnResult &Waiter : Waiters)
+    {
+        Waiter(Response, Error);
+    }
+}
+
+int32 FProxySingleFlight::GetNumInFlight() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return InFlight.Num();
+}
+
+uint64 FProxySingleFlight::GetNumCoalesced() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NumCoalesced;
+}
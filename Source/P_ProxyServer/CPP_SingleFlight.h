@@ -0,0 +1,35 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Single-flight: concurrent requests with the same key share one in-flight request.
+ * The first caller for a key (the leader) starts the request and reports its result with Complete,
+ * everyone who joined in the meantime gets that same result. Thread-safe.
+ */
+class P_PROXYSERVER_API FProxySingleFlight
+{
+public:
+    // (Response, Error), Error is empty on success
+    typedef TFunction<void(const FString &, const FString &)> FOnResult;
+
+    // True if the caller is the leader and has to start the request
+    bool Join(const FString &Key, FOnResult OnResult);
+
+    // Hands the result to every caller waiting on Key, in the order they joined
+    void Complete(const FString &Key, const FString &Response, const FString &Error);
+
+    int32 GetNumInFlight() const;
+    uint64 GetNumCoalesced() const;
+
+private:
+    mutable FCriticalSection Lock;
+    TMap<FString, TArray<FOnResult>> InFlight;
+    uint64 NumCoalesced = 0;
+};
@@ -0,0 +1,80 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_TimingWheel.h"
+
+FProxyTimingWheel::FProxyTimingWheel(int32 NumSlots)
+{
+    const int32 SlotCount = (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(NumSlots, 2));
+    Slots.SetNum(SlotCount);
+    SlotMask = SlotCount - 1;
+}
+
+void FProxyTimingWheel::Reset(int64 NowSeconds)
+{
+    for (TArray<FEntry> &Slot : Slots)
+    {
+        Slot.Reset();
+    }
+    Cursor = NowSeconds;
+    NumEntries = 0;
+}
+
+void FProxyTimingWheel::Schedule(const FString &Id, int64 DeadlineSeconds)
+{
+    // Already due: put it in the next slot Advance looks at
+    const int64 Second = FMath::Max(DeadlineSeconds, Cursor + 1);
+    Slots[Second & SlotMask].Add({Id, DeadlineSeconds});
+    ++NumEntries;
+}
+
+bool FProxyTimingWheel::Remove(const FString &Id, int64 DeadlineSeconds)
+{
+    // Same slot as Schedule picked: an entry that was already due then has been drained by any Advance since
+    const int64 Second = FMath::Max(DeadlineSeconds, Cursor + 1);
+    TArray<FEntry> &Slot = Slots[Second & SlotMask];
+    for (int32 Index = 0; Index < Slot.Num(); ++Index)
+    {
+        if (Slot[Index].Deadline == DeadlineSeconds && Slot[Index].Id == Id)
+        {
+            Slot.RemoveAtSwap(Index);
+            --NumEntries;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FProxyTimingWheel::Advance(int64 NowSeconds, TArray<FString> &OutExpired)
+{
+    if (NowSeconds <= Cursor)
+    {
+        return;
+    }
+
+    // After a long stall every slot is due at most once
+    const int64 Steps = FMath::Min<int64>(NowSeconds - Cursor, Slots.Num());
+    for (int64 Step = 1; Step <= Steps; ++Step)
+    {
+        DrainSlot(Cursor + Step, NowSeconds, OutExpired);
+    }
+    Cursor = NowSeconds;
+}
+
+void FProxyTimingWheel::DrainSlot(int64 Second, int64 NowSeconds, TArray<FString> &OutExpired)
+{
+    TArray<FEntry> &Slot = Slots[Second & SlotMask];
+    for (int32 Index = Slot.Num() - 1; Index >= 0; --Index)
+    {
+        // Entries for a later turn of the wheel stay put
+        if (Slot[Index].Deadline <= NowSeconds)
+        {
+            OutExpired.Add(MoveTemp(Slot[Index].Id));
+            Slot.RemoveAtSwap(Index);
+            --NumEntries;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hashed timing wheel with one-second slots, for expiring reservations / tokens.
+ * An entry lands in slot (Deadline % NumSlots) and is handed out by the first Advance that reaches its deadline.
+ * Deadlines further out than NumSlots seconds simply stay in their slot for extra turns of the wheel,
+ * so Schedule is O(1) and Advance is O(1) amortized per entry as long as most deadlines fit in one turn.
+ *
+ * Entries are hints: an id can be scheduled several times (e.g. a refreshed token), the owner re-checks
+ * the real deadline when an id comes out. Not thread-safe, the owner serialises access.
+ */
+class P_PROXYSERVER_API FProxyTimingWheel
+{
+public:
+    // NumSlots is rounded up to a power of two
+    explicit FProxyTimingWheel(int32 NumSlots = 512);
+
+    // Start (or restart) the wheel at NowSeconds, dropping every entry
+    void Reset(int64 NowSeconds);
+
+    void Schedule(const FString &Id, int64 DeadlineSeconds);
+
+    // Drops one entry scheduled with exactly this deadline, false if there is none (e.g. it already came out)
+    bool Remove(const FString &Id, int64 DeadlineSeconds);
+
+    // Moves out every entry with Deadline <= NowSeconds
+    void Advance(int64 NowSeconds, TArray<FString> &OutExpired);
+
+    int32 Num() const { return NumEntries; }
+
+private:
+    struct FEntry
+    {
+        FString Id;
+        int64 Deadline;
+    };
+
+    void DrainSlot(int64 Second, int64 NowSeconds, TArray<FString> &OutExpired);
+
+    TArray<TArray<FEntry>> Slots;
+    int64 SlotMask = 0;
+    int64 Cursor = 0; // Last second processed by Advance
+    int32 NumEntries = 0;
+};
@@ -52,6 +52,8 @@ public class P_ProxyServer : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"OpenSSL",
+				"WebSockets",
+				"HTTPServer",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -6,6 +6,9 @@
 
 #include "P_ProxyServer.h"
 #include "Modules/ModuleManager.h"
+#include "CPP_RsaKeyPool.h"
+#include "CPP_Metrics.h"
+#include "Misc/ConfigCacheIni.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogPProxyServer, Log, All);
 
@@ -19,6 +22,14 @@ DEFINE_LOG_CATEGORY_STATIC(LogPProxyServer, Log, All);
 void FP_ProxyServer::StartupModule()
 {
     UE_LOG(LogPProxyServer, Display, TEXT("P_ProxyServer: StartupModule"));
+
+    // Punal Manalan, NOTE: Metrics are process wide, so is their endpoint. Started here rather than per world (PIE, travel).
+    // Same key as UCPP_LoginManagerSubsystem::Metrics_HttpPort in DefaultGame.ini.
+    int32 MetricsHttpPort = 0;
+    if (GConfig && GConfig->GetInt(TEXT("/Script/P_ProxyServer.CPP_LoginManagerSubsystem"), TEXT("Metrics_HttpPort"), MetricsHttpPort, GGameIni) && MetricsHttpPort > 0)
+    {
+        bIsMetricsEndpointStarted = FProxyMetrics::Get().StartHttpEndpoint((uint32)MetricsHttpPort);
+    }
 }
 
 /**
@@ -28,6 +39,15 @@ void FP_ProxyServer::StartupModule()
 void FP_ProxyServer::ShutdownModule()
 {
     UE_LOG(LogPProxyServer, Display, TEXT("P_ProxyServer: ShutdownModule"));
+
+    // Stop pre-generating Local RSA keys, a key already being generated is dropped
+    FProxyRsaKeyPool::Get().Shutdown();
+
+    if (bIsMetricsEndpointStarted)
+    {
+        FProxyMetrics::Get().StopHttpEndpoint();
+        bIsMetricsEndpointStarted = false;
+    }
 }
 
 // Undefine the localization namespace to avoid conflicts
@@ -0,0 +1,134 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_AdmissionControl.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyAdmissionNormalizeTest, "P_ProxyServer.AdmissionControl.NormalizeAddress", PROXY_TEST_FLAGS)
+
+bool FProxyAdmissionNormalizeTest::RunTest(const FString &Parameters)
+{
+    TestEqual(TEXT("IPv4 port stripped"), FProxyAdmissionController::NormalizeAddress(TEXT(" 1.2.3.4:7777 ")), FString(TEXT("1.2.3.4")));
+    TestEqual(TEXT("Bracketed IPv6 with port"), FProxyAdmissionController::NormalizeAddress(TEXT("[2001:DB8::1]:7777")), FString(TEXT("2001:db8:0:0::/64")));
+    TestEqual(TEXT("Same /64, same bucket"), FProxyAdmissionController::NormalizeAddress(TEXT("2001:db8:0:0:ffff:1:2:3")), FString(TEXT("2001:db8:0:0::/64")));
+    TestEqual(TEXT("Another /64"), FProxyAdmissionController::NormalizeAddress(TEXT("2001:db8:0:1::1")), FString(TEXT("2001:db8:0:1::/64")));
+    TestEqual(TEXT("Zone id dropped"), FProxyAdmissionController::NormalizeAddress(TEXT("fe80::1%eth0")), FString(TEXT("fe80:0:0:0::/64")));
+    TestEqual(TEXT("IPv4-mapped"), FProxyAdmissionController::NormalizeAddress(TEXT("[::ffff:10.0.0.7]:7777")), FString(TEXT("10.0.0.7")));
+    TestEqual(TEXT("Not an address, left alone"), FProxyAdmissionController::NormalizeAddress(TEXT("a:b:zz::1")), FString(TEXT("a:b:zz::1")));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyAdmissionNewBucketTest, "P_ProxyServer.AdmissionControl.NewBucketIsNotFull", PROXY_TEST_FLAGS)
+
+bool FProxyAdmissionNewBucketTest::RunTest(const FString &Parameters)
+{
+    // One set of Ways buckets, so a fifth address evicts the least recently seen one
+    FProxyAdmissionController Controller(1.0f, 5.0f, 1000, FProxyAdmissionController::Ways);
+    float RetryAfter = 0.0f;
+
+    TestEqual(TEXT("First login from a new address"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+    TestEqual(TEXT("No burst for a new address"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::ShedPerAddress);
+    TestTrue(TEXT("Retry after a refill"), RetryAfter > 0.0f);
+
+    // Evicting the bucket by cycling other addresses through the set does not hand out a full one either
+    for (int32 Index = 0; Index < FProxyAdmissionController::Ways; ++Index)
+    {
+        Controller.TryAdmit(FString::Printf(TEXT("2.2.2.%d"), Index), 100.0, RetryAfter);
+    }
+    TestEqual(TEXT("Back after eviction"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+    TestEqual(TEXT("Still no burst"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::ShedPerAddress);
+
+    // The bucket still fills up to Burst over time
+    for (int32 Index = 0; Index < 5; ++Index)
+    {
+        TestEqual(TEXT("Refilled up to Burst"), Controller.TryAdmit(TEXT("1.1.1.1"), 200.0, RetryAfter), EProxyAdmission::Admitted);
+    }
+    TestEqual(TEXT("Burst spent"), Controller.TryAdmit(TEXT("1.1.1.1"), 200.0, RetryAfter), EProxyAdmission::ShedPerAddress);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyAdmissionGlobalLimitTest, "P_ProxyServer.AdmissionControl.GlobalLimit", PROXY_TEST_FLAGS)
+
+bool FProxyAdmissionGlobalLimitTest::RunTest(const FString &Parameters)
+{
+    FProxyAdmissionController Controller(1.0f, 5.0f, 2, 1024);
+    float RetryAfter = 0.0f;
+
+    // Different addresses, so only the in-flight limit applies
+    TestEqual(TEXT("First in flight"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+    TestEqual(TEXT("Second in flight"), Controller.TryAdmit(TEXT("1.1.1.2"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+    TestEqual(TEXT("Over the limit"), Controller.TryAdmit(TEXT("1.1.1.3"), 100.0, RetryAfter), EProxyAdmission::ShedGlobal);
+    TestEqual(TEXT("Global retry-after"), RetryAfter, 1.0f);
+    TestEqual(TEXT("Shed not counted in flight"), Controller.GetStats().InFlight, 2);
+
+    // A Release frees one slot, and only one
+    Controller.Release();
+    TestEqual(TEXT("Slot freed"), Controller.TryAdmit(TEXT("1.1.1.4"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+    TestEqual(TEXT("No retry-after when admitted"), RetryAfter, 0.0f);
+    TestEqual(TEXT("Full again"), Controller.TryAdmit(TEXT("1.1.1.5"), 100.0, RetryAfter), EProxyAdmission::ShedGlobal);
+
+    // The shed login still paid its address token, an immediate retry is shed per address
+    TestEqual(TEXT("Shed globally, token spent"), Controller.TryAdmit(TEXT("1.1.1.5"), 100.0, RetryAfter), EProxyAdmission::ShedPerAddress);
+
+    Controller.Release();
+    Controller.Release();
+    const FProxyAdmissionStats Stats = Controller.GetStats();
+    TestEqual(TEXT("Nothing in flight"), Stats.InFlight, 0);
+    TestEqual(TEXT("Admitted"), Stats.Admitted, (uint64)3);
+    TestEqual(TEXT("Shed globally"), Stats.ShedGlobal, (uint64)2);
+    TestEqual(TEXT("Shed per address"), Stats.ShedPerAddress, (uint64)1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyAdmissionRetryAfterTest, "P_ProxyServer.AdmissionControl.RetryAfter", PROXY_TEST_FLAGS)
+
+bool FProxyAdmissionRetryAfterTest::RunTest(const FString &Parameters)
+{
+    FProxyAdmissionController Controller(0.5f, 5.0f, 1000, 1024);
+    float RetryAfter = 0.0f;
+
+    // Rate 0.5/s: an empty bucket needs 2 seconds for the next token, half of it after 1 second
+    TestEqual(TEXT("Admitted"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+    TestEqual(TEXT("Empty bucket"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::ShedPerAddress);
+    TestEqual(TEXT("Time for a whole token"), RetryAfter, 2.0f, 1e-4f);
+    TestEqual(TEXT("Half a token in"), Controller.TryAdmit(TEXT("1.1.1.1"), 101.0, RetryAfter), EProxyAdmission::ShedPerAddress);
+    TestEqual(TEXT("Time for the other half"), RetryAfter, 1.0f, 1e-4f);
+
+    // Coming back when told to gets in
+    TestEqual(TEXT("Admitted at retry-after"), Controller.TryAdmit(TEXT("1.1.1.1"), 101.0 + RetryAfter, RetryAfter), EProxyAdmission::Admitted);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyAdmissionNoRateTest, "P_ProxyServer.AdmissionControl.PerAddressDisabled", PROXY_TEST_FLAGS)
+
+bool FProxyAdmissionNoRateTest::RunTest(const FString &Parameters)
+{
+    // Rate <= 0 turns the per address buckets off, only the in-flight limit is left
+    for (const float Rate : {0.0f, -1.0f})
+    {
+        FProxyAdmissionController Controller(Rate, 5.0f, 3, 1024);
+        float RetryAfter = 0.0f;
+        TestFalse(TEXT("Per address limit off"), Controller.IsPerAddressLimited());
+
+        for (int32 Index = 0; Index < 3; ++Index)
+        {
+            TestEqual(TEXT("Same address admitted again and again"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+        }
+        TestEqual(TEXT("Global limit still applies"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::ShedGlobal);
+        Controller.Release();
+        TestEqual(TEXT("Admitted after a Release"), Controller.TryAdmit(TEXT("1.1.1.1"), 100.0, RetryAfter), EProxyAdmission::Admitted);
+        TestEqual(TEXT("Never shed per address"), Controller.GetStats().ShedPerAddress, (uint64)0);
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
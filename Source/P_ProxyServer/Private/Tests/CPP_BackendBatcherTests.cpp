@@ -0,0 +1,143 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_BackendBatcher.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    struct FTestBatchBackend
+    {
+        int32 Code = 200;
+        FString ErrorBody;
+        TArray<FString> Bodies;
+    };
+
+    // Answers a batch with ["r0:<payload 0>", "r1:<payload 1>", ...], or Code / ErrorBody when Code is not 2xx
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> test_batch_transport(const TSharedRef<FTestBatchBackend> &Backend)
+    {
+        return MakeShared<FProxyMockBackendTransport, ESPMode::ThreadSafe>([Backend](const FString &Url, const FString &Body, FString &OutResponse)
+                                                                           {
+                                                                               Backend->Bodies.Add(Body);
+                                                                               if (Backend->Code < 200 || Backend->Code >= 300)
+                                                                               {
+                                                                                   OutResponse = Backend->ErrorBody;
+                                                                                   return Backend->Code;
+                                                                               }
+
+                                                                               TArray<TSharedPtr<FJsonValue>> Elements;
+                                                                               TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Body);
+                                                                               FJsonSerializer::Deserialize(Reader, Elements);
+                                                                               TArray<FString> Responses;
+                                                                               for (int32 Index = 0; Index < Elements.Num(); ++Index)
+                                                                               {
+                                                                                   const FString Payload = Elements[Index]->Type == EJson::String ? Elements[Index]->AsString() : TEXT("json");
+                                                                                   Responses.Add(FString::Printf(TEXT("\"r%d:%s\""), Index, *Payload));
+                                                                               }
+                                                                               OutResponse = TEXT("[") + FString::Join(Responses, TEXT(",")) + TEXT("]");
+                                                                               return Backend->Code; });
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendBatcherBodyTest, "P_ProxyServer.BackendBatcher.Body", PROXY_TEST_FLAGS)
+
+bool FProxyBackendBatcherBodyTest::RunTest(const FString &Parameters)
+{
+    // Valid JSON objects / arrays are embedded, anything else (including almost-JSON) travels as a string
+    const TArray<FString> Payloads = {
+        TEXT(" {\"type\":\"lookup\",\"ids\":[1,2.5e3,-0]} "),
+        TEXT("plain"),
+        TEXT("{not json"),
+        TEXT("[true,false,null,\"\\u00e9\"]"),
+        TEXT("{\"a\":1} {\"b\":2}"),
+        TEXT("{\"a\":01}"),
+        TEXT("[1,]"),
+    };
+    TestEqual(TEXT("Batch body"), FProxyBackendBatcher::BuildBatchBody(Payloads),
+              FString(TEXT("[{\"type\":\"lookup\",\"ids\":[1,2.5e3,-0]},\"plain\",\"{not json\",[true,false,null,\"\\u00e9\"],\"{\\\"a\\\":1} {\\\"b\\\":2}\",\"{\\\"a\\\":01}\",\"[1,]\"]")));
+
+    // Whatever the payloads, the body must be one valid JSON array of the same length
+    TArray<TSharedPtr<FJsonValue>> Elements;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FProxyBackendBatcher::BuildBatchBody(Payloads));
+    TestTrue(TEXT("Batch body parses"), FJsonSerializer::Deserialize(Reader, Elements));
+    TestEqual(TEXT("One element per payload"), Elements.Num(), Payloads.Num());
+
+    TArray<FString> Responses;
+    TestTrue(TEXT("Split response"), FProxyBackendBatcher::SplitBatchResponse(TEXT("[\"x\",{\"k\":true},null]"), 3, Responses));
+    TestTrue(TEXT("Split elements"), Responses.Num() == 3 && Responses[0] == TEXT("x") && Responses[1] == TEXT("{\"k\":true}") && Responses[2].IsEmpty());
+    TestFalse(TEXT("Short response is refused"), FProxyBackendBatcher::SplitBatchResponse(TEXT("[\"x\"]"), 2, Responses));
+    TestFalse(TEXT("Non-array response is refused"), FProxyBackendBatcher::SplitBatchResponse(TEXT("{}"), 1, Responses));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendBatcherMockTest, "P_ProxyServer.BackendBatcher.MockTransport", PROXY_TEST_FLAGS)
+
+bool FProxyBackendBatcherMockTest::RunTest(const FString &Parameters)
+{
+    TSharedRef<FTestBatchBackend> Backend = MakeShared<FTestBatchBackend>();
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> Transport = test_batch_transport(Backend);
+    TSharedRef<FProxyBackendBatcher, ESPMode::ThreadSafe> Batcher = MakeShared<FProxyBackendBatcher, ESPMode::ThreadSafe>(Transport, TEXT("mock://batch"), 0.05f, 3);
+
+    TArray<FString> Answers;
+    TArray<FString> Errors;
+    auto Collect = [&Answers, &Errors](const FString &Response, const FString &Error)
+    {
+        Answers.Add(Response);
+        Errors.Add(Error);
+    };
+
+    // Four requests with MaxBatchSize 3: one full batch right away, the fourth when the window closes
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        Batcher->Enqueue(FString::Printf(TEXT("p%d"), Index), Collect);
+    }
+    TestEqual(TEXT("Full batch sent immediately"), Transport->GetNumRequests(), 1);
+    TestEqual(TEXT("Remainder waits for the window"), Batcher->GetNumQueued(), 1);
+    proxy_test_pump_ticker(0.2f);
+
+    TestEqual(TEXT("Two POSTs for four requests"), Transport->GetNumRequests(), 2);
+    TestEqual(TEXT("Every caller answered"), Answers.Num(), 4);
+    if (Answers.Num() == 4)
+    {
+        TestEqual(TEXT("Answer 0"), Answers[0], FString(TEXT("r0:p0")));
+        TestEqual(TEXT("Answer 2"), Answers[2], FString(TEXT("r2:p2")));
+        TestEqual(TEXT("Answer 3, second batch"), Answers[3], FString(TEXT("r0:p3")));
+        TestTrue(TEXT("No errors"), Errors[0].IsEmpty() && Errors[3].IsEmpty());
+    }
+
+    // A non-2xx batch fails every caller the way an unbatched request fails, error body included
+    Answers.Reset();
+    Errors.Reset();
+    Backend->Code = 503;
+    Backend->ErrorBody = TEXT("{\"error\":\"maintenance\"}");
+    Batcher->Enqueue(TEXT("a"), Collect);
+    Batcher->Enqueue(TEXT("b"), Collect);
+    Batcher->Flush();
+    proxy_test_pump_ticker(0.05f);
+
+    const FString Expected = FProxyBackendBatcher::DescribeFailure(true, 503, Backend->ErrorBody);
+    TestFalse(TEXT("503 is a failure"), Expected.IsEmpty());
+    TestEqual(TEXT("Both callers answered"), Errors.Num(), 2);
+    for (int32 Index = 0; Index < Errors.Num(); ++Index)
+    {
+        TestEqual(TEXT("Same error as unbatched"), Errors[Index], Expected);
+        TestEqual(TEXT("Error body passed along"), Answers[Index], Backend->ErrorBody);
+    }
+
+    // Connection failures are failures too, whatever the code
+    TestEqual(TEXT("Connection failure"), FProxyBackendBatcher::DescribeFailure(false, 0, FString()), FString(TEXT("Connection failed")));
+    TestTrue(TEXT("2xx is a success"), FProxyBackendBatcher::DescribeFailure(true, 204, FString()).IsEmpty());
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,164 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_BackendCache.h"
+#include "HAL/PlatformProcess.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendCacheGenerationTest, "P_ProxyServer.BackendCache.InvalidateWhileInFlight", PROXY_TEST_FLAGS)
+
+bool FProxyBackendCacheGenerationTest::RunTest(const FString &Parameters)
+{
+    FProxyBackendCache Cache(2);
+    FString Response;
+    bool bNegative = false;
+
+    // Nothing changed while the request was out, the answer is cached
+    uint64 Generation = Cache.GetGeneration(TEXT("Alice"));
+    Cache.Put(TEXT("Alice"), TEXT("lookup"), TEXT("ok"), false, 60.0f, Generation);
+    TestTrue(TEXT("Fresh answer cached"), Cache.Find(TEXT("alice"), TEXT("lookup"), Response, bNegative));
+
+    // Invalidated while in flight, with nothing cached yet: the late answer must not be stored
+    Generation = Cache.GetGeneration(TEXT("Bob"));
+    TestFalse(TEXT("Nothing to invalidate"), Cache.Invalidate(TEXT("BOB")));
+    Cache.Put(TEXT("Bob"), TEXT("lookup"), TEXT("old"), false, 60.0f, Generation);
+    TestFalse(TEXT("Stale answer dropped"), Cache.Find(TEXT("Bob"), TEXT("lookup"), Response, bNegative));
+    TestEqual(TEXT("Stale put counted"), Cache.GetStats().StalePuts, (uint64)1);
+
+    // Someone else's invalidation does not get in the way
+    Generation = Cache.GetGeneration(TEXT("Carol"));
+    Cache.Invalidate(TEXT("Dave"));
+    Cache.Put(TEXT("Carol"), TEXT("lookup"), TEXT("ok"), false, 60.0f, Generation);
+    TestTrue(TEXT("Other player's invalidation ignored"), Cache.Find(TEXT("Carol"), TEXT("lookup"), Response, bNegative));
+
+    // InvalidateAll covers every in-flight request
+    Generation = Cache.GetGeneration(TEXT("Erin"));
+    Cache.InvalidateAll();
+    Cache.Put(TEXT("Erin"), TEXT("lookup"), TEXT("old"), false, 60.0f, Generation);
+    TestFalse(TEXT("Stale after InvalidateAll"), Cache.Find(TEXT("Erin"), TEXT("lookup"), Response, bNegative));
+
+    // More invalidated players than MaxEntries: the per-player generations fold, older requests still lose
+    Generation = Cache.GetGeneration(TEXT("Frank"));
+    Cache.Invalidate(TEXT("Frank"));
+    Cache.Invalidate(TEXT("Grace"));
+    Cache.Invalidate(TEXT("Heidi"));
+    Cache.Put(TEXT("Frank"), TEXT("lookup"), TEXT("old"), false, 60.0f, Generation);
+    TestFalse(TEXT("Stale after folding"), Cache.Find(TEXT("Frank"), TEXT("lookup"), Response, bNegative));
+
+    Generation = Cache.GetGeneration(TEXT("Frank"));
+    Cache.Put(TEXT("Frank"), TEXT("lookup"), TEXT("new"), false, 60.0f, Generation);
+    TestTrue(TEXT("Requested after the invalidation, cached"), Cache.Find(TEXT("Frank"), TEXT("lookup"), Response, bNegative) && Response == TEXT("new"));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendCachePayloadsTest, "P_ProxyServer.BackendCache.EntriesPerPayload", PROXY_TEST_FLAGS)
+
+bool FProxyBackendCachePayloadsTest::RunTest(const FString &Parameters)
+{
+    FProxyBackendCache Cache(8);
+    FString Response;
+    bool bNegative = false;
+
+    // Different lookups of one player live side by side
+    const uint64 Generation = Cache.GetGeneration(TEXT("Alice"));
+    Cache.Put(TEXT("Alice"), TEXT("profile"), TEXT("p"), false, 60.0f, Generation);
+    Cache.Put(TEXT("Alice"), TEXT("inventory"), TEXT("i"), false, 60.0f, Generation);
+    Cache.Put(TEXT("Bob"), TEXT("profile"), TEXT("b"), false, 60.0f, Cache.GetGeneration(TEXT("Bob")));
+    TestTrue(TEXT("First payload kept"), Cache.Find(TEXT("Alice"), TEXT("profile"), Response, bNegative) && Response == TEXT("p"));
+    TestTrue(TEXT("Second payload kept"), Cache.Find(TEXT("ALICE"), TEXT("inventory"), Response, bNegative) && Response == TEXT("i"));
+    TestFalse(TEXT("Payload compared case-sensitively"), Cache.Find(TEXT("Alice"), TEXT("PROFILE"), Response, bNegative));
+    TestEqual(TEXT("Three entries"), Cache.GetStats().Num, 3);
+
+    // Storing a payload again replaces its answer, not the player's other entries
+    Cache.Put(TEXT("Alice"), TEXT("profile"), TEXT("p2"), false, 60.0f, Generation);
+    TestTrue(TEXT("Replaced"), Cache.Find(TEXT("Alice"), TEXT("profile"), Response, bNegative) && Response == TEXT("p2"));
+    TestEqual(TEXT("Still three entries"), Cache.GetStats().Num, 3);
+
+    // Invalidate drops every entry of the player and only those
+    TestTrue(TEXT("Invalidated"), Cache.Invalidate(TEXT("alice")));
+    TestFalse(TEXT("Profile gone"), Cache.Find(TEXT("Alice"), TEXT("profile"), Response, bNegative));
+    TestFalse(TEXT("Inventory gone"), Cache.Find(TEXT("Alice"), TEXT("inventory"), Response, bNegative));
+    TestTrue(TEXT("Other player kept"), Cache.Find(TEXT("Bob"), TEXT("profile"), Response, bNegative));
+    TestEqual(TEXT("Two invalidations counted"), Cache.GetStats().Invalidations, (uint64)2);
+    TestFalse(TEXT("Nothing left to invalidate"), Cache.Invalidate(TEXT("Alice")));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendCacheExpiryTest, "P_ProxyServer.BackendCache.Expiry", PROXY_TEST_FLAGS)
+
+bool FProxyBackendCacheExpiryTest::RunTest(const FString &Parameters)
+{
+    FProxyBackendCache Cache(8);
+    FString Response;
+    bool bNegative = false;
+
+    // A negative answer with a shorter TTL than the positive one, like BackendCache_NegativeTTLSeconds
+    Cache.Put(TEXT("Alice"), TEXT("lookup"), TEXT("ok"), false, 0.5f, Cache.GetGeneration(TEXT("Alice")));
+    Cache.Put(TEXT("Banned"), TEXT("lookup"), TEXT("banned"), true, 0.1f, Cache.GetGeneration(TEXT("Banned")));
+    TestTrue(TEXT("Negative answer served"), Cache.Find(TEXT("Banned"), TEXT("lookup"), Response, bNegative) && bNegative && Response == TEXT("banned"));
+    TestTrue(TEXT("Positive answer served"), Cache.Find(TEXT("Alice"), TEXT("lookup"), Response, bNegative) && !bNegative);
+    TestEqual(TEXT("Hits counted apart"), Cache.GetStats().NegativeHits, (uint64)1);
+
+    FPlatformProcess::Sleep(0.2f);
+    TestFalse(TEXT("Negative answer expired"), Cache.Find(TEXT("Banned"), TEXT("lookup"), Response, bNegative));
+    TestTrue(TEXT("Positive answer outlives it"), Cache.Find(TEXT("Alice"), TEXT("lookup"), Response, bNegative));
+
+    FPlatformProcess::Sleep(0.4f);
+    TestFalse(TEXT("Positive answer expired"), Cache.Find(TEXT("Alice"), TEXT("lookup"), Response, bNegative));
+
+    const FProxyBackendCacheStats Stats = Cache.GetStats();
+    TestEqual(TEXT("Expiries counted"), Stats.Expired, (uint64)2);
+    TestEqual(TEXT("Expired entries removed"), Stats.Num, 0);
+
+    // A TTL of 0 stores nothing
+    Cache.Put(TEXT("Carol"), TEXT("lookup"), TEXT("ok"), false, 0.0f, Cache.GetGeneration(TEXT("Carol")));
+    TestEqual(TEXT("Zero TTL not cached"), Cache.GetStats().Num, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendCacheLruTest, "P_ProxyServer.BackendCache.LruEviction", PROXY_TEST_FLAGS)
+
+bool FProxyBackendCacheLruTest::RunTest(const FString &Parameters)
+{
+    FProxyBackendCache Cache(3);
+    FString Response;
+    bool bNegative = false;
+
+    Cache.Put(TEXT("A"), TEXT("lookup"), TEXT("a"), false, 60.0f, Cache.GetGeneration(TEXT("A")));
+    Cache.Put(TEXT("B"), TEXT("lookup"), TEXT("b"), false, 60.0f, Cache.GetGeneration(TEXT("B")));
+    Cache.Put(TEXT("C"), TEXT("lookup"), TEXT("c"), false, 60.0f, Cache.GetGeneration(TEXT("C")));
+
+    // A hit makes A the most recently used, so B is the one to go
+    TestTrue(TEXT("A hit"), Cache.Find(TEXT("A"), TEXT("lookup"), Response, bNegative));
+    Cache.Put(TEXT("D"), TEXT("lookup"), TEXT("d"), false, 60.0f, Cache.GetGeneration(TEXT("D")));
+    TestFalse(TEXT("Least recently used evicted"), Cache.Find(TEXT("B"), TEXT("lookup"), Response, bNegative));
+    TestTrue(TEXT("A kept"), Cache.Find(TEXT("A"), TEXT("lookup"), Response, bNegative));
+    TestTrue(TEXT("C kept"), Cache.Find(TEXT("C"), TEXT("lookup"), Response, bNegative));
+    TestTrue(TEXT("D kept"), Cache.Find(TEXT("D"), TEXT("lookup"), Response, bNegative));
+    TestEqual(TEXT("One eviction"), Cache.GetStats().Evictions, (uint64)1);
+
+    // Replacing an entry refreshes it instead of evicting, and entries of one player count separately
+    Cache.Put(TEXT("A"), TEXT("lookup"), TEXT("a2"), false, 60.0f, Cache.GetGeneration(TEXT("A")));
+    TestEqual(TEXT("Replace does not evict"), Cache.GetStats().Evictions, (uint64)1);
+    Cache.Put(TEXT("A"), TEXT("other"), TEXT("x"), false, 60.0f, Cache.GetGeneration(TEXT("A")));
+    TestFalse(TEXT("C was least recently used"), Cache.Find(TEXT("C"), TEXT("lookup"), Response, bNegative));
+    TestTrue(TEXT("Both of A's entries kept"), Cache.Find(TEXT("A"), TEXT("lookup"), Response, bNegative) && Cache.Find(TEXT("A"), TEXT("other"), Response, bNegative));
+
+    // Evicted slots are reused and Invalidate still finds them
+    TestTrue(TEXT("Invalidated"), Cache.Invalidate(TEXT("A")));
+    const FProxyBackendCacheStats Stats = Cache.GetStats();
+    TestEqual(TEXT("Only D left"), Stats.Num, 1);
+    TestEqual(TEXT("Evictions"), Stats.Evictions, (uint64)2);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
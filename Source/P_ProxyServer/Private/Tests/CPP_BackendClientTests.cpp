@@ -0,0 +1,261 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_BackendClient.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Answers 503 to the first FailuresPerUrl attempts at every URL, 200 afterwards
+    struct FTestFlakyBackend
+    {
+        int32 FailuresPerUrl = 2;
+        TMap<FString, int32> Attempts;
+    };
+
+    struct FTestResult
+    {
+        bool bAnswered = false;
+        bool bConnected = false;
+        int32 Code = 0;
+        FString Body;
+        double AnsweredAt = 0.0;
+    };
+
+    FOnBackendTransportComplete test_collect(FTestResult &Result)
+    {
+        return [&Result](bool bConnected, int32 Code, const FString &Body)
+        {
+            Result.bAnswered = true;
+            Result.bConnected = bConnected;
+            Result.Code = Code;
+            Result.Body = Body;
+            Result.AnsweredAt = FPlatformTime::Seconds();
+        };
+    }
+
+    // Answers 200 with the URL it was sent to, so a test can tell which endpoint answered
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> test_echo_transport()
+    {
+        return MakeShared<FProxyMockBackendTransport, ESPMode::ThreadSafe>([](const FString &Url, const FString &Body, FString &OutResponse)
+                                                                           {
+                                                                               OutResponse = Url;
+                                                                               return 200; });
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendClientRetryTest, "P_ProxyServer.BackendClient.Retry", PROXY_TEST_FLAGS)
+
+bool FProxyBackendClientRetryTest::RunTest(const FString &Parameters)
+{
+    TSharedRef<FTestFlakyBackend> Backend = MakeShared<FTestFlakyBackend>();
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> Transport = MakeShared<FProxyMockBackendTransport, ESPMode::ThreadSafe>([Backend](const FString &Url, const FString &Body, FString &OutResponse)
+                                                                                                                                   {
+                                                                                                                                       int32 &Attempt = Backend->Attempts.FindOrAdd(Url);
+                                                                                                                                       return Attempt++ < Backend->FailuresPerUrl ? 503 : 200; });
+
+    FProxyBackendClientSettings Settings;
+    Settings.MaxRetries = 2;
+    Settings.RetryBaseDelaySeconds = 0.01f;
+    Settings.RetryMaxDelaySeconds = 0.02f;
+    TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Client = MakeShared<FProxyBackendClient, ESPMode::ThreadSafe>(Transport, Settings);
+
+    // Writes are sent once by default, the 503 goes straight back to the caller
+    FTestResult Write;
+    Client->Post(TEXT("mock://write"), TEXT("{}"), 0.0f, test_collect(Write));
+    proxy_test_pump_ticker(0.5f);
+    TestTrue(TEXT("Write answered"), Write.bAnswered);
+    TestEqual(TEXT("Write not retried"), Backend->Attempts.FindRef(TEXT("mock://write")), 1);
+    TestEqual(TEXT("Write sees the 503"), Write.Code, 503);
+    TestEqual(TEXT("No retries so far"), Client->GetNumRetries(), 0);
+
+    // Same for Send without the opt-in
+    FTestResult Send;
+    Client->Send(TEXT("mock://send"), TEXT("{}"), false, test_collect(Send));
+    proxy_test_pump_ticker(0.5f);
+    TestEqual(TEXT("Non-idempotent Send not retried"), Backend->Attempts.FindRef(TEXT("mock://send")), 1);
+    TestEqual(TEXT("Non-idempotent Send sees the 503"), Send.Code, 503);
+
+    // A read opts in and rides out the two 503s
+    FTestResult Read;
+    Client->PostIdempotent(TEXT("mock://read"), TEXT("{}"), 0.0f, test_collect(Read));
+    proxy_test_pump_ticker(0.5f);
+    TestTrue(TEXT("Read answered"), Read.bAnswered);
+    TestTrue(TEXT("Read connected"), Read.bConnected);
+    TestEqual(TEXT("Read succeeds after retrying"), Read.Code, 200);
+    TestEqual(TEXT("Read took three attempts"), Backend->Attempts.FindRef(TEXT("mock://read")), 3);
+    TestEqual(TEXT("Two retries"), Client->GetNumRetries(), 2);
+
+    // More failures than retries, the last 503 is what the caller gets
+    Backend->FailuresPerUrl = 5;
+    FTestResult Exhausted;
+    Client->Send(TEXT("mock://exhausted"), TEXT("{}"), true, test_collect(Exhausted));
+    proxy_test_pump_ticker(0.5f);
+    TestEqual(TEXT("MaxRetries + 1 attempts"), Backend->Attempts.FindRef(TEXT("mock://exhausted")), Settings.MaxRetries + 1);
+    TestEqual(TEXT("Exhausted read sees the 503"), Exhausted.Code, 503);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendClientHedgeTest, "P_ProxyServer.BackendClient.HedgeAfterP95", PROXY_TEST_FLAGS)
+
+bool FProxyBackendClientHedgeTest::RunTest(const FString &Parameters)
+{
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> Transport = test_echo_transport();
+    FProxyBackendClientSettings Settings;
+    Settings.AttemptTimeoutSeconds = 2.0f;
+    Settings.HedgeUrl = TEXT("mock://hedge");
+    Settings.HedgeMinDelaySeconds = 0.02f;
+    TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Client = MakeShared<FProxyBackendClient, ESPMode::ThreadSafe>(Transport, Settings);
+
+    // Until the primary has a latency history the hedge waits half the attempt timeout
+    TestEqual(TEXT("Cold hedge delay"), Client->GetHedgeDelaySeconds(TEXT("mock://primary")), 1.0f);
+
+    // A fast primary: its p95 becomes the hedge delay (never below HedgeMinDelaySeconds)
+    Transport->SetLatency(0.01f, TEXT("mock://primary"));
+    TArray<FTestResult> Warmup;
+    Warmup.SetNum(16);
+    for (FTestResult &Result : Warmup)
+    {
+        Client->Send(TEXT("mock://primary"), TEXT("{}"), false, test_collect(Result));
+    }
+    proxy_test_pump_realtime(0.1f);
+    const float HedgeDelay = Client->GetHedgeDelaySeconds(TEXT("mock://primary"));
+    TestTrue(TEXT("Hedge delay learnt from the p95"), HedgeDelay >= Settings.HedgeMinDelaySeconds && HedgeDelay < 0.1f);
+    TestEqual(TEXT("No hedges while warming up"), Client->GetNumHedges(), 0);
+
+    // The primary slows down: a read is hedged after the p95 and the hedge endpoint answers first
+    Transport->SetLatency(0.5f, TEXT("mock://primary"));
+    FTestResult Read;
+    const double Start = FPlatformTime::Seconds();
+    Client->Send(TEXT("mock://primary"), TEXT("{}"), true, test_collect(Read));
+    proxy_test_pump_realtime(0.2f);
+    TestTrue(TEXT("Hedged read answered"), Read.bAnswered && Read.Code == 200);
+    TestEqual(TEXT("Answered by the hedge endpoint"), Read.Body, FString(TEXT("mock://hedge")));
+    TestTrue(TEXT("Long before the slow primary"), Read.AnsweredAt - Start < 0.4);
+    TestEqual(TEXT("One hedge"), Client->GetNumHedges(), 1);
+
+    // A write is never hedged, it waits for the primary
+    FTestResult Write;
+    Client->Send(TEXT("mock://primary"), TEXT("{}"), false, test_collect(Write));
+    proxy_test_pump_realtime(0.2f);
+    TestFalse(TEXT("Write still waiting on the primary"), Write.bAnswered);
+    proxy_test_pump_realtime(0.5f);
+    TestEqual(TEXT("Write answered by the primary"), Write.Body, FString(TEXT("mock://primary")));
+    TestEqual(TEXT("Still one hedge"), Client->GetNumHedges(), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendClientTimeoutTest, "P_ProxyServer.BackendClient.AttemptTimeoutAndDeadline", PROXY_TEST_FLAGS)
+
+bool FProxyBackendClientTimeoutTest::RunTest(const FString &Parameters)
+{
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> Transport = test_echo_transport();
+    Transport->SetLatency(5.0f, TEXT("mock://slow"));
+
+    // Per attempt timeout: a write gets one attempt, cut off at AttemptTimeoutSeconds
+    {
+        FProxyBackendClientSettings Settings;
+        Settings.AttemptTimeoutSeconds = 0.1f;
+        Settings.DeadlineSeconds = 5.0f;
+        TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Client = MakeShared<FProxyBackendClient, ESPMode::ThreadSafe>(Transport, Settings);
+
+        FTestResult Write;
+        const double Start = FPlatformTime::Seconds();
+        Client->Send(TEXT("mock://slow"), TEXT("{}"), false, test_collect(Write));
+        proxy_test_pump_realtime(0.3f);
+        TestTrue(TEXT("Timed out write answered"), Write.bAnswered);
+        TestFalse(TEXT("Not connected"), Write.bConnected);
+        TestTrue(TEXT("Reported as a timeout"), Write.Body.Contains(TEXT("timed out")));
+        TestTrue(TEXT("At the attempt timeout"), Write.AnsweredAt - Start >= 0.09 && Write.AnsweredAt - Start < 0.25);
+    }
+
+    // Overall deadline: a read keeps retrying timed out attempts, but never past DeadlineSeconds
+    {
+        FProxyBackendClientSettings Settings;
+        Settings.AttemptTimeoutSeconds = 0.1f;
+        Settings.DeadlineSeconds = 0.25f;
+        Settings.MaxRetries = 10;
+        Settings.RetryBaseDelaySeconds = 0.01f;
+        Settings.RetryMaxDelaySeconds = 0.02f;
+        TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Client = MakeShared<FProxyBackendClient, ESPMode::ThreadSafe>(Transport, Settings);
+
+        const int32 RequestsBefore = Transport->GetNumRequests();
+        FTestResult Read;
+        const double Start = FPlatformTime::Seconds();
+        Client->Send(TEXT("mock://slow"), TEXT("{}"), true, test_collect(Read));
+        proxy_test_pump_realtime(0.6f);
+        TestTrue(TEXT("Read answered"), Read.bAnswered);
+        TestFalse(TEXT("Read failed"), Read.bConnected);
+        TestTrue(TEXT("Retried at least once"), Client->GetNumRetries() >= 1);
+        TestTrue(TEXT("Stopped long before MaxRetries"), Transport->GetNumRequests() - RequestsBefore < Settings.MaxRetries + 1);
+        TestTrue(TEXT("Answered by the deadline"), Read.AnsweredAt - Start < Settings.DeadlineSeconds + 0.1);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendClientCircuitTest, "P_ProxyServer.BackendClient.CircuitBreaker", PROXY_TEST_FLAGS)
+
+bool FProxyBackendClientCircuitTest::RunTest(const FString &Parameters)
+{
+    const FString Url = TEXT("mock://circuit");
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> Transport = test_echo_transport();
+    FProxyBackendClientSettings Settings;
+    Settings.MaxRetries = 0;
+    Settings.CircuitFailureThreshold = 3;
+    Settings.CircuitOpenSeconds = 0.2f;
+    TSharedRef<FProxyBackendClient, ESPMode::ThreadSafe> Client = MakeShared<FProxyBackendClient, ESPMode::ThreadSafe>(Transport, Settings);
+
+    // Consecutive failures open the circuit
+    Transport->SetFailureRate(1.0f, Url);
+    TArray<FTestResult> Failures;
+    Failures.SetNum(Settings.CircuitFailureThreshold);
+    for (FTestResult &Result : Failures)
+    {
+        Client->Send(Url, TEXT("{}"), false, test_collect(Result));
+        proxy_test_pump_realtime(0.02f);
+    }
+    TestEqual(TEXT("Open after the threshold"), Client->GetCircuitState(Url), EProxyCircuitState::Open);
+
+    // Open: fails fast without reaching the backend
+    const int32 RequestsWhenOpened = Transport->GetNumRequests();
+    FTestResult ShortCircuited;
+    Client->Send(Url, TEXT("{}"), false, test_collect(ShortCircuited));
+    TestTrue(TEXT("Answered immediately"), ShortCircuited.bAnswered);
+    TestEqual(TEXT("Circuit open reported"), ShortCircuited.Body, FString(TEXT("Circuit open")));
+    TestEqual(TEXT("Backend not called"), Transport->GetNumRequests(), RequestsWhenOpened);
+    TestEqual(TEXT("Counted as short circuited"), Client->GetNumShortCircuited(), 1);
+
+    // After CircuitOpenSeconds one probe is let through, everything else still fails fast
+    proxy_test_pump_realtime(0.25f);
+    TestEqual(TEXT("Half open after the open period"), Client->GetCircuitState(Url), EProxyCircuitState::HalfOpen);
+    Transport->SetFailureRate(0.0f, Url);
+    Transport->SetLatency(0.05f, Url);
+    FTestResult Probe;
+    FTestResult DuringProbe;
+    Client->Send(Url, TEXT("{}"), false, test_collect(Probe));
+    Client->Send(Url, TEXT("{}"), false, test_collect(DuringProbe));
+    TestEqual(TEXT("Only the probe reached the backend"), Transport->GetNumRequests(), RequestsWhenOpened + 1);
+    TestEqual(TEXT("Second request failed fast during the probe"), DuringProbe.Body, FString(TEXT("Circuit open")));
+
+    // A successful probe closes the circuit
+    proxy_test_pump_realtime(0.15f);
+    TestTrue(TEXT("Probe succeeded"), Probe.bAnswered && Probe.Code == 200);
+    TestEqual(TEXT("Closed after the probe"), Client->GetCircuitState(Url), EProxyCircuitState::Closed);
+
+    FTestResult AfterClose;
+    Client->Send(Url, TEXT("{}"), false, test_collect(AfterClose));
+    proxy_test_pump_realtime(0.15f);
+    TestTrue(TEXT("Requests flow again"), AfterClose.bAnswered && AfterClose.Code == 200);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
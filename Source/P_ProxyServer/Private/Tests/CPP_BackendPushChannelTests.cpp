@@ -0,0 +1,114 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_BackendPushChannel.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformProcess.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    struct FTestApplied
+    {
+        TArray<int64> Seqs;
+        TArray<EProxyPushEventType> Types;
+    };
+
+    TSharedRef<FJsonObject> test_roles_event(const FString &PlayerId)
+    {
+        TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("type"), TEXT("roles"));
+        Event->SetStringField(TEXT("playerId"), PlayerId);
+        return Event;
+    }
+
+    FProxyPushEvent test_sequenced_event(int64 Seq)
+    {
+        FProxyPushEvent Event;
+        Event.Seq = Seq;
+        Event.Type = EProxyPushEventType::RolesChanged;
+        return Event;
+    }
+
+    // Frames are parsed on a background task, so unlike proxy_test_pump_ticker this also gives that task time to run
+    bool test_pump_until(TFunctionRef<bool()> Condition, float MaxSeconds = 5.0f)
+    {
+        for (float Elapsed = 0.0f; Elapsed <= MaxSeconds; Elapsed += 0.01f)
+        {
+            FTSTicker::GetCoreTicker().Tick(0.01f);
+            if (Condition())
+            {
+                return true;
+            }
+            FPlatformProcess::Sleep(0.001f);
+        }
+        return false;
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyBackendPushChannelOrderingTest, "P_ProxyServer.BackendPushChannel.Ordering", PROXY_TEST_FLAGS)
+
+bool FProxyBackendPushChannelOrderingTest::RunTest(const FString &Parameters)
+{
+    TSharedRef<FProxyMockPushServer, ESPMode::ThreadSafe> Server = MakeShared<FProxyMockPushServer, ESPMode::ThreadSafe>();
+    TSharedRef<FTestApplied> Applied = MakeShared<FTestApplied>();
+    TSharedRef<FProxyBackendPushChannel, ESPMode::ThreadSafe> Channel = MakeShared<FProxyBackendPushChannel, ESPMode::ThreadSafe>(
+        Server->MakeConnectionFactory(),
+        [Applied](const TArray<FProxyPushEvent> &Events)
+        {
+            for (const FProxyPushEvent &Event : Events)
+            {
+                Applied->Seqs.Add(Event.Seq);
+                Applied->Types.Add(Event.Type);
+            }
+        });
+
+    Channel->Start(0);
+    TestTrue(TEXT("Connected"), test_pump_until([&]()
+                                                { return Channel->IsConnected(); }));
+
+    // A burst is applied once, in sequence order
+    for (int32 Index = 1; Index <= 3; ++Index)
+    {
+        Server->Publish(test_roles_event(FString::Printf(TEXT("P%d"), Index)));
+    }
+    TestTrue(TEXT("Burst applied"), test_pump_until([&]()
+                                                    { return Channel->GetLastAppliedSeq() == 3; }));
+    TestEqual(TEXT("Burst in order"), Applied->Seqs, TArray<int64>({1, 2, 3}));
+
+    // An unreadable frame is skipped in place, the channel moves on without waiting for a gap timeout or reconnecting
+    const int64 MalformedSeq = Server->PublishMalformed();
+    Server->Publish(test_roles_event(TEXT("P5")));
+    TestTrue(TEXT("Moved past the unreadable frame"), test_pump_until([&]()
+                                                                      { return Channel->GetLastAppliedSeq() == 5; }));
+    TestEqual(TEXT("Order kept around the unreadable frame"), Applied->Seqs, TArray<int64>({1, 2, 3, 4, 5}));
+    TestTrue(TEXT("Unreadable frame stands in as Malformed"), Applied->Types.IsValidIndex(3) && Applied->Types[3] == EProxyPushEventType::Malformed && MalformedSeq == 4);
+    TestEqual(TEXT("One parse error"), Channel->GetNumParseErrors(), 1);
+    TestEqual(TEXT("One skipped event"), Channel->GetNumSkippedEvents(), 1);
+    TestEqual(TEXT("No reconnect"), Channel->GetNumReconnects(), 0);
+
+    // Missed while disconnected, re-sent by the resume. The resume re-sends nothing that was already applied.
+    Server->DropConnections();
+    Server->Publish(test_roles_event(TEXT("P6")));
+    TestTrue(TEXT("Resumed"), test_pump_until([&]()
+                                              { return Channel->GetLastAppliedSeq() == 6; }));
+    TestEqual(TEXT("Each event applied once"), Applied->Seqs, TArray<int64>({1, 2, 3, 4, 5, 6}));
+    TestEqual(TEXT("One reconnect"), Channel->GetNumReconnects(), 1);
+
+    // Events from elsewhere (HTTP) share the ordering and dedup: ahead of time waits, duplicates are dropped
+    Channel->Submit({test_sequenced_event(8)});
+    TestEqual(TEXT("Seq 8 waits for 7"), Channel->GetLastAppliedSeq(), (int64)6);
+    Channel->Submit({test_sequenced_event(6), test_sequenced_event(7)});
+    TestEqual(TEXT("Gap filled"), Channel->GetLastAppliedSeq(), (int64)8);
+    TestEqual(TEXT("Submitted events in order, duplicate dropped"), Applied->Seqs, TArray<int64>({1, 2, 3, 4, 5, 6, 7, 8}));
+
+    Channel->Stop();
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
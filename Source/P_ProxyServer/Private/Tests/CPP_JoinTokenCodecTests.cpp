@@ -0,0 +1,293 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_JoinTokenCodec.h"
+#include "CPP_BPL__ProxyServer.h"
+#include "CPP_Sha256.h"
+#include "Misc/Base64.h"
+#include "JsonObjectConverter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    FSessionJoinToken test_token(const FString &PlayerId, int64 TimeStamp, const FString &Secret)
+    {
+        FSessionJoinToken Token;
+        Token.playerID = PlayerId;
+        Token.timeStamp = TimeStamp;
+        Token.sessionSecret = Secret;
+        return Token;
+    }
+
+    bool test_parse(const TCHAR *Json, FSessionJoinToken &OutToken)
+    {
+        return FJoinTokenJsonCodec::Parse(Json, FCString::Strlen(Json), OutToken);
+    }
+
+    bool test_parse_utf8(const ANSICHAR *Json, FSessionJoinToken &OutToken)
+    {
+        return FJoinTokenJsonCodec::ParseUtf8(Json, FCStringAnsi::Strlen(Json), OutToken);
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyJoinTokenJsonCodecTest, "P_ProxyServer.JoinTokenCodec.Json", PROXY_TEST_FLAGS)
+
+bool FProxyJoinTokenJsonCodecTest::RunTest(const FString &Parameters)
+{
+    // Canonical output: fixed key order, no whitespace, minimal escaping, non-ASCII passed through
+    const FString Accented = UTF8_TO_TCHAR("\xC3\xA9");
+    const FSessionJoinToken Escaped = test_token(TEXT("a\"b\\c\n\x01"), -5, Accented);
+    FString Json;
+    FJoinTokenJsonCodec::Write(Escaped, Json);
+    TestEqual(TEXT("Canonical output"), Json, FString(TEXT("{\"playerID\":\"a\\\"b\\\\c\\n\\u0001\",\"timeStamp\":-5,\"sessionSecret\":\"")) + Accented + TEXT("\"}"));
+    TestEqual(TEXT("SessionJoinToken_ToCanonicalJson matches the codec"), UCPP_BPL__ProxyServer::SessionJoinToken_ToCanonicalJson(Escaped), Json);
+
+    FJoinTokenJsonCodec::FUtf8Buffer Utf8;
+    FJoinTokenJsonCodec::WriteUtf8(Escaped, Utf8);
+    const FTCHARToUTF8 ExpectedUtf8(*Json);
+    TestTrue(TEXT("WriteUtf8 produces the UTF-8 of Write"), Utf8.Num() == ExpectedUtf8.Length() && FMemory::Memcmp(Utf8.GetData(), ExpectedUtf8.Get(), Utf8.Num()) == 0);
+
+    FSessionJoinToken Parsed;
+    TestTrue(TEXT("Round trip parses"), test_parse(*Json, Parsed));
+    TestTrue(TEXT("Round trip is lossless"), Parsed.playerID == Escaped.playerID && Parsed.timeStamp == Escaped.timeStamp && Parsed.sessionSecret == Escaped.sessionSecret);
+    Parsed = FSessionJoinToken();
+    TestTrue(TEXT("UTF-8 round trip parses"), FJoinTokenJsonCodec::ParseUtf8(Utf8.GetData(), Utf8.Num(), Parsed));
+    TestEqual(TEXT("UTF-8 round trip secret"), Parsed.sessionSecret, Accented);
+
+    // Every escape the parser accepts, whitespace between tokens, keys in any case
+    Parsed = FSessionJoinToken();
+    TestTrue(TEXT("Escapes parse"), test_parse(TEXT(" { \"PlayerId\" : \"x\\/y\\t\\b\\f\\r\\\"\" , \"TIMESTAMP\":7, \"sessionSecret\":\"\\u00e9\" } "), Parsed));
+    TestEqual(TEXT("Escaped playerID"), Parsed.playerID, FString(TEXT("x/y\t\b\f\r\"")));
+    TestEqual(TEXT("\\u escape"), Parsed.sessionSecret, Accented);
+
+    // Surrogate pairs arrive as two \u escapes and must equal the raw UTF-8 character
+    const FString Emoji = UTF8_TO_TCHAR("\xF0\x9F\x98\x80");
+    Parsed = FSessionJoinToken();
+    TestTrue(TEXT("Surrogate pair parses"), test_parse(TEXT("{\"playerID\":\"\\ud83d\\ude00\",\"timeStamp\":1,\"sessionSecret\":\"s\"}"), Parsed));
+    TestEqual(TEXT("Surrogate pair decodes"), Parsed.playerID, Emoji);
+    Parsed = FSessionJoinToken();
+    TestTrue(TEXT("Raw 4-byte UTF-8 parses"), test_parse_utf8("{\"playerID\":\"\xF0\x9F\x98\x80\",\"timeStamp\":1,\"sessionSecret\":\"s\"}", Parsed));
+    TestEqual(TEXT("Raw 4-byte UTF-8 decodes"), Parsed.playerID, Emoji);
+
+    // int64 limits, one past either end is left to the reflective path
+    Parsed = FSessionJoinToken();
+    TestTrue(TEXT("MAX_int64 parses"), test_parse(TEXT("{\"timeStamp\":9223372036854775807}"), Parsed));
+    TestEqual(TEXT("MAX_int64"), Parsed.timeStamp, MAX_int64);
+    TestTrue(TEXT("MIN_int64 parses"), test_parse(TEXT("{\"timeStamp\":-9223372036854775808}"), Parsed));
+    TestEqual(TEXT("MIN_int64"), Parsed.timeStamp, MIN_int64);
+    TestFalse(TEXT("MAX_int64 + 1 falls back"), test_parse(TEXT("{\"timeStamp\":9223372036854775808}"), Parsed));
+    TestFalse(TEXT("MIN_int64 - 1 falls back"), test_parse(TEXT("{\"timeStamp\":-9223372036854775809}"), Parsed));
+    Json.Reset();
+    FJoinTokenJsonCodec::Write(test_token(TEXT("p"), MIN_int64, TEXT("s")), Json);
+    TestTrue(TEXT("MIN_int64 is written exactly"), Json.Contains(TEXT("\"timeStamp\":-9223372036854775808,")));
+
+    // Fields missing from the JSON keep their current value
+    Parsed = test_token(TEXT("kept"), 42, TEXT("kept"));
+    TestTrue(TEXT("Partial object parses"), test_parse(TEXT("{\"sessionSecret\":\"new\"}"), Parsed));
+    TestTrue(TEXT("Missing fields are kept"), Parsed.playerID == TEXT("kept") && Parsed.timeStamp == 42 && Parsed.sessionSecret == TEXT("new"));
+
+    // Input the fast path does not fully understand is refused untouched, for the reflective fallback
+    const TCHAR *FallbackCases[] = {
+        TEXT("{\"playerID\":\"p\",\"extra\":1}"),     // Unknown field
+        TEXT("{\"timeStamp\":\"12\"}"),               // Quoted timestamp
+        TEXT("{\"timeStamp\":1.5}"),                  // Fraction
+        TEXT("{\"timeStamp\":1e3}"),                  // Exponent
+        TEXT("{\"playerID\":\"p\""),                  // Unterminated object
+        TEXT("{\"playerID\":\"p}"),                   // Unterminated string
+        TEXT("{\"playerID\":\"p\"} x"),               // Trailing garbage
+        TEXT("{\"playerID\":\"\\x\"}"),               // Unknown escape
+        TEXT("{\"playerID\":\"\\u12\"}"),             // Short \u escape
+        TEXT("{\"playerID\":\"a\nb\"}"),              // Raw control character
+    };
+    for (const TCHAR *Case : FallbackCases)
+    {
+        Parsed = test_token(TEXT("untouched"), 1, TEXT("untouched"));
+        TestFalse(FString::Printf(TEXT("Fast path refuses %s"), Case), test_parse(Case, Parsed));
+        TestEqual(FString::Printf(TEXT("Token untouched by %s"), Case), Parsed.playerID, FString(TEXT("untouched")));
+    }
+
+    // The Blueprint entry point still accepts what the fast path refuses
+    Parsed = FSessionJoinToken();
+    TestTrue(TEXT("FromJson falls back for unknown fields"), UCPP_BPL__ProxyServer::SessionJoinToken_FromJson(TEXT("{\"playerID\":\"p\",\"timeStamp\":3,\"sessionSecret\":\"s\",\"extra\":true}"), Parsed));
+    TestTrue(TEXT("Fallback result"), Parsed.playerID == TEXT("p") && Parsed.timeStamp == 3 && Parsed.sessionSecret == TEXT("s"));
+
+    // ToJson keeps the converter's output, which reads back to the same token
+    FString ConverterJson;
+    TestTrue(TEXT("ToJson"), UCPP_BPL__ProxyServer::SessionJoinToken_ToJson(Escaped, ConverterJson));
+    Parsed = FSessionJoinToken();
+    TestTrue(TEXT("ToJson output reads back"), UCPP_BPL__ProxyServer::SessionJoinToken_FromJson(ConverterJson, Parsed));
+    TestTrue(TEXT("ToJson round trip"), Parsed.playerID == Escaped.playerID && Parsed.timeStamp == Escaped.timeStamp && Parsed.sessionSecret == Escaped.sessionSecret);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyJoinTokenBinaryCodecTest, "P_ProxyServer.JoinTokenCodec.Binary", PROXY_TEST_FLAGS)
+
+bool FProxyJoinTokenBinaryCodecTest::RunTest(const FString &Parameters)
+{
+    const FSessionJoinToken Token = test_token(UTF8_TO_TCHAR("player-\xF0\x9F\x98\x80"), MIN_int64, TEXT("secret"));
+
+    TArray<uint8> Bytes;
+    TestTrue(TEXT("EncodeToken"), FJoinTokenBinaryCodec::EncodeToken(Token, Bytes));
+    TestTrue(TEXT("Encoded token is detected as binary"), FJoinTokenBinaryCodec::IsBinary(Bytes.GetData(), Bytes.Num()));
+
+    FSessionJoinToken Decoded;
+    TestTrue(TEXT("DecodeToken"), FJoinTokenBinaryCodec::DecodeToken(Bytes.GetData(), Bytes.Num(), Decoded));
+    TestTrue(TEXT("Binary round trip is lossless"), Decoded.playerID == Token.playerID && Decoded.timeStamp == Token.timeStamp && Decoded.sessionSecret == Token.sessionSecret);
+
+    Decoded = FSessionJoinToken();
+    TestTrue(TEXT("DecodeTokenAny takes binary"), FJoinTokenBinaryCodec::DecodeTokenAny(Bytes.GetData(), Bytes.Num(), Decoded));
+    TestEqual(TEXT("DecodeTokenAny binary playerID"), Decoded.playerID, Token.playerID);
+
+    // Truncated or padded input is refused, never half decoded
+    for (int32 Length = 0; Length < Bytes.Num(); ++Length)
+    {
+        Decoded = test_token(TEXT("untouched"), 1, TEXT("untouched"));
+        if (FJoinTokenBinaryCodec::DecodeToken(Bytes.GetData(), Length, Decoded) || Decoded.playerID != TEXT("untouched"))
+        {
+            AddError(FString::Printf(TEXT("Token truncated to %d of %d bytes was accepted"), Length, Bytes.Num()));
+        }
+    }
+    TArray<uint8> Padded = Bytes;
+    Padded.Add(0);
+    TestFalse(TEXT("Trailing bytes are refused"), FJoinTokenBinaryCodec::DecodeToken(Padded.GetData(), Padded.Num(), Decoded));
+    TArray<uint8> WrongVersion = Bytes;
+    WrongVersion[1] = FJoinTokenBinaryCodec::Version + 1;
+    TestFalse(TEXT("Unknown version is refused"), FJoinTokenBinaryCodec::DecodeToken(WrongVersion.GetData(), WrongVersion.Num(), Decoded));
+
+    // JSON through the same entry point: canonical fast path, and the reflective fallback for extra fields
+    const FTCHARToUTF8 CanonicalJson(*UCPP_BPL__ProxyServer::SessionJoinToken_ToCanonicalJson(Token));
+    Decoded = FSessionJoinToken();
+    TestTrue(TEXT("DecodeTokenAny takes canonical JSON"), FJoinTokenBinaryCodec::DecodeTokenAny((const uint8 *)CanonicalJson.Get(), CanonicalJson.Length(), Decoded));
+    TestTrue(TEXT("Canonical JSON decodes to the same token"), Decoded.playerID == Token.playerID && Decoded.timeStamp == Token.timeStamp && Decoded.sessionSecret == Token.sessionSecret);
+
+    const ANSICHAR *ExtendedJson = "{\"playerID\":\"p\",\"timeStamp\":9,\"sessionSecret\":\"s\",\"issuer\":\"backend\"}";
+    Decoded = FSessionJoinToken();
+    TestTrue(TEXT("DecodeTokenAny falls back for extra JSON fields"), FJoinTokenBinaryCodec::DecodeTokenAny((const uint8 *)ExtendedJson, FCStringAnsi::Strlen(ExtendedJson), Decoded));
+    TestTrue(TEXT("Fallback JSON result"), Decoded.playerID == TEXT("p") && Decoded.timeStamp == 9 && Decoded.sessionSecret == TEXT("s"));
+
+    // Encrypted token: hex signature and Base64 ciphertext travel as raw bytes
+    uint8 Digest[FSha256Context::DigestSize];
+    FSha256Context::HashBuffer((const uint8 *)"signature", 9, Digest);
+    const uint8 Ciphertext[] = {0x00, 0x01, 0x7F, 0x80, 0xFE, 0xFF};
+
+    FSessionJoinTokenEncrypted Encrypted;
+    Encrypted.playerID = TEXT("p");
+    Encrypted.signature = FSha256Context::DigestToHex(Digest);
+    Encrypted.sessionJoinTokenEncryptedBASE64 = FBase64::Encode(Ciphertext, sizeof(Ciphertext));
+    TestTrue(TEXT("EncodeEncrypted"), FJoinTokenBinaryCodec::EncodeEncrypted(Encrypted, Bytes));
+
+    FSessionJoinTokenEncrypted DecodedEncrypted;
+    TArray<uint8> RawCiphertext;
+    TestTrue(TEXT("DecodeEncrypted"), FJoinTokenBinaryCodec::DecodeEncrypted(Bytes.GetData(), Bytes.Num(), DecodedEncrypted, &RawCiphertext));
+    TestEqual(TEXT("Encrypted playerID"), DecodedEncrypted.playerID, Encrypted.playerID);
+    TestEqual(TEXT("Encrypted signature"), DecodedEncrypted.signature, Encrypted.signature);
+    TestEqual(TEXT("Encrypted ciphertext"), DecodedEncrypted.sessionJoinTokenEncryptedBASE64, Encrypted.sessionJoinTokenEncryptedBASE64);
+    TestTrue(TEXT("Raw ciphertext"), RawCiphertext.Num() == sizeof(Ciphertext) && FMemory::Memcmp(RawCiphertext.GetData(), Ciphertext, sizeof(Ciphertext)) == 0);
+
+    Encrypted.signature = TEXT("not hex");
+    TestFalse(TEXT("A signature that is not hex cannot be encoded"), FJoinTokenBinaryCodec::EncodeEncrypted(Encrypted, Bytes));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyJoinTokenJsonCodecPerfTest, "P_ProxyServer.JoinTokenCodec.JsonVsConverter", PROXY_PERF_TEST_FLAGS)
+
+bool FProxyJoinTokenJsonCodecPerfTest::RunTest(const FString &Parameters)
+{
+    constexpr int32 NumTokens = 64;
+    constexpr int32 Rounds = 200;
+    constexpr int32 Runs = 5;
+
+    // Realistic tokens: GUID-sized ids and secrets, a millisecond timestamp, the odd escape
+    TArray<FSessionJoinToken> Tokens;
+    TArray<FString> Jsons;
+    for (int32 Index = 0; Index < NumTokens; ++Index)
+    {
+        FSessionJoinToken Token = test_token(FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens), 1732000000000LL + Index, FGuid::NewGuid().ToString() + FGuid::NewGuid().ToString());
+        if (Index % 8 == 0)
+        {
+            Token.playerID += TEXT("\"quoted\"");
+        }
+        FString Json;
+        FJoinTokenJsonCodec::Write(Token, Json);
+        Tokens.Add(MoveTemp(Token));
+        Jsons.Add(MoveTemp(Json));
+    }
+
+    // Same input, same answer
+    for (int32 Index = 0; Index < NumTokens; ++Index)
+    {
+        FSessionJoinToken Fast;
+        FSessionJoinToken Reflected;
+        const bool bFast = FJoinTokenJsonCodec::Parse(*Jsons[Index], Jsons[Index].Len(), Fast);
+        const bool bReflected = FJsonObjectConverter::JsonObjectStringToUStruct<FSessionJoinToken>(Jsons[Index], &Reflected, 0, 0);
+        TestTrue(TEXT("Both parse"), bFast && bReflected);
+        TestTrue(TEXT("Both agree"), Fast.playerID == Reflected.playerID && Fast.timeStamp == Reflected.timeStamp && Fast.sessionSecret == Reflected.sessionSecret);
+    }
+
+    int64 Sink = 0; // Keeps the loops from being optimised away
+    const double CodecParse = proxy_test_best_seconds(Runs, [&]()
+                                                      {
+                                                          for (int32 Round = 0; Round < Rounds; ++Round)
+                                                          {
+                                                              for (const FString &Json : Jsons)
+                                                              {
+                                                                  FSessionJoinToken Token;
+                                                                  FJoinTokenJsonCodec::Parse(*Json, Json.Len(), Token);
+                                                                  Sink += Token.timeStamp;
+                                                              }
+                                                          } });
+    const double ConverterParse = proxy_test_best_seconds(Runs, [&]()
+                                                          {
+                                                              for (int32 Round = 0; Round < Rounds; ++Round)
+                                                              {
+                                                                  for (const FString &Json : Jsons)
+                                                                  {
+                                                                      FSessionJoinToken Token;
+                                                                      FJsonObjectConverter::JsonObjectStringToUStruct<FSessionJoinToken>(Json, &Token, 0, 0);
+                                                                      Sink += Token.timeStamp;
+                                                                  }
+                                                              } });
+    const double CodecWrite = proxy_test_best_seconds(Runs, [&]()
+                                                      {
+                                                          FString Json;
+                                                          for (int32 Round = 0; Round < Rounds; ++Round)
+                                                          {
+                                                              for (const FSessionJoinToken &Token : Tokens)
+                                                              {
+                                                                  Json.Reset();
+                                                                  FJoinTokenJsonCodec::Write(Token, Json);
+                                                                  Sink += Json.Len();
+                                                              }
+                                                          } });
+    const double ConverterWrite = proxy_test_best_seconds(Runs, [&]()
+                                                          {
+                                                              for (int32 Round = 0; Round < Rounds; ++Round)
+                                                              {
+                                                                  for (const FSessionJoinToken &Token : Tokens)
+                                                                  {
+                                                                      FString Json;
+                                                                      FJsonObjectConverter::UStructToJsonObjectString(FSessionJoinToken::StaticStruct(), &Token, Json, 0, 0, 0, nullptr, false);
+                                                                      Sink += Json.Len();
+                                                                  }
+                                                              } });
+
+    const double Calls = (double)Rounds * NumTokens;
+    AddInfo(FString::Printf(TEXT("Parse: codec %.0f ns, FJsonObjectConverter %.0f ns per token (%.1fx)"), CodecParse * 1e9 / Calls, ConverterParse * 1e9 / Calls, ConverterParse / FMath::Max(CodecParse, 1e-9)));
+    AddInfo(FString::Printf(TEXT("Write: codec %.0f ns, FJsonObjectConverter %.0f ns per token (%.1fx)"), CodecWrite * 1e9 / Calls, ConverterWrite * 1e9 / Calls, ConverterWrite / FMath::Max(CodecWrite, 1e-9)));
+    AddInfo(FString::Printf(TEXT("(checksum %lld)"), Sink));
+
+    // Only a gross regression fails: the direct codec must at least beat building a DOM and walking reflection
+    TestTrue(TEXT("Codec parses faster than the converter"), CodecParse < ConverterParse);
+    TestTrue(TEXT("Codec writes faster than the converter"), CodecWrite < ConverterWrite);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,202 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_Metrics.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Value of the exported sample line "<Series> <value>", -1 when the series is not there
+    double test_sample(const FString &Export, const FString &Series)
+    {
+        TArray<FString> Lines;
+        Export.ParseIntoArrayLines(Lines);
+        const FString Prefix = Series + TEXT(" ");
+        for (const FString &Line : Lines)
+        {
+            if (Line.StartsWith(Prefix, ESearchCase::CaseSensitive))
+            {
+                return FCString::Atod(*Line.Mid(Prefix.Len()));
+            }
+        }
+        return -1.0;
+    }
+
+    int32 test_count_occurrences(const FString &Text, const FString &Needle)
+    {
+        int32 Count = 0;
+        for (int32 From = Text.Find(Needle, ESearchCase::CaseSensitive); From != INDEX_NONE; From = Text.Find(Needle, ESearchCase::CaseSensitive, ESearchDir::FromStart, From + 1))
+        {
+            ++Count;
+        }
+        return Count;
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyMetricsBucketTest, "P_ProxyServer.Metrics.Buckets", PROXY_TEST_FLAGS)
+
+bool FProxyMetricsBucketTest::RunTest(const FString &Parameters)
+{
+    TestEqual(TEXT("Zero in bucket 0"), FProxyMetrics::BucketIndex(0), 0);
+    TestEqual(TEXT("Below 2^MinExponent in bucket 0"), FProxyMetrics::BucketIndex((1ull << FProxyMetrics::MinExponent) - 1), 0);
+    TestEqual(TEXT("2^MinExponent starts bucket 1"), FProxyMetrics::BucketIndex(1ull << FProxyMetrics::MinExponent), 1);
+    TestEqual(TEXT("Longest durations in the last bucket"), FProxyMetrics::BucketIndex(MAX_uint64), FProxyMetrics::NumBuckets - 1);
+
+    // Every bucket is [upper bound of the previous one, its own upper bound), with no gaps or overlaps
+    int32 NumWrong = 0;
+    for (int32 Index = 1; Index < FProxyMetrics::NumBuckets - 1; ++Index)
+    {
+        const uint64 Lower = FProxyMetrics::BucketUpperBound(Index - 1);
+        const uint64 Upper = FProxyMetrics::BucketUpperBound(Index);
+        if (Lower >= Upper || FProxyMetrics::BucketIndex(Lower) != Index || FProxyMetrics::BucketIndex(Upper - 1) != Index || FProxyMetrics::BucketIndex(Upper) != Index + 1)
+        {
+            ++NumWrong;
+        }
+    }
+    TestEqual(TEXT("Buckets round-trip through their bounds"), NumWrong, 0);
+
+    // The upper bound a quantile reports is never below the value, and at most 1 / 2^SubBucketBits above it
+    const double MaxError = 1.0 / (double)(1 << FProxyMetrics::SubBucketBits);
+    double WorstError = 0.0;
+    for (uint64 Cycles = 1ull << FProxyMetrics::MinExponent; Cycles < (1ull << 36); Cycles = Cycles * 9 / 8 + 7)
+    {
+        const uint64 Upper = FProxyMetrics::BucketUpperBound(FProxyMetrics::BucketIndex(Cycles));
+        TestTrue(TEXT("Upper bound above the value"), Upper > Cycles);
+        WorstError = FMath::Max(WorstError, (double)(Upper - Cycles) / (double)Cycles);
+    }
+    AddInfo(FString::Printf(TEXT("Worst relative over-report %.1f%%"), WorstError * 100.0));
+    TestTrue(TEXT("Relative error within one sub-bucket"), WorstError <= MaxError);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyMetricsQuantileTest, "P_ProxyServer.Metrics.Quantiles", PROXY_TEST_FLAGS)
+
+bool FProxyMetricsQuantileTest::RunTest(const FString &Parameters)
+{
+    uint64 Buckets[FProxyMetrics::NumBuckets] = {};
+    TestEqual(TEXT("Empty histogram"), FProxyMetrics::QuantileCycles(Buckets, 0, 0.5), (uint64)0);
+
+    // 100 samples: 90 fast, 9 slower, 1 outlier
+    const int32 Fast = FProxyMetrics::BucketIndex(1000);
+    const int32 Slow = FProxyMetrics::BucketIndex(10000);
+    const int32 Outlier = FProxyMetrics::BucketIndex(1000000);
+    Buckets[Fast] = 90;
+    Buckets[Slow] = 9;
+    Buckets[Outlier] = 1;
+
+    TestEqual(TEXT("Lowest rank"), FProxyMetrics::QuantileCycles(Buckets, 100, 0.0), FProxyMetrics::BucketUpperBound(Fast));
+    TestEqual(TEXT("p50"), FProxyMetrics::QuantileCycles(Buckets, 100, 0.5), FProxyMetrics::BucketUpperBound(Fast));
+    TestEqual(TEXT("p90 is the 90th sample, still fast"), FProxyMetrics::QuantileCycles(Buckets, 100, 0.9), FProxyMetrics::BucketUpperBound(Fast));
+    TestEqual(TEXT("p91 moves on"), FProxyMetrics::QuantileCycles(Buckets, 100, 0.91), FProxyMetrics::BucketUpperBound(Slow));
+    TestEqual(TEXT("p99"), FProxyMetrics::QuantileCycles(Buckets, 100, 0.99), FProxyMetrics::BucketUpperBound(Slow));
+    TestEqual(TEXT("p99.9 rounds up to the outlier"), FProxyMetrics::QuantileCycles(Buckets, 100, 0.999), FProxyMetrics::BucketUpperBound(Outlier));
+    TestEqual(TEXT("Max"), FProxyMetrics::QuantileCycles(Buckets, 100, 1.0), FProxyMetrics::BucketUpperBound(Outlier));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyMetricsPrometheusTest, "P_ProxyServer.Metrics.PrometheusExport", PROXY_TEST_FLAGS)
+
+bool FProxyMetricsPrometheusTest::RunTest(const FString &Parameters)
+{
+    // Registered in the process wide table, so counts carry over between runs: compare against what was there before
+    FProxyMetrics &Metrics = FProxyMetrics::Get();
+    const int32 CounterA = Metrics.RegisterCounter(TEXT("proxy_test_metrics_total"), TEXT("kind=\"a\""), TEXT("Metrics test counter"));
+    const int32 CounterB = Metrics.RegisterCounter(TEXT("proxy_test_metrics_total"), TEXT("kind=\"b\""), TEXT("Metrics test counter"));
+    const int32 Histogram = Metrics.RegisterHistogram(TEXT("proxy_test_metrics_seconds"), TEXT(""), TEXT("Metrics test histogram"));
+    TestEqual(TEXT("Same name and labels, same id"), Metrics.RegisterCounter(TEXT("proxy_test_metrics_total"), TEXT("kind=\"a\""), TEXT("Metrics test counter")), CounterA);
+    TestNotEqual(TEXT("Other labels, other id"), CounterA, CounterB);
+    if (CounterA == INDEX_NONE || CounterB == INDEX_NONE || Histogram == INDEX_NONE)
+    {
+        AddError(TEXT("Metrics table full"));
+        return false;
+    }
+
+    const FString Before = Metrics.ExportPrometheus();
+    const double CountABefore = FMath::Max(0.0, test_sample(Before, TEXT("proxy_test_metrics_total{kind=\"a\"}")));
+    const double CountBBefore = FMath::Max(0.0, test_sample(Before, TEXT("proxy_test_metrics_total{kind=\"b\"}")));
+    const double SamplesBefore = FMath::Max(0.0, test_sample(Before, TEXT("proxy_test_metrics_seconds_count")));
+    const double SumBefore = FMath::Max(0.0, test_sample(Before, TEXT("proxy_test_metrics_seconds_sum")));
+
+    Metrics.Add(CounterA, 3);
+    Metrics.Add(CounterB);
+    Metrics.Add(INDEX_NONE); // Ignored
+    for (int32 Index = 0; Index < 100; ++Index)
+    {
+        Metrics.RecordCycles(Histogram, 5000);
+    }
+
+    const FString Export = Metrics.ExportPrometheus();
+    const double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+
+    // HELP / TYPE once per name, one sample line per label set
+    TestEqual(TEXT("One HELP for both label sets"), test_count_occurrences(Export, TEXT("# HELP proxy_test_metrics_total Metrics test counter\n")), 1);
+    TestEqual(TEXT("Counter TYPE"), test_count_occurrences(Export, TEXT("# TYPE proxy_test_metrics_total counter\n")), 1);
+    TestEqual(TEXT("Histograms export as summaries"), test_count_occurrences(Export, TEXT("# TYPE proxy_test_metrics_seconds summary\n")), 1);
+    TestEqual(TEXT("Counter a"), test_sample(Export, TEXT("proxy_test_metrics_total{kind=\"a\"}")), CountABefore + 3.0);
+    TestEqual(TEXT("Counter b"), test_sample(Export, TEXT("proxy_test_metrics_total{kind=\"b\"}")), CountBBefore + 1.0);
+
+    // Every sample recorded so far was 5000 cycles, every quantile is that bucket's upper bound
+    const double Expected = (double)FProxyMetrics::BucketUpperBound(FProxyMetrics::BucketIndex(5000)) * SecondsPerCycle;
+    for (const TCHAR *Quantile : {TEXT("0.5"), TEXT("0.9"), TEXT("0.99"), TEXT("0.999")})
+    {
+        const double Value = test_sample(Export, FString::Printf(TEXT("proxy_test_metrics_seconds{quantile=\"%s\"}"), Quantile));
+        TestEqual(FString::Printf(TEXT("Quantile %s"), Quantile), Value, Expected, Expected * 1e-6);
+    }
+    TestEqual(TEXT("Count"), test_sample(Export, TEXT("proxy_test_metrics_seconds_count")), SamplesBefore + 100.0);
+    TestEqual(TEXT("Sum in seconds"), test_sample(Export, TEXT("proxy_test_metrics_seconds_sum")), SumBefore + 100.0 * 5000.0 * SecondsPerCycle, 1e-9 + SumBefore * 1e-6);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyMetricsRecordPerfTest, "P_ProxyServer.Metrics.RecordCost", PROXY_PERF_TEST_FLAGS)
+
+bool FProxyMetricsRecordPerfTest::RunTest(const FString &Parameters)
+{
+    constexpr int32 Calls = 1000000;
+    constexpr int32 Runs = 5;
+
+    FProxyMetrics &Metrics = FProxyMetrics::Get();
+    const int32 Counter = Metrics.RegisterCounter(TEXT("proxy_test_metrics_perf_total"), TEXT(""), TEXT("Metrics benchmark counter"));
+    const int32 Histogram = Metrics.RegisterHistogram(TEXT("proxy_test_metrics_perf_seconds"), TEXT(""), TEXT("Metrics benchmark histogram"));
+
+    // Reference point: what every thread sharing one atomic counter would pay per increment
+    std::atomic<uint64> Shared{0};
+    const double SharedAdd = proxy_test_best_seconds(Runs, [&]()
+                                                     {
+                                                         for (int32 Call = 0; Call < Calls; ++Call)
+                                                         {
+                                                             Shared.fetch_add(1);
+                                                         } });
+    const double Add = proxy_test_best_seconds(Runs, [&]()
+                                               {
+                                                   for (int32 Call = 0; Call < Calls; ++Call)
+                                                   {
+                                                       Metrics.Add(Counter);
+                                                   } });
+    const double Record = proxy_test_best_seconds(Runs, [&]()
+                                                  {
+                                                      // Spread over many buckets, like real latencies
+                                                      for (int32 Call = 0; Call < Calls; ++Call)
+                                                      {
+                                                          Metrics.RecordCycles(Histogram, 100 + (uint64)(Call & 0xffff) * 37);
+                                                      } });
+
+    AddInfo(FString::Printf(TEXT("Add %.1f ns, RecordCycles %.1f ns, shared atomic fetch_add %.1f ns per call"), Add * 1e9 / Calls, Record * 1e9 / Calls, SharedAdd * 1e9 / Calls));
+    AddInfo(FString::Printf(TEXT("(checksum %llu)"), Shared.load()));
+
+    // Only a gross regression fails: recording must stay well under the cost of the timing it records
+    TestTrue(TEXT("Add under 50 ns"), Add * 1e9 / Calls < 50.0);
+    TestTrue(TEXT("RecordCycles under 50 ns"), Record * 1e9 / Calls < 50.0);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
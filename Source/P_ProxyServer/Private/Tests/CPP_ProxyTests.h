@@ -0,0 +1,60 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Punal Manalan, NOTE: Run with "Automation RunTests P_ProxyServer" (editor or -nullrhi server), none of the tests need a world
+#define PROXY_TEST_FLAGS (EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+// Micro-benchmarks report their timings with AddInfo and only fail on a gross regression, they run under the Perf filter
+#define PROXY_PERF_TEST_FLAGS (EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+// Advances the core ticker by Seconds in small steps, so mock transports and timers fire without a running engine loop
+inline void proxy_test_pump_ticker(float Seconds, float Step = 0.01f)
+{
+    for (float Elapsed = 0.0f; Elapsed <= Seconds; Elapsed += Step)
+    {
+        FTSTicker::GetCoreTicker().Tick(Step);
+    }
+}
+
+// Same, but each tick advances the ticker by the wall-clock time that really passed. For code that measures
+// latency or deadlines with FPlatformTime while its timers run on the ticker.
+inline void proxy_test_pump_realtime(float Seconds)
+{
+    double Last = FPlatformTime::Seconds();
+    const double End = Last + Seconds;
+    while (Last < End)
+    {
+        FPlatformProcess::Sleep(0.002f);
+        const double Now = FPlatformTime::Seconds();
+        FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - Last));
+        Last = Now;
+    }
+}
+
+// Best wall-clock time of Runs calls of Body, in seconds. The best run is the one least disturbed by the rest of the machine.
+inline double proxy_test_best_seconds(int32 Runs, TFunctionRef<void()> Body)
+{
+    double Best = MAX_dbl;
+    for (int32 Run = 0; Run < Runs; ++Run)
+    {
+        const double Start = FPlatformTime::Seconds();
+        Body();
+        Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+    }
+    return Best;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,117 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_ReplayCache.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    bool test_consume(FProxyReplayCache &Cache, int32 Index, int64 NowUnixSeconds)
+    {
+        return Cache.CheckAndInsert(FString::Printf(TEXT("Player_%d"), Index), 1700000000 + Index, FString::Printf(TEXT("Secret_%d"), Index), NowUnixSeconds);
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyReplayCacheRejectTest, "P_ProxyServer.ReplayCache.Replays", PROXY_TEST_FLAGS)
+
+bool FProxyReplayCacheRejectTest::RunTest(const FString &Parameters)
+{
+    const int64 Now = 1000;
+    FProxyReplayCache Cache(30, 1000, 64);
+
+    TestTrue(TEXT("First use accepted"), Cache.CheckAndInsert(TEXT("Alice"), 42, TEXT("secret"), Now));
+    TestFalse(TEXT("Replay rejected"), Cache.CheckAndInsert(TEXT("Alice"), 42, TEXT("secret"), Now + 1));
+    TestEqual(TEXT("Caught by the exact set"), Cache.GetStats().ExactReplays, (uint64)1);
+
+    // Any field differing is another token, including a shifted field boundary
+    TestTrue(TEXT("Other secret"), Cache.CheckAndInsert(TEXT("Alice"), 42, TEXT("secret2"), Now));
+    TestTrue(TEXT("Other timestamp"), Cache.CheckAndInsert(TEXT("Alice"), 43, TEXT("secret"), Now));
+    TestTrue(TEXT("Other player"), Cache.CheckAndInsert(TEXT("Bob"), 42, TEXT("secret"), Now));
+    TestTrue(TEXT("ab|c"), Cache.CheckAndInsert(TEXT("ab"), 1, TEXT("c"), Now));
+    TestTrue(TEXT("a|bc"), Cache.CheckAndInsert(TEXT("a"), 1, TEXT("bc"), Now));
+
+    // Far more tokens than exact slots: the evicted ones are still caught by the Bloom filters
+    FProxyReplayCache Small(30, 1000, 8);
+    for (int32 Index = 0; Index < 200; ++Index)
+    {
+        TestTrue(TEXT("Fresh token accepted"), test_consume(Small, Index, Now));
+    }
+    int32 NumRejected = 0;
+    for (int32 Index = 0; Index < 200; ++Index)
+    {
+        NumRejected += test_consume(Small, Index, Now + 1) ? 0 : 1;
+    }
+    TestEqual(TEXT("Every replay rejected"), NumRejected, 200);
+    TestTrue(TEXT("Most of them by the filters"), Small.GetStats().FilterReplays >= 190);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyReplayCacheWindowTest, "P_ProxyServer.ReplayCache.WindowRotation", PROXY_TEST_FLAGS)
+
+bool FProxyReplayCacheWindowTest::RunTest(const FString &Parameters)
+{
+    // 30 second window over 3 live buckets of 10 seconds, the token lands in the bucket for [1000, 1010)
+    const int64 Inserted = 1000;
+    FProxyReplayCache Cache(30, 1000, 64);
+    TestTrue(TEXT("Accepted"), Cache.CheckAndInsert(TEXT("Alice"), 42, TEXT("secret"), Inserted));
+
+    TestFalse(TEXT("Rejected at the end of the window"), Cache.CheckAndInsert(TEXT("Alice"), 42, TEXT("secret"), Inserted + 29));
+
+    // The exact entry has aged out, its bucket is still live
+    TestFalse(TEXT("Rejected until its bucket rotates out"), Cache.CheckAndInsert(TEXT("Alice"), 42, TEXT("secret"), Inserted + 39));
+    TestEqual(TEXT("Caught by the filter"), Cache.GetStats().FilterReplays, (uint64)1);
+
+    // Window plus at most one bucket later the token is forgotten, protection has lapsed
+    TestTrue(TEXT("Accepted again once the window passed"), Cache.CheckAndInsert(TEXT("Alice"), 42, TEXT("secret"), Inserted + 40));
+
+    // Rotation clears old buckets only, recent tokens survive it
+    TestTrue(TEXT("Recent token"), Cache.CheckAndInsert(TEXT("Bob"), 1, TEXT("s"), Inserted + 45));
+    TestTrue(TEXT("Time moves on"), Cache.CheckAndInsert(TEXT("Carol"), 1, TEXT("s"), Inserted + 65));
+    TestFalse(TEXT("Recent token still remembered"), Cache.CheckAndInsert(TEXT("Bob"), 1, TEXT("s"), Inserted + 70));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyReplayCacheFalsePositiveTest, "P_ProxyServer.ReplayCache.FalsePositiveRate", PROXY_TEST_FLAGS)
+
+bool FProxyReplayCacheFalsePositiveTest::RunTest(const FString &Parameters)
+{
+    const int64 Now = 1000;
+    const int32 TokensPerWindow = 3000; // 1000 per bucket
+    FProxyReplayCache Cache(30, TokensPerWindow, 64);
+    TestEqual(TEXT("Empty filters never match"), Cache.GetStats().EstimatedFalsePositiveRate, 0.0);
+
+    // A full bucket at the sized load
+    for (int32 Index = 0; Index < TokensPerWindow / 3; ++Index)
+    {
+        test_consume(Cache, Index, Now);
+    }
+    const double SizedRate = Cache.GetStats().EstimatedFalsePositiveRate;
+    TestTrue(TEXT("Estimate is above zero once filled"), SizedRate > 0.0);
+    TestTrue(TEXT("Estimate at the sized load is small"), SizedRate < 1e-4);
+
+    // Unseen tokens are (almost) never mistaken for replays at that load. Each one is recorded too, so keep the sample small.
+    int32 NumFalseRejections = 0;
+    for (int32 Index = 0; Index < 200; ++Index)
+    {
+        NumFalseRejections += test_consume(Cache, 100000 + Index, Now) ? 0 : 1;
+    }
+    TestTrue(TEXT("Measured false positives match the estimate"), NumFalseRejections <= 1);
+
+    // Overloading a bucket ten times over shows up in the estimate
+    for (int32 Index = 0; Index < 10 * TokensPerWindow / 3; ++Index)
+    {
+        test_consume(Cache, 200000 + Index, Now);
+    }
+    TestTrue(TEXT("Estimate grows with the fill"), Cache.GetStats().EstimatedFalsePositiveRate > 100.0 * SizedRate);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,266 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_SessionStore.h"
+#include "Async/Async.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr int32 NumStablePlayers = 32;  // Only ever upserted, with a growing generation
+    constexpr int32 NumChurnPlayers = 32;   // Upserted and removed in turn
+    constexpr int32 NumReaders = 4;
+    constexpr int32 WriterIterations = 2048; // A whole, even number of churn passes
+
+    FString test_player_id(int32 Index)
+    {
+        return FString::Printf(TEXT("Player_%d"), Index);
+    }
+
+    // The generation travels in roles[0], so a reader can tell a torn or out of order entry
+    FPlayerData test_player_data(const FString &PlayerId, int32 Generation)
+    {
+        FPlayerData Data;
+        Data.playerID = PlayerId;
+        Data.roles.Add(FString::FromInt(Generation));
+        return Data;
+    }
+
+    int32 test_generation(const FPlayerData &Data)
+    {
+        return Data.roles.Num() == 1 ? FCString::Atoi(*Data.roles[0]) : INDEX_NONE;
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxySessionStoreConcurrencyTest, "P_ProxyServer.SessionStore.ConcurrentReadersAndWriters", PROXY_TEST_FLAGS)
+
+bool FProxySessionStoreConcurrencyTest::RunTest(const FString &Parameters)
+{
+    FProxySessionStore Store;
+    TArray<FProxySessionKey> Keys;
+    for (int32 Index = 0; Index < NumStablePlayers + NumChurnPlayers; ++Index)
+    {
+        Keys.Emplace(test_player_id(Index));
+    }
+    for (int32 Index = 0; Index < NumStablePlayers; ++Index)
+    {
+        Store.Upsert(Keys[Index].PlayerId, test_player_data(Keys[Index].PlayerId, 0));
+    }
+
+    std::atomic<bool> bWritersDone{false};
+    std::atomic<int32> WrongEntries{0};
+    std::atomic<int32> GenerationsGoingBack{0};
+    std::atomic<int32> MissingStableEntries{0};
+    std::atomic<int64> Lookups{0};
+
+    TArray<TFuture<void>> Readers;
+    for (int32 ReaderIndex = 0; ReaderIndex < NumReaders; ++ReaderIndex)
+    {
+        Readers.Add(Async(EAsyncExecution::Thread, [&]()
+                          {
+                              TArray<int32> LastSeen;
+                              LastSeen.Init(0, NumStablePlayers);
+                              while (!bWritersDone.load())
+                              {
+                                  for (int32 Index = 0; Index < Keys.Num(); ++Index)
+                                  {
+                                      const FProxySessionEntryPtr Entry = Store.Find(Keys[Index]);
+                                      ++Lookups;
+                                      if (!Entry.IsValid())
+                                      {
+                                          if (Index < NumStablePlayers)
+                                          {
+                                              ++MissingStableEntries;
+                                          }
+                                          continue;
+                                      }
+                                      if (Entry->playerID != Keys[Index].PlayerId || test_generation(*Entry) == INDEX_NONE)
+                                      {
+                                          ++WrongEntries;
+                                          continue;
+                                      }
+                                      if (Index < NumStablePlayers)
+                                      {
+                                          const int32 Generation = test_generation(*Entry);
+                                          if (Generation < LastSeen[Index])
+                                          {
+                                              ++GenerationsGoingBack;
+                                          }
+                                          LastSeen[Index] = Generation;
+                                      }
+                                  }
+
+                                  // Iteration pins one shard at a time and must only ever see whole entries
+                                  Store.ForEach([&](const FProxySessionKey &Key, const FProxySessionEntryPtr &Entry)
+                                                {
+                                                    if (!Entry.IsValid() || Entry->playerID != Key.PlayerId)
+                                                    {
+                                                        ++WrongEntries;
+                                                    } });
+                              } }));
+    }
+
+    TFuture<void> StableWriter = Async(EAsyncExecution::Thread, [&]()
+                                       {
+                                           for (int32 Generation = 1; Generation <= WriterIterations; ++Generation)
+                                           {
+                                               const FString &PlayerId = Keys[Generation % NumStablePlayers].PlayerId;
+                                               const FProxySessionEntryPtr Current = Store.Find(PlayerId);
+                                               Store.Upsert(PlayerId, test_player_data(PlayerId, test_generation(*Current) + 1));
+                                           } });
+
+    TFuture<void> ChurnWriter = Async(EAsyncExecution::Thread, [&]()
+                                      {
+                                          for (int32 Iteration = 0; Iteration < WriterIterations; ++Iteration)
+                                          {
+                                              const FString &PlayerId = Keys[NumStablePlayers + Iteration % NumChurnPlayers].PlayerId;
+                                              if ((Iteration / NumChurnPlayers) % 2 == 0)
+                                              {
+                                                  Store.Upsert(PlayerId, test_player_data(PlayerId, Iteration));
+                                              }
+                                              else
+                                              {
+                                                  Store.Remove(PlayerId);
+                                              }
+                                          } });
+
+    StableWriter.Wait();
+    ChurnWriter.Wait();
+    bWritersDone = true;
+    for (TFuture<void> &Reader : Readers)
+    {
+        Reader.Wait();
+    }
+
+    AddInfo(FString::Printf(TEXT("%lld lookups while writing"), Lookups.load()));
+    TestEqual(TEXT("Entries found under the wrong key or torn"), WrongEntries.load(), 0);
+    TestEqual(TEXT("Reader saw a generation go back"), GenerationsGoingBack.load(), 0);
+    TestEqual(TEXT("Stable entries missing during updates"), MissingStableEntries.load(), 0);
+
+    // Every stable upsert was a read-modify-write from the only writer of those keys
+    int32 GenerationSum = 0;
+    for (int32 Index = 0; Index < NumStablePlayers; ++Index)
+    {
+        const FProxySessionEntryPtr Entry = Store.Find(Keys[Index]);
+        if (TestTrue(FString::Printf(TEXT("%s present"), *Keys[Index].PlayerId), Entry.IsValid()))
+        {
+            GenerationSum += test_generation(*Entry);
+        }
+    }
+    TestEqual(TEXT("Stable writer updates all visible"), GenerationSum, WriterIterations);
+
+    // The churn writer made an even number of passes, the last one removed every churn player
+    TestEqual(TEXT("Only the stable players remain"), Store.Num(), NumStablePlayers);
+    TestEqual(TEXT("ToMap agrees with Num"), Store.ToMap().Num(), Store.Num());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxySessionSyncParseTest, "P_ProxyServer.SessionStore.SyncPayloadParse", PROXY_TEST_FLAGS)
+
+bool FProxySessionSyncParseTest::RunTest(const FString &Parameters)
+{
+    FProxySessionSyncPayload Sync;
+    const bool bParsed = FProxySessionSyncPayload::Parse(TEXT("{\"version\":12,\"baseVersion\":10,\"full\":false,")
+                                                             TEXT("\"upserted\":{\"Alice\":{\"roles\":[\"admin\"]},\"Bob\":{\"playerID\":\"Bob\"}},\"removed\":[\"Carol\"]}"),
+                                                         Sync);
+    TestTrue(TEXT("Delta parsed"), bParsed);
+    TestEqual(TEXT("Version"), Sync.Version, (int64)12);
+    TestEqual(TEXT("Base version"), Sync.BaseVersion, (int64)10);
+    TestFalse(TEXT("Not a snapshot"), Sync.bIsFullSnapshot);
+    TestEqual(TEXT("Removed"), Sync.Removed, TArray<FString>({TEXT("Carol")}));
+    if (TestEqual(TEXT("Upserted"), Sync.Upserted.Num(), 2))
+    {
+        TestEqual(TEXT("Upsert key"), Sync.Upserted[0].Key, FString(TEXT("Alice")));
+        TestEqual(TEXT("Missing playerID taken from the key"), Sync.Upserted[0].Value.playerID, FString(TEXT("Alice")));
+        TestEqual(TEXT("Fields converted"), Sync.Upserted[0].Value.roles, TArray<FString>({TEXT("admin")}));
+    }
+
+    TestTrue(TEXT("Snapshot parsed"), FProxySessionSyncPayload::Parse(TEXT("{\"version\":3,\"full\":true}"), Sync));
+    TestTrue(TEXT("Snapshot flag"), Sync.bIsFullSnapshot);
+    TestEqual(TEXT("No base version given"), Sync.BaseVersion, (int64)-1);
+    TestEqual(TEXT("Empty snapshot"), Sync.Upserted.Num(), 0);
+
+    // Anything that cannot be applied whole is refused, the previous result is not left behind
+    TestFalse(TEXT("Version is required"), FProxySessionSyncPayload::Parse(TEXT("{\"full\":true}"), Sync));
+    TestFalse(TEXT("Not JSON"), FProxySessionSyncPayload::Parse(TEXT("{version"), Sync));
+    TestFalse(TEXT("Entry that is not an object"), FProxySessionSyncPayload::Parse(TEXT("{\"version\":4,\"upserted\":{\"Alice\":1}}"), Sync));
+    TestEqual(TEXT("Output reset on failure"), Sync.Upserted.Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxySessionStoreApplyTest, "P_ProxyServer.SessionStore.ApplyChangesAndSyncTo", PROXY_TEST_FLAGS)
+
+bool FProxySessionStoreApplyTest::RunTest(const FString &Parameters)
+{
+    FProxySessionStore Store;
+    TArray<FString> Changed;
+    TArray<TPair<FString, FPlayerData>> Upserts;
+    Upserts.Emplace(TEXT("A"), test_player_data(TEXT("A"), 1));
+    Upserts.Emplace(TEXT("B"), test_player_data(TEXT("B"), 1));
+
+    TestEqual(TEXT("Both inserted"), Store.ApplyChanges(Upserts, TArray<FString>(), &Changed), 2);
+    Changed.Sort();
+    TestEqual(TEXT("Inserted ids reported"), Changed, TArray<FString>({TEXT("A"), TEXT("B")}));
+
+    // An upsert equal to the current entry keeps the entry itself, readers holding it see no change
+    const FProxySessionEntryPtr Before = Store.Find(TEXT("A"));
+    const uint64 VersionBefore = Store.GetVersion();
+    Changed.Reset();
+    Upserts[1].Value = test_player_data(TEXT("B"), 2);
+    TestEqual(TEXT("Only the real change counted"), Store.ApplyChanges(Upserts, {TEXT("Missing")}, &Changed), 1);
+    TestEqual(TEXT("Only B reported"), Changed, TArray<FString>({TEXT("B")}));
+    TestTrue(TEXT("Unchanged entry kept"), Store.Find(TEXT("A")) == Before);
+    TestEqual(TEXT("One version step"), Store.GetVersion(), VersionBefore + 1);
+
+    TestEqual(TEXT("Removed"), Store.ApplyChanges(TArray<TPair<FString, FPlayerData>>(), {TEXT("B")}, &Changed), 1);
+    TestFalse(TEXT("B gone"), Store.Find(TEXT("B")).IsValid());
+
+    // SyncTo makes the table equal to the snapshot, touching only what differs
+    Store.Upsert(TEXT("C"), test_player_data(TEXT("C"), 1));
+    TMap<FString, FPlayerData> Snapshot;
+    Snapshot.Add(TEXT("A"), test_player_data(TEXT("A"), 1));
+    Snapshot.Add(TEXT("D"), test_player_data(TEXT("D"), 1));
+    Changed.Reset();
+    TestEqual(TEXT("C removed, D added"), Store.SyncTo(Snapshot, &Changed), 2);
+    Changed.Sort();
+    TestEqual(TEXT("Synced ids reported"), Changed, TArray<FString>({TEXT("C"), TEXT("D")}));
+    TestTrue(TEXT("A still the same entry"), Store.Find(TEXT("A")) == Before);
+    TestEqual(TEXT("Table matches the snapshot"), Store.Num(), 2);
+    TestEqual(TEXT("Same snapshot again changes nothing"), Store.SyncTo(Snapshot), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxySessionSyncCheckTest, "P_ProxyServer.SessionStore.SyncFallback", PROXY_TEST_FLAGS)
+
+bool FProxySessionSyncCheckTest::RunTest(const FString &Parameters)
+{
+    FProxySessionSyncPayload Delta;
+    Delta.Version = 12;
+    Delta.BaseVersion = 10;
+    TestEqual(TEXT("Delta on our version applies"), Delta.Check(10), EProxySessionSyncCheck::Apply);
+    TestEqual(TEXT("Delta from an older base falls back to a snapshot"), Delta.Check(11), EProxySessionSyncCheck::NeedFullSnapshot);
+    TestEqual(TEXT("Delta skipping ahead falls back to a snapshot"), Delta.Check(8), EProxySessionSyncCheck::NeedFullSnapshot);
+    Delta.BaseVersion = -1;
+    TestEqual(TEXT("Delta without a base falls back to a snapshot"), Delta.Check(10), EProxySessionSyncCheck::NeedFullSnapshot);
+
+    FProxySessionSyncPayload Snapshot;
+    Snapshot.bIsFullSnapshot = true;
+    Snapshot.Version = 12;
+    TestEqual(TEXT("Newer snapshot applies"), Snapshot.Check(10), EProxySessionSyncCheck::Apply);
+    TestEqual(TEXT("Same snapshot again applies"), Snapshot.Check(12), EProxySessionSyncCheck::Apply);
+    TestEqual(TEXT("Older snapshot is stale"), Snapshot.Check(13), EProxySessionSyncCheck::Stale);
+    TestEqual(TEXT("Any snapshot after a reset"), Snapshot.Check(0), EProxySessionSyncCheck::Apply);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,89 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_Sha256.h"
+#include "CPP_BPL__ProxyServer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxySha256BackendsTest, "P_ProxyServer.Sha256.Backends", PROXY_TEST_FLAGS)
+
+bool FProxySha256BackendsTest::RunTest(const FString &Parameters)
+{
+    AddInfo(FString::Printf(TEXT("Selected backend: %s"), FSha256Context::GetBackendName()));
+
+    // Every backend this CPU supports, not only the selected one
+    TestTrue(TEXT("All supported backends pass the known-answer vectors"), FSha256Context::SelfTestAllBackends());
+
+    // Through the public API, i.e. the selected backend plus FSha256Context's own padding
+    uint8 Digest[FSha256Context::DigestSize];
+    FSha256Context::HashBuffer((const uint8 *)"abc", 3, Digest);
+    TestEqual(TEXT("SHA256(\"abc\")"), FSha256Context::DigestToHex(Digest), FString(TEXT("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")));
+
+    // Message split across Update calls at awkward offsets (block boundary straddled)
+    TArray<uint8> Message;
+    Message.SetNumUninitialized(1000);
+    FMemory::Memset(Message.GetData(), 'a', Message.Num());
+    FSha256Context Context;
+    Context.Update(Message.GetData(), 63);
+    Context.Update(Message.GetData() + 63, 65);
+    Context.Update(Message.GetData() + 128, Message.Num() - 128);
+    Context.Final(Digest);
+    TestEqual(TEXT("SHA256(\"a\" x 1000), incremental"), FSha256Context::DigestToHex(Digest), FString(TEXT("41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3")));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxySha256HmacBatchTest, "P_ProxyServer.Sha256.HmacBatch", PROXY_TEST_FLAGS)
+
+bool FProxySha256HmacBatchTest::RunTest(const FString &Parameters)
+{
+    AddInfo(FString::Printf(TEXT("Multi-buffer backend: %s"), FSha256MultiBuffer::GetBackendName()));
+
+    // More requests than lanes, every tail shape (0..2 padded blocks), runs of the same key and key changes
+    TArray<FHmacSha256VerifyRequest> Requests;
+    TArray<bool> Expected;
+    for (int32 i = 0; i < 70; ++i)
+    {
+        FHmacSha256VerifyRequest Request;
+        Request.Key = FString::Printf(TEXT("key-%d"), i / 3);
+        Request.Data = FString::ChrN(i * 5, (TCHAR)(TEXT('a') + i % 26));
+        if (i % 7 == 0)
+        {
+            Request.Data += TEXT("\u00e9\u4e2d"); // Multi-byte UTF-8
+        }
+
+        // Signed with the single-buffer path. Every fifth request carries a wrong signature, every eleventh an unreadable one.
+        Request.ExpectedSignature = UCPP_BPL__ProxyServer::HmacSha256String(Request.Data, Request.Key);
+        bool bValid = true;
+        if (i % 5 == 4)
+        {
+            Request.ExpectedSignature = UCPP_BPL__ProxyServer::HmacSha256String(Request.Data + TEXT("x"), Request.Key);
+            bValid = false;
+        }
+        else if (i % 11 == 10)
+        {
+            Request.ExpectedSignature = TEXT("not hex");
+            bValid = false;
+        }
+        Requests.Add(MoveTemp(Request));
+        Expected.Add(bValid);
+    }
+
+    const TArray<bool> Valid = UCPP_BPL__ProxyServer::HmacSha256VerifyBatch(Requests);
+    TestEqual(TEXT("One result per request"), Valid.Num(), Requests.Num());
+    for (int32 i = 0; i < FMath::Min(Valid.Num(), Expected.Num()); ++i)
+    {
+        TestEqual(FString::Printf(TEXT("Request %d (%d chars) agrees with single-buffer HMAC"), i, Requests[i].Data.Len()), Valid[i], Expected[i]);
+        TestEqual(FString::Printf(TEXT("Request %d agrees with the prepared key"), i), Valid[i], FHmacSha256Key(Requests[i].Key).VerifyString(Requests[i].Data, Requests[i].ExpectedSignature));
+    }
+
+    TestEqual(TEXT("Empty batch"), UCPP_BPL__ProxyServer::HmacSha256VerifyBatch({}).Num(), 0);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,96 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_SingleFlight.h"
+#include "CPP_BackendBatcher.h"
+#include "CPP_BackendTransport.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    struct FTestWaiters
+    {
+        TArray<FString> Responses;
+        TArray<FString> Errors;
+    };
+
+    // Joins Key and, when it is the leader, sends Body through Transport and completes the flight with the answer.
+    // The same shape as UCPP_LoginManagerSubsystem::SendBackendRequest_Cpp.
+    void test_request(const TSharedRef<FProxySingleFlight, ESPMode::ThreadSafe> &Flight, const TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> &Transport,
+                      const FString &Key, const FString &Body, const TSharedRef<FTestWaiters> &Waiters)
+    {
+        const bool bLeader = Flight->Join(Key, [Waiters](const FString &Response, const FString &Error)
+                                          {
+                                              Waiters->Responses.Add(Response);
+                                              Waiters->Errors.Add(Error); });
+        if (!bLeader)
+        {
+            return;
+        }
+
+        Transport->Post(TEXT("mock://backend"), Body, 0.0f, [Flight, Key](bool bConnected, int32 Code, const FString &Response)
+                        { Flight->Complete(Key, bConnected ? Response : FString(), FProxyBackendBatcher::DescribeFailure(bConnected, Code, Response)); });
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxySingleFlightTest, "P_ProxyServer.SingleFlight.SharedCall", PROXY_TEST_FLAGS)
+
+bool FProxySingleFlightTest::RunTest(const FString &Parameters)
+{
+    TSharedRef<int32> Code = MakeShared<int32>(200);
+    TSharedRef<FProxyMockBackendTransport, ESPMode::ThreadSafe> Transport = MakeShared<FProxyMockBackendTransport, ESPMode::ThreadSafe>([Code](const FString &Url, const FString &Body, FString &OutResponse)
+                                                                                                                                   {
+                                                                                                                                       OutResponse = TEXT("answer:") + Body;
+                                                                                                                                       return *Code; });
+    Transport->SetLatency(0.05f);
+    TSharedRef<FProxySingleFlight, ESPMode::ThreadSafe> Flight = MakeShared<FProxySingleFlight, ESPMode::ThreadSafe>();
+
+    // N callers while the first request is out: one transport call, every caller gets its answer
+    const int32 NumCallers = 8;
+    TSharedRef<FTestWaiters> Waiters = MakeShared<FTestWaiters>();
+    for (int32 Index = 0; Index < NumCallers; ++Index)
+    {
+        test_request(Flight, Transport, TEXT("lookup:alice"), TEXT("alice"), Waiters);
+    }
+    TestEqual(TEXT("One flight"), Flight->GetNumInFlight(), 1);
+    TestEqual(TEXT("The others joined it"), Flight->GetNumCoalesced(), (uint64)(NumCallers - 1));
+    TestEqual(TEXT("Nobody answered before the backend"), Waiters->Responses.Num(), 0);
+
+    // Another key is not held up by the first one
+    TSharedRef<FTestWaiters> Other = MakeShared<FTestWaiters>();
+    test_request(Flight, Transport, TEXT("lookup:bob"), TEXT("bob"), Other);
+    TestEqual(TEXT("Second key, second call"), Transport->GetNumRequests(), 2);
+
+    proxy_test_pump_ticker(0.2f);
+    TestEqual(TEXT("Each key sent once"), Transport->GetNumRequests(), 2);
+    TestEqual(TEXT("Every caller answered"), Waiters->Responses.Num(), NumCallers);
+    for (int32 Index = 0; Index < Waiters->Responses.Num(); ++Index)
+    {
+        TestEqual(TEXT("Same answer for everyone"), Waiters->Responses[Index], FString(TEXT("answer:alice")));
+        TestTrue(TEXT("No error"), Waiters->Errors[Index].IsEmpty());
+    }
+    TestTrue(TEXT("Other key got its own answer"), Other->Responses.Num() == 1 && Other->Responses[0] == TEXT("answer:bob"));
+    TestEqual(TEXT("Nothing in flight"), Flight->GetNumInFlight(), 0);
+
+    // Once completed the key starts a fresh request, and a failure reaches every waiter too
+    *Code = 503;
+    TSharedRef<FTestWaiters> Failed = MakeShared<FTestWaiters>();
+    test_request(Flight, Transport, TEXT("lookup:alice"), TEXT("alice"), Failed);
+    test_request(Flight, Transport, TEXT("lookup:alice"), TEXT("alice"), Failed);
+    proxy_test_pump_ticker(0.2f);
+    TestEqual(TEXT("New request after completion"), Transport->GetNumRequests(), 3);
+    TestEqual(TEXT("Both waiters answered"), Failed->Errors.Num(), 2);
+    for (const FString &Error : Failed->Errors)
+    {
+        TestFalse(TEXT("Failure shared"), Error.IsEmpty());
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
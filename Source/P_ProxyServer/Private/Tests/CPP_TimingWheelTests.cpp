@@ -0,0 +1,84 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: Proxy Server Plugin.
+ * @Date: 22/11/2025
+ */
+
+#include "CPP_ProxyTests.h"
+#include "CPP_TimingWheel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    TArray<FString> test_advance(FProxyTimingWheel &Wheel, int64 NowSeconds)
+    {
+        TArray<FString> Expired;
+        Wheel.Advance(NowSeconds, Expired);
+        Expired.Sort();
+        return Expired;
+    }
+} // anonymous namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProxyTimingWheelTest, "P_ProxyServer.TimingWheel.Expiry", PROXY_TEST_FLAGS)
+
+bool FProxyTimingWheelTest::RunTest(const FString &Parameters)
+{
+    const int64 Start = 1000;
+    FProxyTimingWheel Wheel(8); // Small wheel, so deadlines past one turn are easy to reach
+    Wheel.Reset(Start);
+
+    // Expiry at the right tick, not one second early
+    Wheel.Schedule(TEXT("A"), Start + 3);
+    Wheel.Schedule(TEXT("B"), Start + 5);
+    TestEqual(TEXT("Nothing due before the deadline"), test_advance(Wheel, Start + 2).Num(), 0);
+    TestEqual(TEXT("A due at its deadline"), test_advance(Wheel, Start + 3), TArray<FString>({TEXT("A")}));
+    TestEqual(TEXT("B still waiting"), Wheel.Num(), 1);
+
+    // A deadline already in the past comes out on the next Advance
+    Wheel.Schedule(TEXT("Late"), Start);
+    TestEqual(TEXT("Past deadline due next tick"), test_advance(Wheel, Start + 4), TArray<FString>({TEXT("Late")}));
+
+    // Rescheduling adds a second entry, both come out and the owner re-checks the real deadline
+    Wheel.Schedule(TEXT("B"), Start + 7);
+    TestEqual(TEXT("Rescheduled entry counted"), Wheel.Num(), 2);
+    TestEqual(TEXT("Original deadline still fires"), test_advance(Wheel, Start + 5), TArray<FString>({TEXT("B")}));
+    TestEqual(TEXT("New deadline fires later"), test_advance(Wheel, Start + 7), TArray<FString>({TEXT("B")}));
+
+    // Removal needs the deadline the entry was scheduled with
+    Wheel.Schedule(TEXT("C"), Start + 10);
+    TestFalse(TEXT("Wrong deadline removes nothing"), Wheel.Remove(TEXT("C"), Start + 11));
+    TestTrue(TEXT("Removed"), Wheel.Remove(TEXT("C"), Start + 10));
+    TestFalse(TEXT("Removed once"), Wheel.Remove(TEXT("C"), Start + 10));
+    TestEqual(TEXT("Removed entry never fires"), test_advance(Wheel, Start + 12).Num(), 0);
+    TestEqual(TEXT("Wheel empty"), Wheel.Num(), 0);
+
+    // Longer than one turn of the wheel: shares a slot with a nearer deadline and stays for the extra turns
+    const int64 Now = Start + 12;
+    Wheel.Schedule(TEXT("Far"), Now + 8 * 3 + 2);
+    Wheel.Schedule(TEXT("Near"), Now + 2);
+    TestEqual(TEXT("Only the near one on the shared slot"), test_advance(Wheel, Now + 2), TArray<FString>({TEXT("Near")}));
+    TestEqual(TEXT("Far survives full turns"), test_advance(Wheel, Now + 8 * 3 + 1).Num(), 0);
+    TestEqual(TEXT("Far due after its turns"), test_advance(Wheel, Now + 8 * 3 + 2), TArray<FString>({TEXT("Far")}));
+
+    // After a stall longer than the wheel every slot is visited once and everything due comes out
+    const int64 Later = Now + 100;
+    Wheel.Schedule(TEXT("X"), Later + 1);
+    Wheel.Schedule(TEXT("Y"), Later + 6);
+    Wheel.Schedule(TEXT("Z"), Later + 40);
+    TestEqual(TEXT("Stall drains everything due"), test_advance(Wheel, Later + 20), TArray<FString>({TEXT("X"), TEXT("Y")}));
+    TestEqual(TEXT("Not yet due after the stall"), Wheel.Num(), 1);
+    TestEqual(TEXT("Z at its deadline"), test_advance(Wheel, Later + 40), TArray<FString>({TEXT("Z")}));
+
+    // The default wheel rounds to 512 slots, deadlines past that still wait their turn
+    FProxyTimingWheel DefaultWheel;
+    DefaultWheel.Reset(Start);
+    DefaultWheel.Schedule(TEXT("Hour"), Start + 3600);
+    TestEqual(TEXT("Not due after one turn"), test_advance(DefaultWheel, Start + 512).Num(), 0);
+    TestEqual(TEXT("Not due a second early"), test_advance(DefaultWheel, Start + 3599).Num(), 0);
+    TestEqual(TEXT("Due after an hour"), test_advance(DefaultWheel, Start + 3600), TArray<FString>({TEXT("Hour")}));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -21,4 +21,8 @@ public:
 
     /** Called when module is unloaded from memory */
     virtual void ShutdownModule() override;
+
+private:
+    /** Whether StartupModule started the metrics HTTP endpoint (Metrics_HttpPort) */
+    bool bIsMetricsEndpointStarted = false;
 };
@@ -6,11 +6,24 @@
 void AServerGameMode::PreLogin(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, FString &ErrorMessage)
 {
     UCPP_LoginManagerSubsystem *LoginSys = GetWorld() ? GetWorld()->GetSubsystem<UCPP_LoginManagerSubsystem>() : nullptr;
+    FSessionJoinToken JoinToken;
+    bool bHasJoinToken = false;
 
     if (LoginSys && LoginSys->Implements<UCPP_LoginHandler>())
     {
+        // Shed floods and reconnect storms before they reach decryption / backend calls
+        if (!LoginSys->TryAdmitLogin(Address, ErrorMessage))
+        {
+            return; // reject
+        }
+
         FString SubsystemError;
         bool bAllowed = ICPP_LoginHandler::Execute_ValidatePlayerLogin(LoginSys, Options, Address, UniqueId, SubsystemError);
+        if (bAllowed)
+        {
+            bAllowed = LoginSys->ValidatePresentedJoinToken(Options, UniqueId, JoinToken, bHasJoinToken, SubsystemError);
+        }
+        LoginSys->ReleaseLogin();
         if (!bAllowed)
         {
             ErrorMessage = SubsystemError;
@@ -19,7 +32,61 @@ void AServerGameMode::PreLogin(const FString &Options, const FString &Address, c
     }
 
     Super::PreLogin(Options, Address, UniqueId, ErrorMessage);
+
+    // Consumed last, a login refused by any earlier check may retry with the same token
+    if (ErrorMessage.IsEmpty() && bHasJoinToken && !LoginSys->ConsumeSessionJoinToken(JoinToken))
+    {
+        ErrorMessage = TEXT("This join token has already been used.");
+    }
+}
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+void AServerGameMode::PreLoginAsync(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, const FOnPreLoginCompleteDelegate &OnComplete)
+{
+    UCPP_LoginManagerSubsystem *LoginSys = GetWorld() ? GetWorld()->GetSubsystem<UCPP_LoginManagerSubsystem>() : nullptr;
+    if (!LoginSys || !LoginSys->Implements<UCPP_LoginHandler>())
+    {
+        Super::PreLoginAsync(Options, Address, UniqueId, OnComplete);
+        return;
+    }
+
+    FString ErrorMessage;
+    if (!LoginSys->TryAdmitLogin(Address, ErrorMessage))
+    {
+        OnComplete.ExecuteIfBound(ErrorMessage); // reject
+        return;
+    }
+
+    // The connection waits in the pending state meanwhile, the game thread keeps ticking
+    TWeakObjectPtr<AServerGameMode> WeakThis(this);
+    TWeakObjectPtr<UCPP_LoginManagerSubsystem> WeakLoginSys(LoginSys);
+    const FUniqueNetIdRepl UniqueIdCopy = UniqueId;
+
+    // Engine checks (GameSession approval) run inside the pipeline, before the join token is consumed
+    FProxyLoginPipeline::FStage EngineChecks = [WeakThis, Options, Address, UniqueIdCopy](FProxyLoginPipeline::FOnStageDone Done)
+    {
+        if (!WeakThis.IsValid())
+        {
+            Done(TEXT("Server is shutting down."));
+            return;
+        }
+        FString EngineError;
+        WeakThis->AGameModeBase::PreLogin(Options, Address, UniqueIdCopy, EngineError);
+        Done(EngineError);
+    };
+
+    LoginSys->ValidatePlayerLoginAsync(
+        Options, Address, UniqueId, [WeakLoginSys, OnComplete](const FString &SubsystemError)
+        {
+            if (WeakLoginSys.IsValid())
+            {
+                WeakLoginSys->ReleaseLogin();
+            }
+            OnComplete.ExecuteIfBound(SubsystemError);
+        },
+        MoveTemp(EngineChecks));
 }
+#endif
 
 void AServerGameMode::PostLogin(APlayerController *NewPlayer)
 {
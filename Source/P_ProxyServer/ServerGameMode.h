@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "Misc/EngineVersionComparison.h"
 
 // Forward declare types to avoid pulling in OnlineSubsystem headers here.
 struct FUniqueNetIdRepl;
@@ -15,6 +16,12 @@ class P_PROXYSERVER_API AServerGameMode : public AGameModeBase
     GENERATED_BODY()
 
 public:
+    // Blocking path, used by engines without PreLoginAsync and by anything that calls PreLogin directly
     virtual void PreLogin(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, FString &ErrorMessage) override;
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+    // Validation runs through UCPP_LoginManagerSubsystem::ValidatePlayerLoginAsync, the join is held until it finishes
+    virtual void PreLoginAsync(const FString &Options, const FString &Address, const FUniqueNetIdRepl &UniqueId, const FOnPreLoginCompleteDelegate &OnComplete) override;
+#endif
     virtual void PostLogin(APlayerController *NewPlayer) override;
 };